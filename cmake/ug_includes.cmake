@@ -504,6 +504,10 @@ endif(buildCompileInfo)
 ########################################
 if(POSIX)
 	add_definitions(-DUG_POSIX)
+	# the asynchronous output uses a separate thread
+	if(UNIX)
+		set(linkLibraries ${linkLibraries} pthread)
+	endif(UNIX)
 endif(POSIX)
 
 ########################################
@@ -63,6 +63,7 @@
 #include "matrix_diagonal.h"
 
 #include "lib_algebra/operator/energy_convergence_check.h"
+#include "lib_algebra/cpu_algebra/sell_matrix.h"
 
 using namespace std;
 
@@ -474,6 +475,13 @@ static void Algebra(Registry& reg, string grp)
 static void Common(Registry& reg, string grp)
 {
 
+//	SELL-C-sigma matrix-vector products
+	{
+		reg.add_function("EnableSellSpMV", &EnableSellSpMV, grp, "", "bEnable",
+						 "Enables/disables the automatic selection of frozen SELL-C-sigma copies for the matrix-vector products of CPU matrices (enabled by default).");
+		reg.add_function("SellSpMVEnabled", &SellSpMVEnabled, grp, "bEnabled", "");
+	}
+
 // IPositionProvider (abstract base class)
 	{
 		reg.add_class_<IPositionProvider<1> >("IPositionProvider1d", grp);
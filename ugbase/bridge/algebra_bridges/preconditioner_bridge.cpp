@@ -165,10 +165,29 @@ static void Algebra(Registry& reg, string grp)
 			.add_constructor()
 			.template add_constructor<void (*)(number)>("DampingFactor")
 			//.add_method("set_block", &T::set_block, "", "block", "if true, use block smoothing (default), else diagonal smoothing")
+			.add_method("enable_mixed_precision", &T::enable_mixed_precision, "", "enable", "inverse diagonal stored in float (scalar algebra only)")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "Jacobi", tag);
 	}
 
+//	Chebyshev
+	{
+		typedef Chebyshev<TAlgebra> T;
+		typedef IPreconditioner<TAlgebra> TBase;
+		string name = string("Chebyshev").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Chebyshev Smoother")
+			.add_constructor()
+			.template add_constructor<void (*)(int)>("Degree")
+			.add_method("set_degree", &T::set_degree, "", "degree", "degree of the polynomial (number of matrix-vector products per step)")
+			.add_method("set_eigenvalue_ratio", &T::set_eigenvalue_ratio, "", "ratio", "eigenvalues in [lambda_max/ratio, lambda_max] are damped")
+			.add_method("set_num_power_iterations", &T::set_num_power_iterations, "", "num", "power iterations to estimate lambda_max")
+			.add_method("set_safety_factor", &T::set_safety_factor, "", "factor", "factor the estimated lambda_max is multiplied with")
+			.add_method("set_max_eigenvalue", &T::set_max_eigenvalue, "", "lambda_max", "largest eigenvalue of D^{-1}A, skips the estimation if positive")
+			.add_method("max_eigenvalue", &T::max_eigenvalue, "lambda_max")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "Chebyshev", tag);
+	}
+
 //	GaussSeidelBase
 	{
 		typedef GaussSeidelBase<TAlgebra> T;
@@ -177,6 +196,9 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<T,TBase>(name, grp, "Gauss-Seidel Base")
 			.add_method("enable_consistent_interfaces", &T::enable_consistent_interfaces, "", "enable", "makes the matrix and defect consistent at the proc. interfaces")
 			.add_method("enable_overlap", &T::enable_overlap, "", "enable", "Enables matrix overlap. This also means that interfaces are consistent.")
+			.add_method("enable_level_scheduling", &T::enable_level_scheduling, "", "enable", "thread-parallel sweeps over the levels of the dependency graph (same result as sequential sweeps)")
+			.add_method("enable_multicoloring", &T::enable_multicoloring, "", "enable", "thread-parallel sweeps in a multicolor ordering of the unknowns")
+			.add_method("enable_mixed_precision", &T::enable_mixed_precision, "", "enable", "sweeps on a float copy of the matrix (scalar algebra only)")
 			.add_method("set_sor_relax", &T::set_sor_relax,
 					"", "sor relaxation", "sets sor relaxation parameter");
 		reg.add_class_to_group(name, "GaussSeidelBase", tag);
@@ -248,6 +270,9 @@ static void Algebra(Registry& reg, string grp)
 						"set whether preprocessing (notably, LU factorization) is to be disabled - usable when the operator has not changed; use with care")
 			.add_method("enable_consistent_interfaces", &T::enable_consistent_interfaces, "", "enable", "Make Matrix consistent for connections in interfaces.")
 			.add_method("enable_overlap", &T::enable_overlap, "", "enable", "Enables matrix overlap. This also means that interfaces are consistent.")
+			.add_method("enable_level_scheduling", &T::enable_level_scheduling, "", "enable", "thread-parallel triangular solves over the levels of the factors")
+			.add_method("enable_multicoloring", &T::enable_multicoloring, "", "enable", "multicolor reordering before factorization (replaces cuthill-mckee sorting)")
+			.add_method("enable_mixed_precision", &T::enable_mixed_precision, "", "enable", "triangular solves with float copies of the factors (scalar algebra only)")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "ILU", tag);
 	}
@@ -35,6 +35,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <cstring>
 
 // include bridge
 #include "bridge/bridge.h"
@@ -46,6 +47,7 @@
 #include "common/serialization.h"
 #include "../util_overloaded.h"
 #include "common/util/binary_buffer.h"
+#include "common/util/async_output.h"
 
 using namespace std;
 
@@ -144,17 +146,45 @@ end
 See also checkpoint_util.lua and time_step_util.lua on how to generate checkpointing/debugging mechanisms with this.
  */
 
+/// writes the buffer in the format of WriteCombinedParallelFile using the output thread
+static void WriteCombinedParallelFileAsync(BinaryBuffer &buffer, std::string filename)
+{
+	std::vector<char> header;
+#ifdef UG_PARALLEL
+	size_t myOffset = pcl::PrepareCombinedParallelFile(filename, buffer.write_pos(), header);
+	FileBlockWriteJob* job = new FileBlockWriteJob(filename, false);
+#else
+	int numProcs = 1;
+	int myNextOffset = 2*sizeof(int) + buffer.write_pos();
+	header.resize(2*sizeof(int));
+	memcpy(&header[0], &numProcs, sizeof(int));
+	memcpy(&header[sizeof(int)], &myNextOffset, sizeof(int));
+	size_t myOffset = header.size();
+	FileBlockWriteJob* job = new FileBlockWriteJob(filename, true);
+#endif
+	if(!header.empty())
+		job->add_block(header, 0);
+	job->add_block(buffer.buffer(), buffer.write_pos(), myOffset);
+	PushAsyncOutputJob(job);
+}
+
 template<typename T>
 void SaveToFile(const T &v, std::string filename)
 {
 	BinaryBuffer b;
 	Serialize(b, v);
-	pcl::WriteCombinedParallelFile(b, filename);
+	if(AsyncOutputEnabled())
+		WriteCombinedParallelFileAsync(b, filename);
+	else
+		pcl::WriteCombinedParallelFile(b, filename);
 }
 
 template<typename T>
 void ReadFromFile(T &v, std::string filename)
 {
+//	the file may still be written by the output thread
+	FlushAsyncOutput();
+
 	BinaryBuffer b;
 	pcl::ReadCombinedParallelFile(b, filename);
 	Deserialize(b, v);
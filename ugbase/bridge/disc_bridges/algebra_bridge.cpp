@@ -52,6 +52,7 @@
 #include "lib_disc/spatial_disc/constraints/constraint_interface.h"
 #include "lib_disc/time_disc/time_disc_interface.h"
 #include "lib_disc/time_disc/theta_time_step.h"
+#include "lib_disc/time_disc/adaptive_time_integrator.h"
 #include "lib_disc/operator/linear_operator/assembled_linear_operator.h"
 #include "lib_disc/operator/non_linear_operator/assembled_non_linear_operator.h"
 #include "lib_disc/operator/non_linear_operator/line_search.h"
@@ -179,7 +180,11 @@ static void Algebra(Registry& reg, string parentGroup)
 				"calculate error indicators for elements from error estimators of the elemDiscs")
 			.add_method("invalidate_error", &T::invalidate_error, "", "Marks error indicators as invalid, "
 				"which will prohibit refining and coarsening before a new call to calc_error.")
-			.add_method("is_error_valid", &T::is_error_valid, "", "Returns whether error indicators are valid");
+			.add_method("is_error_valid", &T::is_error_valid, "", "Returns whether error indicators are valid")
+			.add_method("enable_cached_splitting", &T::enable_cached_splitting, "", "enable",
+				"Assemble mass and stiffness matrix once and form the system matrix from them (linear problems only)")
+			.add_method("system_matrix_reused", &T::system_matrix_reused, "reused", "",
+				"Returns if the last assemble_linear left the system matrix unchanged");
 		reg.add_class_to_group(name, "MultiStepTimeDiscretization", tag);
 	}
 
@@ -210,6 +215,7 @@ static void Algebra(Registry& reg, string parentGroup)
 				.template add_constructor<void (*)(SmartPtr<IDomainDiscretization<TAlgebra> >)>("Domain Discretization")
 				.template add_constructor<void (*)(SmartPtr<IDomainDiscretization<TAlgebra> >,int)>("Domain Discretization#Order")
 				.add_method("set_order", &T::set_order, "", "Order")
+				.add_method("order", &T::order, "Order")
 				.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "BDF", tag);
 	}
@@ -229,6 +235,34 @@ static void Algebra(Registry& reg, string parentGroup)
 		reg.add_class_to_group(name, "SDIRK", tag);
 	}
 
+//	AdaptiveTimeIntegrator
+	{
+		std::string grp = parentGroup; grp.append("/Discretization/TimeDisc");
+		typedef AdaptiveTimeIntegrator<TAlgebra> T;
+		string name = string("AdaptiveTimeIntegrator").append(suffix);
+		reg.add_class_<T>(name, grp)
+				.template add_constructor<void (*)(SmartPtr<MultiStepTimeDiscretization<TAlgebra> >, SmartPtr<IOperatorInverse<vector_type> >)>("Time Discretization (SDIRK or BDF)#Solver")
+				.add_method("set_tolerance", &T::set_tolerance, "", "rtol#atol", "sets the tolerance for the local error")
+				.add_method("set_dt_bounds", &T::set_dt_bounds, "", "dtMin#dtMax")
+				.add_method("set_initial_dt", &T::set_initial_dt, "", "dt")
+				.add_method("set_factor_bounds", &T::set_factor_bounds, "", "facMin#facMax", "sets the bounds for the step size change")
+				.add_method("set_safety_factor", &T::set_safety_factor, "", "safety")
+				.add_method("set_max_retries", &T::set_max_retries, "", "maxRetries")
+				.add_method("set_finish_time_step", &T::set_finish_time_step, "", "finish")
+				.add_method("apply", &T::apply, "success", "u#t0#tEnd", "integrates from t0 to tEnd")
+				.add_method("time", &T::time)
+				.add_method("dt", &T::dt)
+				.add_method("num_accepted_steps", &T::num_accepted_steps)
+				.add_method("num_rejected_steps", &T::num_rejected_steps)
+				.add_method("num_solver_failures", &T::num_solver_failures)
+				.add_method("num_solves", &T::num_solves)
+				.add_method("clear_statistics", &T::clear_statistics)
+				.add_method("print_statistics", &T::print_statistics)
+				.add_method("config_string", &T::config_string)
+				.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "AdaptiveTimeIntegrator", tag);
+	}
+
 //	CompositeTimeDiscretization
 	{
 		std::string grp = parentGroup; grp.append("/Discretization/TimeDisc");
@@ -110,6 +110,7 @@ static void DomainAlgebra(Registry& reg, string grp)
 			.add_method("invalidate_error", &T::invalidate_error, "", "Marks error indicators as invalid, "
 				"which will prohibit refining and coarsening before a new call to calc_error.")
 			.add_method("is_error_valid", &T::is_error_valid, "", "Returns whether error values are valid")
+			.add_method("increase_revision", &T::increase_revision, "", "", "Signals changed parameters, e.g. to invalidate cached matrices")
 			.add_method("ass_tuner", static_cast<SmartPtr<AssemblingTuner<TAlgebra> > (T::*) ()> (&T::ass_tuner), "assembling tuner", "", "get this domain discretization's assembling tuner")
 			.add_method("approximation_space", static_cast<SmartPtr<ApproximationSpace<TDomain> > (T::*) ()> (&T::approximation_space), "approximation space", "", "get this domain discretization's approximation space")
 			.add_method("approximation_space", static_cast<ConstSmartPtr<ApproximationSpace<TDomain> > (T::*) () const> (&T::approximation_space), "approximation space", "", "get this domain discretization's approximation space")
@@ -239,6 +240,8 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<T>(name+suffix, grp)
 			.add_method("set_matrix_is_const", &T::set_matrix_is_const, "",
 						"whether matrix is constant in time", "")
+			.add_method("enable_threaded_assembling", &T::enable_threaded_assembling, "",
+						"bEnable", "enables or disables the thread-parallel element loop")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name+suffix, name, tag);
 	}
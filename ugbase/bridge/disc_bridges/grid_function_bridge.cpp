@@ -187,6 +187,8 @@ static void DomainAlgebra(Registry& reg, string grp)
 			.template add_constructor<void (*)(SmartPtr<TFct>, const char*)>("GridFunction#Component")
 			.add_method("evaluate", static_cast<number (T::*)(const MathVector<dim>&) const>(&T::evaluate))
 			.add_method("evaluate_global", static_cast<number (T::*)(std::vector<number>)>(&T::evaluate_global))
+			.add_method("evaluate_global_batch", &T::evaluate_global_batch, "values", "coordinates",
+						"evaluates at all points given as consecutive coordinates (collective)")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "GlobalGridFunctionNumberData", tag);
 	}
@@ -53,6 +53,8 @@
 #include "lib_disc/operator/linear_operator/element_gauss_seidel/component_gauss_seidel.h"
 #include "lib_disc/operator/linear_operator/subspace_correction/sequential_subspace_correction.h"
 #include "lib_disc/operator/linear_operator/uzawa/uzawa.h"
+#include "lib_disc/operator/linear_operator/matrix_free/matrix_free_operator.h"
+#include "lib_disc/operator/linear_operator/matrix_free/matrix_free_jacobi.h"
 
 using namespace std;
 
@@ -211,6 +213,7 @@ static void DomainAlgebra(Registry& reg, string grp)
 			.add_method("set_rap", &T::set_rap)
 			.add_method("set_smooth_on_surface_rim", &T::set_smooth_on_surface_rim)
 			.add_method("set_comm_comp_overlap", &T::set_comm_comp_overlap)
+			.add_method("set_mixed_precision", &T::set_mixed_precision, "", "mixed", "apply level matrices in single precision (scalar algebra only)")
 			.add_method("ignore_init_for_base_solver", static_cast<void (T::*)(bool)>(&T::ignore_init_for_base_solver), "", "ignore")
 			.add_method("ignore_init_for_base_solver", static_cast<bool (T::*)() const>(&T::ignore_init_for_base_solver), "is ignored", "")
 			.add_method("force_reinit", &T::force_reinit)
@@ -307,6 +310,56 @@ static void DomainAlgebra(Registry& reg, string grp)
 
 };
 
+/**
+ * Class exporting the matrix-free operators. These are only available for
+ * scalar algebra, thus they are registered for CPUAlgebra only.
+ */
+struct FunctionalityMatrixFree
+{
+
+template <typename TDomain, typename TAlgebra>
+static void DomainAlgebra(Registry& reg, string grp)
+{
+	string suffix = GetDomainAlgebraSuffix<TDomain,TAlgebra>();
+	string tag = GetDomainAlgebraTag<TDomain,TAlgebra>();
+
+	typedef typename TAlgebra::vector_type vector_type;
+
+	grp.append("/MultiGrid");
+
+//	MatrixFreeOperator
+	{
+		typedef MatrixFreeOperator<TDomain, TAlgebra> T;
+		typedef ILinearOperator<vector_type> TBase;
+		string name = string("MatrixFreeOperator").append(suffix);
+		reg.add_class_<T, TBase>(name, grp, "Matrix-free P1/Q1 convection-diffusion operator")
+			.template add_constructor<void (*)(SmartPtr<ApproximationSpace<TDomain> >, const char*)>("Approximation Space#Function")
+			.add_method("set_level", &T::set_level, "", "Grid Level")
+			.add_method("set_diffusion", &T::set_diffusion, "", "Diffusion")
+			.add_method("set_velocity", &T::set_velocity, "", "Velocity")
+			.add_method("set_reaction", &T::set_reaction, "", "Reaction")
+			.add_method("add_dirichlet_boundary", &T::add_dirichlet_boundary, "", "Subsets")
+			.add_method("num_elements", &T::num_elements)
+			.add_method("num_colors", &T::num_colors)
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "MatrixFreeOperator", tag);
+	}
+
+//	MatrixFreeJacobi
+	{
+		typedef MatrixFreeJacobi<TDomain, TAlgebra> T;
+		typedef ILinearIterator<vector_type> TBase;
+		string name = string("MatrixFreeJacobi").append(suffix);
+		reg.add_class_<T, TBase>(name, grp, "Jacobi iteration for MatrixFreeOperator")
+			.add_constructor()
+			.template add_constructor<void (*)(number)>("Damping")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "MatrixFreeJacobi", tag);
+	}
+}
+
+};
+
 // end group multigrid_bridge
 /// \}
 
@@ -320,6 +373,10 @@ void RegisterBridge_MultiGrid(Registry& reg, string grp)
 
 	try{
 		RegisterDomainAlgebraDependent<Functionality>(reg,grp);
+#ifdef UG_CPU_1
+		RegisterDomainAlgebraDependent<MultiGrid::FunctionalityMatrixFree,
+		               CompileDomainList, boost::mpl::list<CPUAlgebra> >(reg,grp);
+#endif
 	}
 	UG_REGISTRY_CATCH_THROW(grp);
 }
@@ -47,6 +47,7 @@
 
 #include "lib_disc/io/vtkoutput.h"
 #include "lib_disc/io/vtk_export_ho.h"
+#include "lib_disc/io/checkpoint.h"
 #include "common/profiler/profiler.h"
 
 #include "../util_overloaded.h"
@@ -144,6 +145,23 @@ static void DomainAlgebra(Registry& reg, string grp)
 	}
 
 
+//	Checkpoint
+	{
+		typedef Checkpoint<TDomain, TAlgebra> T;
+		string name = string("Checkpoint").append(suffix);
+		reg.add_class_<T>(name, grp, "Binary restart file of domain and grid functions")
+			.add_constructor()
+			.add_method("add", &T::add, "", "gridFunction#name", "adds a grid function to be written")
+			.add_method("clear_functions", &T::clear_functions)
+			.add_method("write", &T::write, "", "filename#domain", "writes domain and grid functions")
+			.add_method("read", &T::read, "", "filename#domain", "reads the grid into an empty domain")
+			.add_method("load", &T::load, "", "gridFunction#name", "loads the values of a grid function after read")
+			.add_method("function_names", &T::function_names)
+			.add_method("clear_read_data", &T::clear_read_data)
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "Checkpoint", tag);
+	}
+
 //	GridFunctionDebugWriter
 	{
 		typedef GridFunctionDebugWriter<TDomain, TAlgebra> T;
@@ -287,6 +305,7 @@ static void Dimension(Registry& reg, string grp)
 			.add_method("set_write_grid", static_cast<void (T::*)(bool)>(&T::set_write_grid))
 			.add_method("set_write_subset_indices", static_cast<void (T::*)(bool)>(&T::set_write_subset_indices))
 			.add_method("set_write_proc_ranks", static_cast<void (T::*)(bool)>(&T::set_write_proc_ranks))
+			.add_method("set_single_file", &T::set_single_file, "", "bSingleFile", "if true, all processes write to one *.vtu file per time step using MPI-IO")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "VTKOutput", tag);
 	}
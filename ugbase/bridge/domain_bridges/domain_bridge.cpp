@@ -466,6 +466,15 @@ static void Domain(Registry& reg, string grp)
 					"", "Domain # Filename|save-dialog| endings=[\"ugx\"]",
 					"Saves a domain", "No help");
 
+//	SavePartitionedDomain
+	reg.add_function("SavePartitionedDomain", &SavePartitionedDomain<TDomain>, grp,
+					"", "Domain # PartitionMap # Filename|save-dialog",
+					"Saves the partitions of a domain to a partitioned grid file", "No help");
+//	LoadPartitionedDomain
+	reg.add_function("LoadPartitionedDomain", &LoadPartitionedDomain<TDomain>, grp,
+					"", "Domain # Filename|load-dialog",
+					"Each process loads its partition from a partitioned grid file", "No help");
+
 //	SavePartitionMap
 	reg.add_function("SavePartitionMap", &SavePartitionMap<TDomain>, grp,
 					"Success", "PartitionMap # Domain # Filename|save-dialog",
@@ -83,7 +83,12 @@ struct Functionality {
 		reg.add_function("IdentifySubsets",
 				static_cast<void(*)(TDomain&, int, int)>(&IdentifySubsets<TDomain>), grp)
 		   .add_function("IdentifySubsets",
-				static_cast<void(*)(TDomain&, const char*, const char*)>(&IdentifySubsets<TDomain>), grp);
+				static_cast<void(*)(TDomain&, const char*, const char*)>(&IdentifySubsets<TDomain>), grp)
+		   .add_function("IdentifySubsets",
+				static_cast<void(*)(TDomain&, const char*, const char*, const std::vector<number>&)>(&IdentifySubsets<TDomain>),
+				grp, "", "domain#subset1#subset2#affineTrafo",
+				"identifies subset2 with subset1, where the row-major dim x (dim+1) "
+				"matrix [T | t] maps subset2 onto subset1 by x -> T*x + t");
 	}
 }; // end Functionality
 
@@ -100,7 +100,11 @@ void RegisterGridBridge_Misc(Registry& reg, string parentGroup)
 	string grp = parentGroup;
 	reg.add_function("PrintGridElementNumbers", static_cast<void (*)(MultiGrid&)>(&PrintGridElementNumbers), grp)
 		.add_function("PrintGridElementNumbers", static_cast<void (*)(Grid&)>(&PrintGridElementNumbers), grp)
-		.add_function("PrintAttachmentInfo", &PrintAttachmentInfo, grp);
+		.add_function("PrintAttachmentInfo", &PrintAttachmentInfo, grp)
+		.add_function("PrintElementPoolStatistics", &PrintElementPoolStatistics, grp, "",
+				"", "Prints number of objects and memory of the pooled grid objects per element type")
+		.add_function("ReleaseUnusedElementPoolMemory", &ReleaseUnusedElementPoolMemory, grp, "",
+				"", "Releases the memory of pooled grid objects which is not used by any grid");
 
 	reg.add_function("TestNTree", &TestNTree, grp);
 }
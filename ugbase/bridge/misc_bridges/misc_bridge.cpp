@@ -39,6 +39,8 @@
 #include "compile_info/compile_info.h"
 #include "common/util/crc32.h"
 #include "common/stopwatch.h"
+#include "common/util/thread_util.h"
+#include "common/util/async_output.h"
 #include "ug.h"
 
 using namespace std;
@@ -508,6 +510,28 @@ void RegisterBridge_Misc(Registry &reg, string parentGroup)
 						 "prints the specified message to the error-stream.");
 	}
 
+	{
+		stringstream ss; ss << parentGroup << "/Util/Threads";
+		string grp = ss.str();
+		reg.add_function("SetNumThreads", &SetNumThreads, grp, "", "numThreads",
+						 "Sets the number of threads per process used by thread-parallel kernels (requires cmake -DOPENMP=ON).");
+		reg.add_function("NumThreads", &NumThreads, grp, "numThreads", "",
+						 "Returns the number of threads per process used by thread-parallel kernels.");
+	}
+
+	{
+		stringstream ss; ss << parentGroup << "/Util/Output";
+		string grp = ss.str();
+		reg.add_function("SetAsyncOutput", &SetAsyncOutput, grp, "", "bEnable#maxQueueSize",
+						 "Enables writing of output files (VTKOutput, SaveToFile) by a separate thread. At most maxQueueSize files are staged in memory.");
+		reg.add_function("AsyncOutputEnabled", &AsyncOutputEnabled, grp, "bEnabled", "",
+						 "Returns whether the asynchronous output is enabled.");
+		reg.add_function("FlushAsyncOutput", &FlushAsyncOutput, grp, "", "",
+						 "Waits until all pending output files are written.");
+		reg.add_function("NumPendingAsyncOutputJobs", &NumPendingAsyncOutputJobs, grp, "num", "",
+						 "Returns the number of output files not yet written.");
+	}
+
 	{
 		stringstream ss; ss << parentGroup << "/Util/Internal";
 		string grp = ss.str();
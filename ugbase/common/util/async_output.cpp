@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "async_output.h"
+#include "common/log.h"
+#include "common/error.h"
+
+#include <deque>
+#include <fstream>
+
+#ifdef UG_POSIX
+	#include <pthread.h>
+#endif
+
+namespace ug{
+
+////////////////////////////////////////////////////////////////////////////////
+//	FileBlockWriteJob
+////////////////////////////////////////////////////////////////////////////////
+
+FileBlockWriteJob::FileBlockWriteJob(const std::string& filename, bool bTruncate)
+	: m_filename(filename), m_bTruncate(bTruncate)
+{}
+
+void FileBlockWriteJob::add_block(std::vector<char>& vData, size_t offset)
+{
+	m_vBlock.push_back(std::vector<char>());
+	m_vBlock.back().swap(vData);
+	m_vOffset.push_back(offset);
+}
+
+void FileBlockWriteJob::add_block(const char* data, size_t size, size_t offset)
+{
+	m_vBlock.push_back(std::vector<char>(data, data + size));
+	m_vOffset.push_back(offset);
+}
+
+void FileBlockWriteJob::add_block(const std::string& data, size_t offset)
+{
+	add_block(data.data(), data.size(), offset);
+}
+
+size_t FileBlockWriteJob::size() const
+{
+	size_t size = 0;
+	for(size_t i = 0; i < m_vBlock.size(); ++i)
+		size += m_vBlock[i].size();
+	return size;
+}
+
+void FileBlockWriteJob::run()
+{
+	std::ios_base::openmode mode = std::ios_base::out | std::ios_base::binary;
+	if(m_bTruncate) mode |= std::ios_base::trunc;
+	else mode |= std::ios_base::in;
+
+	std::fstream file(m_filename.c_str(), mode);
+	if(!file)
+		UG_THROW("FileBlockWriteJob: Cannot open file '"<<m_filename<<"'.");
+
+	for(size_t i = 0; i < m_vBlock.size(); ++i)
+	{
+		if(m_vBlock[i].empty()) continue;
+		file.seekp((std::streamoff)m_vOffset[i]);
+		file.write(&m_vBlock[i][0], (std::streamsize)m_vBlock[i].size());
+	}
+
+	file.close();
+	if(file.fail())
+		UG_THROW("FileBlockWriteJob: Cannot write to file '"<<m_filename<<"'.");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//	output thread
+////////////////////////////////////////////////////////////////////////////////
+
+static void RunAndDeleteJob(IAsyncOutputJob* job)
+{
+	try{
+		job->run();
+	}
+	catch(...){
+		delete job;
+		throw;
+	}
+	delete job;
+}
+
+#ifdef UG_POSIX
+
+///	state shared by the main thread and the output thread (guarded by mutex)
+struct AsyncOutputState
+{
+	pthread_mutex_t mutex;
+	pthread_cond_t condJob;		///< signaled if a job was pushed or the thread has to stop
+	pthread_cond_t condDone;	///< signaled if a job was finished
+	pthread_t thread;
+
+	bool bRunning;
+	bool bStop;
+	size_t maxQueueSize;
+
+///	pending jobs, the front job is executed by the output thread
+	std::deque<IAsyncOutputJob*> queue;
+
+///	message of the first failed job since the last flush
+	std::string error;
+};
+
+static AsyncOutputState g_async = {PTHREAD_MUTEX_INITIALIZER,
+                                   PTHREAD_COND_INITIALIZER,
+                                   PTHREAD_COND_INITIALIZER,
+                                   pthread_t(), false, false, 2,
+                                   std::deque<IAsyncOutputJob*>(), std::string()};
+
+static void* AsyncOutputThread(void*)
+{
+	for(;;)
+	{
+		pthread_mutex_lock(&g_async.mutex);
+		while(g_async.queue.empty() && !g_async.bStop)
+			pthread_cond_wait(&g_async.condJob, &g_async.mutex);
+		if(g_async.queue.empty()){
+			pthread_mutex_unlock(&g_async.mutex);
+			return NULL;
+		}
+	//	the job stays in the queue while running, so that flush waits for it
+		IAsyncOutputJob* job = g_async.queue.front();
+		pthread_mutex_unlock(&g_async.mutex);
+
+		std::string error;
+		try{
+			job->run();
+		}
+		catch(UGError& err){
+			error = err.get_msg();
+			if(error.empty()) error = "unknown UGError";
+		}
+		catch(std::exception& ex){
+			error = ex.what();
+		}
+		catch(...){
+			error = "unknown exception";
+		}
+		delete job;
+
+		pthread_mutex_lock(&g_async.mutex);
+		g_async.queue.pop_front();
+		if(!error.empty() && g_async.error.empty())
+			g_async.error = error;
+		pthread_cond_broadcast(&g_async.condDone);
+		pthread_mutex_unlock(&g_async.mutex);
+	}
+}
+
+void SetAsyncOutput(bool bEnable, int maxQueueSize)
+{
+	UG_COND_THROW(maxQueueSize < 1, "SetAsyncOutput: The queue must hold at "
+				  "least one job, but " << maxQueueSize << " were requested.");
+
+	pthread_mutex_lock(&g_async.mutex);
+	g_async.maxQueueSize = maxQueueSize;
+	const bool bRunning = g_async.bRunning;
+	pthread_mutex_unlock(&g_async.mutex);
+
+	if(bEnable == bRunning) return;
+
+	if(bEnable)
+	{
+		g_async.bStop = false;
+		if(pthread_create(&g_async.thread, NULL, AsyncOutputThread, NULL) != 0)
+			UG_THROW("SetAsyncOutput: Cannot create output thread.");
+		g_async.bRunning = true;
+	}
+	else
+	{
+		pthread_mutex_lock(&g_async.mutex);
+		g_async.bStop = true;
+		pthread_cond_signal(&g_async.condJob);
+		pthread_mutex_unlock(&g_async.mutex);
+
+		pthread_join(g_async.thread, NULL);
+		g_async.bRunning = false;
+
+	//	report errors of the remaining jobs
+		FlushAsyncOutput();
+	}
+}
+
+bool AsyncOutputEnabled()
+{
+	return g_async.bRunning;
+}
+
+void PushAsyncOutputJob(IAsyncOutputJob* job)
+{
+	if(!g_async.bRunning){
+		RunAndDeleteJob(job);
+		return;
+	}
+
+	pthread_mutex_lock(&g_async.mutex);
+//	back-pressure: wait until the output thread has caught up
+	while(g_async.queue.size() >= g_async.maxQueueSize)
+		pthread_cond_wait(&g_async.condDone, &g_async.mutex);
+	g_async.queue.push_back(job);
+	pthread_cond_signal(&g_async.condJob);
+	pthread_mutex_unlock(&g_async.mutex);
+}
+
+void FlushAsyncOutput()
+{
+	pthread_mutex_lock(&g_async.mutex);
+	while(!g_async.queue.empty())
+		pthread_cond_wait(&g_async.condDone, &g_async.mutex);
+	std::string error;
+	error.swap(g_async.error);
+	pthread_mutex_unlock(&g_async.mutex);
+
+	UG_COND_THROW(!error.empty(), "FlushAsyncOutput: Asynchronous output failed: "
+				  << error);
+}
+
+void WaitForAsyncOutput(const std::string& filename)
+{
+	pthread_mutex_lock(&g_async.mutex);
+	for(;;)
+	{
+	//	jobs are only deleted by the output thread after they were removed
+	//	from the queue, which is guarded by the mutex
+		bool bPending = false;
+		for(size_t i = 0; i < g_async.queue.size(); ++i){
+			if(g_async.queue[i]->writes_to(filename)){
+				bPending = true;
+				break;
+			}
+		}
+		if(!bPending) break;
+		pthread_cond_wait(&g_async.condDone, &g_async.mutex);
+	}
+	pthread_mutex_unlock(&g_async.mutex);
+}
+
+size_t NumPendingAsyncOutputJobs()
+{
+	pthread_mutex_lock(&g_async.mutex);
+	const size_t num = g_async.queue.size();
+	pthread_mutex_unlock(&g_async.mutex);
+	return num;
+}
+
+#else
+
+void SetAsyncOutput(bool bEnable, int maxQueueSize)
+{
+	UG_COND_THROW(maxQueueSize < 1, "SetAsyncOutput: The queue must hold at "
+				  "least one job, but " << maxQueueSize << " were requested.");
+	if(bEnable){
+		UG_LOG("WARNING in SetAsyncOutput: ug4 was compiled without POSIX support "
+			   "(use cmake -DPOSIX=ON). Output is written synchronously.\n");
+	}
+}
+
+bool AsyncOutputEnabled()
+{
+	return false;
+}
+
+void PushAsyncOutputJob(IAsyncOutputJob* job)
+{
+	RunAndDeleteJob(job);
+}
+
+void FlushAsyncOutput()
+{}
+
+void WaitForAsyncOutput(const std::string&)
+{}
+
+size_t NumPendingAsyncOutputJobs()
+{
+	return 0;
+}
+
+#endif
+
+}//	end of namespace
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG_async_output__
+#define __H__UG_async_output__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ug{
+
+/// \addtogroup ugbase_common_util
+/// \{
+
+///	A job executed by the output thread
+/**	Jobs must not access data that is modified by the calling thread after
+ * the job has been pushed, i.e. all data has to be copied into the job.
+ * Jobs must not call MPI, since the MPI library is only used by the main
+ * thread.*/
+class IAsyncOutputJob
+{
+	public:
+		virtual ~IAsyncOutputJob() {}
+
+	///	executes the job, errors are reported by throwing UGError
+		virtual void run() = 0;
+
+	///	returns true if the job writes to the given file
+	/**	Used by WaitForAsyncOutput. Jobs not writing files return false.*/
+		virtual bool writes_to(const std::string&) const {return false;}
+};
+
+///	Writes blocks of data to given positions of a file
+/**	The file is created if bTruncate is true. Otherwise the file must already
+ * exist and only the given byte ranges are overwritten, so that several
+ * processes can write disjoint parts of a common file.*/
+class FileBlockWriteJob : public IAsyncOutputJob
+{
+	public:
+		FileBlockWriteJob(const std::string& filename, bool bTruncate);
+
+	///	adds a block, the content of vData is taken over (swapped)
+		void add_block(std::vector<char>& vData, size_t offset);
+
+	///	adds a copy of the given data as a block
+		void add_block(const char* data, size_t size, size_t offset);
+
+	///	adds a copy of the given string as a block
+		void add_block(const std::string& data, size_t offset);
+
+	///	returns the total size of all blocks
+		size_t size() const;
+
+		virtual void run();
+
+		virtual bool writes_to(const std::string& filename) const
+			{return filename == m_filename;}
+
+	protected:
+		std::string m_filename;
+		bool m_bTruncate;
+		std::vector<std::vector<char> > m_vBlock;
+		std::vector<size_t> m_vOffset;
+};
+
+///	Enables or disables the asynchronous output
+/**	If enabled, output routines supporting it (e.g. VTKOutput and SaveToFile)
+ * copy their data into a staging buffer and return immediately. The data
+ * is written to disk by a separate output thread. If more than maxQueueSize
+ * jobs are pending, pushing a new job blocks until the output thread has
+ * finished a job, so that the memory used for staging is bounded.
+ *
+ * Disabling waits for all pending jobs. Asynchronous output requires POSIX
+ * threads (cmake -DPOSIX=ON). Otherwise a warning is printed and all output
+ * is written synchronously.*/
+void SetAsyncOutput(bool bEnable, int maxQueueSize = 2);
+
+///	Returns whether the asynchronous output is enabled
+bool AsyncOutputEnabled();
+
+///	Passes a job to the output thread
+/**	The job is deleted after it has been executed. If the asynchronous output
+ * is disabled, the job is executed immediately.*/
+void PushAsyncOutputJob(IAsyncOutputJob* job);
+
+///	Waits until all pending output jobs are finished
+/**	Call this function before reading output files or at the end of a run.
+ * If a job has failed since the last call, an error is thrown.*/
+void FlushAsyncOutput();
+
+///	Waits until all pending output jobs writing to the given file are finished
+/**	Other jobs stay in the queue, so that this is cheaper than FlushAsyncOutput
+ * if a file is about to be overwritten. Errors of failed jobs are not reported
+ * here but by the next call of FlushAsyncOutput.*/
+void WaitForAsyncOutput(const std::string& filename);
+
+///	Returns the number of jobs not yet finished
+size_t NumPendingAsyncOutputJobs();
+
+// end group ugbase_common_util
+/// \}
+
+}//	end of namespace
+
+#endif
@@ -76,6 +76,9 @@ Base64FileWriter& Base64FileWriter::operator<<(const fmtflag format)
 	if (format != m_currFormat && m_numBytesWritten > 0) {
 		flushInputBuffer(true);
 	}
+	// a new binary sub-block starts in the appended data
+	if (m_bRawAppended && format == base64_binary && m_currFormat != base64_binary)
+		m_vAppendedBlockOffset.push_back(m_vAppendedData.size());
 	m_currFormat = format;
 	return *this;
 }
@@ -131,7 +134,9 @@ Base64FileWriter::Base64FileWriter() :
 	m_currFormat(base64_ascii),
 	m_inBuffer(ios_base::binary | ios_base::out | ios_base::in),
 	m_lastInputByteSize(0),
-	m_numBytesWritten(0)
+	m_numBytesWritten(0),
+	m_bUseBuffer(false),
+	m_bRawAppended(false)
 {}
 
 Base64FileWriter::Base64FileWriter(const char* filename,
@@ -139,7 +144,9 @@ Base64FileWriter::Base64FileWriter(const char* filename,
 	m_currFormat(base64_ascii),
 	m_inBuffer(ios_base::binary | ios_base::out | ios_base::in),
 	m_lastInputByteSize(0),
-	m_numBytesWritten(0)
+	m_numBytesWritten(0),
+	m_bUseBuffer(false),
+	m_bRawAppended(false)
 {
 	PROFILE_FUNC();
 
@@ -173,6 +180,24 @@ void Base64FileWriter::open(const char *filename,
 	}
 }
 
+void Base64FileWriter::open_buffer()
+{
+	m_bUseBuffer = true;
+	m_bufStream.str("");
+}
+
+std::string Base64FileWriter::buffer_content() const
+{
+	return m_bufStream.str();
+}
+
+void Base64FileWriter::set_raw_appended(bool bRaw)
+{
+	m_bRawAppended = bRaw;
+	m_vAppendedData.clear();
+	m_vAppendedBlockOffset.clear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // PRIVATE FUNCTIONS
 
@@ -195,6 +220,12 @@ void Base64FileWriter::dispatch(const T& value)
 			flushInputBuffer();
 			break;
 		case base64_binary: {
+			// write raw to appended data
+			if (m_bRawAppended) {
+				const char* p = reinterpret_cast<const char*>(&value);
+				m_vAppendedData.insert(m_vAppendedData.end(), p, p + sizeof(T));
+				break;
+			}
 			// write the value in binary mode to the input buffer
 			UG_ASSERT(m_inBuffer.good(), "can not write to buffer")
 			m_inBuffer.write(reinterpret_cast<const char*>(&value), sizeof(T));
@@ -208,13 +239,20 @@ void Base64FileWriter::dispatch(const T& value)
 		}
 		case normal:
 			// nothing to do here, almost
-			m_fStream << value;
+			out_stream() << value;
 			break;
 	}
 }
 
+inline std::ostream& Base64FileWriter::out_stream()
+{
+	if (m_bUseBuffer) return m_bufStream;
+	return m_fStream;
+}
+
 inline void Base64FileWriter::assertFileOpen()
 {
+	if (m_bUseBuffer) return;
 	if (m_fStream.bad() || !m_fStream.is_open()) {
 		UG_THROW( "File stream is not open." );
 	}
@@ -263,7 +301,7 @@ void Base64FileWriter::flushInputBuffer(bool force)
 
 		// encode buff in base64
 		copy(base64_text(buff), base64_text(buff + buff_len),
-				boost::archive::iterators::ostream_iterator<char>(m_fStream));
+				boost::archive::iterators::ostream_iterator<char>(out_stream()));
 	}
 
 	size_t rest_len = m_numBytesWritten - buff_len;
@@ -299,7 +337,7 @@ void Base64FileWriter::flushInputBuffer(bool force)
 
 	if (force) {
 		for(uint i = 0; i < paddChars; ++i)
-			m_fStream << '=';
+			out_stream() << '=';
 
 		// resetting num bytes written and bytes in block
 		m_numBytesWritten = 0;
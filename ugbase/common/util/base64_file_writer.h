@@ -112,6 +112,41 @@ public:
 	void open(const char *filename,
 			const std::ios_base::openmode mode = std::ios_base::out );
 
+	/**
+	 * \brief Writes to an internal buffer instead of a file
+	 * \details The content can be retrieved by buffer_content().
+	 */
+	void open_buffer();
+
+	/**
+	 * \brief returns the content written to the internal buffer
+	 */
+	std::string buffer_content() const;
+
+	/**
+	 * \brief Writes binary data unencoded to a separate appended data block
+	 * \details If enabled, all data written in Base64FileWriter::base64_binary
+	 *   format is not written to the output but appended raw to a byte block.
+	 *   Each switch to the binary format starts a new sub-block, whose start
+	 *   offsets are returned by appended_block_offsets().
+	 */
+	void set_raw_appended(bool bRaw);
+
+	/**
+	 * \brief returns if binary data is written to the appended data block
+	 */
+	bool raw_appended() const {return m_bRawAppended;}
+
+	/**
+	 * \brief returns the appended data block
+	 */
+	const std::vector<char>& appended_data() const {return m_vAppendedData;}
+
+	/**
+	 * \brief returns the start offsets of the sub-blocks in the appended data block
+	 */
+	const std::vector<size_t>& appended_block_offsets() const {return m_vAppendedBlockOffset;}
+
 	/**
 	 * \brief gets the current set format
 	 */
@@ -154,6 +189,11 @@ private:
 	 * \brief File stream to write everything to
 	 */
 	std::fstream m_fStream;
+
+	/**
+	 * \brief returns the stream to write to (file or buffer)
+	 */
+	inline std::ostream& out_stream();
 	/**
 	 * \brief Current write format (\c base64 or \c normal)
 	 */
@@ -178,6 +218,24 @@ private:
 	 */
 	size_t m_numBytesWritten;
 
+	/**
+	 * \brief Buffer to write everything to, if no file is used
+	 */
+	std::stringstream m_bufStream;
+	/**
+	 * \brief Whether the buffer is used instead of the file
+	 */
+	bool m_bUseBuffer;
+	/**
+	 * \brief Whether binary data is written raw to the appended data block
+	 */
+	bool m_bRawAppended;
+	/**
+	 * \brief Appended raw data and start offsets of its sub-blocks
+	 */
+	std::vector<char> m_vAppendedData;
+	std::vector<size_t> m_vAppendedBlockOffset;
+
 	/**
 	 * \brief Flushes input buffer
 	 * \param force whether to forcefully flush the buffer
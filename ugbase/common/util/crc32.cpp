@@ -46,5 +46,12 @@ uint32 crc32(const char* str)
 	return checksum;
 }
 
+uint32 crc32(const char* buf, size_t len)
+{
+	boost::crc_32_type crc32Calculator;
+	crc32Calculator.process_bytes(buf, len);
+	return crc32Calculator.checksum();
+}
+
 }//	end of namespace
 
@@ -33,6 +33,7 @@
 #ifndef __H__UG_crc32__
 #define __H__UG_crc32__
 
+#include <cstddef>
 #include "../types.h"
 
 namespace ug{
@@ -43,6 +44,9 @@ namespace ug{
 ///	Calculates the crc32 for a null-terminated string.
 uint32 crc32(const char* str);
 
+///	Calculates the crc32 for a buffer of the given length in bytes.
+uint32 crc32(const char* buf, size_t len);
+
 // end group ugbase_common_util
 /// \}
 
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__COMMON__IN_SITU_NUMBER_STREAM__
+#define __H__UG__COMMON__IN_SITU_NUMBER_STREAM__
+
+#include <cstddef>
+#include <cstdlib>
+#include "common/types.h"
+
+namespace ug{
+
+/// \addtogroup ugbase_common_util
+/// \{
+
+///	Reads whitespace separated numbers directly from a character buffer
+/**	Replacement for std::stringstream when large lists of numbers have to be
+ * parsed, e.g. the vertex and element lists of a grid file. No copy of the
+ * buffer is created and numbers are parsed without the overhead of the
+ * iostream machinery.
+ *
+ * The stream behaves like an input stream regarding eof() and fail(), with
+ * the exception that eof() already returns true, if only whitespace remains.
+ * After a read failed, the stream stays at its end.
+ *
+ * Decimal numbers with at most 19 significant digits and a small exponent
+ * are converted exactly without strtod (Clinger's fast path). All other
+ * numbers are passed to strtod. Note that the character following the
+ * buffer has to terminate a number (e.g. a whitespace, '<' or 0).
+ */
+class InSituNumberStream
+{
+	public:
+		InSituNumberStream(const char* buf, size_t size) :
+			m_cur(buf), m_end(buf + size), m_fail(false)	{}
+
+	///	returns true if only whitespace remains or if a read failed
+		inline bool eof()
+		{
+			skip_whitespace();
+			return m_cur == m_end;
+		}
+
+	///	returns true if a read failed
+		inline bool fail() const	{return m_fail;}
+
+	///	counts the remaining whitespace separated tokens
+		size_t num_tokens() const
+		{
+			size_t num = 0;
+			bool inToken = false;
+			for(const char* p = m_cur; p != m_end; ++p){
+				bool ws = is_whitespace(*p);
+				if(!ws && !inToken) ++num;
+				inToken = !ws;
+			}
+			return num;
+		}
+
+		InSituNumberStream& operator >> (int& val)				{read_integer(val); return *this;}
+		InSituNumberStream& operator >> (unsigned int& val)		{read_integer(val); return *this;}
+		InSituNumberStream& operator >> (long& val)				{read_integer(val); return *this;}
+		InSituNumberStream& operator >> (unsigned long& val)	{read_integer(val); return *this;}
+		InSituNumberStream& operator >> (long long& val)			{read_integer(val); return *this;}
+		InSituNumberStream& operator >> (unsigned long long& val)	{read_integer(val); return *this;}
+		InSituNumberStream& operator >> (double& val)			{read_double(val); return *this;}
+		InSituNumberStream& operator >> (float& val)
+		{
+			double d = 0;
+			if(read_double(d))
+				val = (float)d;
+			return *this;
+		}
+
+	protected:
+		static inline bool is_whitespace(char c)
+		{
+			return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+		}
+
+		static inline bool is_digit(char c)	{return c >= '0' && c <= '9';}
+
+		inline void skip_whitespace()
+		{
+			while(m_cur != m_end && is_whitespace(*m_cur))
+				++m_cur;
+		}
+
+		inline bool set_failed()
+		{
+			m_fail = true;
+			m_cur = m_end;
+			return false;
+		}
+
+		template <class TInt>
+		bool read_integer(TInt& val)
+		{
+			skip_whitespace();
+			const char* p = m_cur;
+			bool neg = false;
+			if(p != m_end && (*p == '-' || *p == '+')){
+				neg = (*p == '-');
+				++p;
+			}
+
+			if(p == m_end || !is_digit(*p))
+				return set_failed();
+
+			TInt v = 0;
+			for(; p != m_end && is_digit(*p); ++p)
+				v = 10 * v + (TInt)(*p - '0');
+
+			val = neg ? (TInt)(0 - v) : v;
+			m_cur = p;
+			return true;
+		}
+
+		bool read_double(double& val)
+		{
+			static const double pow10[] = {
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+			skip_whitespace();
+			if(m_cur == m_end)
+				return set_failed();
+
+			const char* p = m_cur;
+			bool neg = false;
+			if(*p == '-' || *p == '+'){
+				neg = (*p == '-');
+				++p;
+			}
+
+		//	mantissa and decimal exponent
+			uint64 mant = 0;
+			int numSigDigits = 0;
+			int exp10 = 0;
+			bool hasDigits = false;
+			bool fastPath = true;
+
+			for(; p != m_end && is_digit(*p); ++p){
+				hasDigits = true;
+				if(numSigDigits < 19){
+					mant = 10 * mant + (uint64)(*p - '0');
+					if(mant) ++numSigDigits;
+				}
+				else
+					fastPath = false;
+			}
+
+			if(p != m_end && *p == '.'){
+				for(++p; p != m_end && is_digit(*p); ++p){
+					hasDigits = true;
+					if(numSigDigits < 19){
+						mant = 10 * mant + (uint64)(*p - '0');
+						if(mant) ++numSigDigits;
+						--exp10;
+					}
+					else
+						fastPath = false;
+				}
+			}
+
+			if(p != m_end && (*p == 'e' || *p == 'E')){
+				const char* pExp = p + 1;
+				bool negExp = false;
+				if(pExp != m_end && (*pExp == '-' || *pExp == '+')){
+					negExp = (*pExp == '-');
+					++pExp;
+				}
+				if(pExp != m_end && is_digit(*pExp)){
+					int e = 0;
+					for(; pExp != m_end && is_digit(*pExp); ++pExp)
+						if(e < 10000) e = 10 * e + (*pExp - '0');
+					exp10 += negExp ? -e : e;
+					p = pExp;
+				}
+				else
+					fastPath = false;
+			}
+
+		//	the fast path is exact if mantissa and power of ten are exactly
+		//	representable as doubles
+			if(hasDigits && fastPath && mant <= ((uint64)1 << 53)
+			   && exp10 >= -22 && exp10 <= 22
+			   && (p == m_end || is_whitespace(*p)))
+			{
+				double d = (double)mant;
+				if(exp10 < 0)	d /= pow10[-exp10];
+				else			d *= pow10[exp10];
+				val = neg ? -d : d;
+				m_cur = p;
+				return true;
+			}
+
+		//	everything else (long mantissas, large exponents, inf, nan, ...)
+			char* pEnd = NULL;
+			double d = strtod(m_cur, &pEnd);
+			if(pEnd == m_cur || pEnd > m_end)
+				return set_failed();
+			val = d;
+			m_cur = pEnd;
+			return true;
+		}
+
+	private:
+		const char*	m_cur;
+		const char*	m_end;
+		bool		m_fail;
+};
+
+// end group ugbase_common_util
+/// \}
+
+}//	end of namespace
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "thread_util.h"
+#include "common/log.h"
+#include "common/error.h"
+
+#include <algorithm>
+
+#ifdef UG_OPENMP
+	#include <omp.h>
+#endif
+
+namespace ug{
+
+static int g_numThreads = 1;
+
+void SetNumThreads(int numThreads)
+{
+	UG_COND_THROW(numThreads < 1, "SetNumThreads: At least one thread is required, "
+				  "but " << numThreads << " were requested.");
+#ifdef UG_OPENMP
+	g_numThreads = numThreads;
+	omp_set_num_threads(numThreads);
+#else
+	if(numThreads > 1){
+		UG_LOG("WARNING in SetNumThreads: ug4 was compiled without OpenMP support "
+			   "(use cmake -DOPENMP=ON). Running with one thread per process.\n");
+	}
+	g_numThreads = 1;
+#endif
+}
+
+int NumThreads()
+{
+	return g_numThreads;
+}
+
+int ThreadIndex()
+{
+#ifdef UG_OPENMP
+	return omp_get_thread_num();
+#else
+	return 0;
+#endif
+}
+
+int NumActiveThreads()
+{
+#ifdef UG_OPENMP
+	return omp_get_num_threads();
+#else
+	return 1;
+#endif
+}
+
+int NumThreadsForRange(size_t n)
+{
+#ifdef UG_OPENMP
+	const size_t minEntriesPerThread = 2048;
+	if(g_numThreads > 1 && !omp_in_parallel())
+		return std::max<int>(1, std::min<size_t>(g_numThreads, n / minEntriesPerThread));
+#endif
+	return 1;
+}
+
+}//	end of namespace
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG_thread_util__
+#define __H__UG_thread_util__
+
+#include <cstddef>
+
+namespace ug{
+
+/// \addtogroup ugbase_common_util
+/// \{
+
+///	Sets the number of threads used by thread-parallel kernels on each process.
+/**	Thread-parallel kernels (e.g. SparseMatrix::axpy) are only available if ug4
+ * was compiled with OpenMP support (cmake -DOPENMP=ON). Otherwise a warning
+ * is printed and all kernels keep running with one thread.
+ * The default is one thread per process, so that pure MPI runs are unaffected.*/
+void SetNumThreads(int numThreads);
+
+///	Returns the number of threads used by thread-parallel kernels.
+int NumThreads();
+
+///	Returns the index of the calling thread in the current parallel region.
+/**	Returns 0 outside of parallel regions or if compiled without OpenMP.*/
+int ThreadIndex();
+
+///	Returns the number of threads executing the current parallel region.
+/**	Returns 1 outside of parallel regions or if compiled without OpenMP.*/
+int NumActiveThreads();
+
+///	Returns the number of threads a thread-parallel loop over n entries should use.
+/**	Each thread gets at least a few thousand entries, so that the work amortizes
+ * the overhead of the parallel region. Returns 1 if compiled without OpenMP or
+ * if called from inside a parallel region (nested loops stay serial).*/
+int NumThreadsForRange(size_t n);
+
+///	Computes the static chunk [beginOut, endOut) of [0, n) processed by thread 'tid'.
+/**	All thread-parallel kernels use the same static partitioning of index ranges,
+ * so that entries of vectors and matrix rows are always touched by the same
+ * thread. Together with first-touch page placement this keeps memory accesses
+ * local to the NUMA domain of the thread.*/
+inline void ThreadChunk(size_t n, int numThreads, int tid,
+						size_t& beginOut, size_t& endOut)
+{
+	const size_t chunk = n / numThreads;
+	const size_t rest = n % numThreads;
+	const size_t t = (size_t)tid;
+	beginOut = t * chunk + (t < rest ? t : rest);
+	endOut = beginOut + chunk + (t < rest ? 1 : 0);
+}
+
+// end group ugbase_common_util
+/// \}
+
+}//	end of namespace
+
+#endif
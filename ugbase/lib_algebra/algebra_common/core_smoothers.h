@@ -34,6 +34,8 @@
 #define __H__UG__CPU_ALGEBRA__CORE_SMOOTHERS__
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "level_schedule.h"
+
 namespace ug
 {
 
@@ -200,6 +202,86 @@ void sgs_step(const Matrix_type &A, Vector_type &c, const Vector_type &d, const
 	gs_step_UR(A, c, c, relaxFactor);
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	scheduled gauss-seidel-steps
+
+///	computes row i of a forward (lower=true) or backward gauss-seidel-step w.r.t. a LevelSchedule
+template<typename Matrix_type, typename Vector_type>
+struct ScheduledGSRow
+{
+	ScheduledGSRow(const Matrix_type &A_, Vector_type &c_, const Vector_type &d_,
+	               number relaxFactor_, const LevelSchedule &sched_, bool lower_)
+		: A(A_), c(c_), d(d_), relaxFactor(relaxFactor_), sched(sched_), lower(lower_) {}
+
+	void operator()(size_t i)
+	{
+		typename Vector_type::value_type s = d[i];
+		for(typename Matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+			if(lower ? sched.lower(i, it.index()) : sched.upper(i, it.index()))
+				// s -= it.value() * c[it.index()];
+				MatMultAdd(s, 1.0, s, -1.0, it.value(), c[it.index()]);
+
+		// c[i] = relaxFactor * s/A(i,i)
+		InverseMatMult(c[i], relaxFactor, A(i,i), s);
+	}
+
+	const Matrix_type &A;
+	Vector_type &c;
+	const Vector_type &d;
+	number relaxFactor;
+	const LevelSchedule &sched;
+	bool lower;
+};
+
+/**
+ * \brief Performs a forward gauss-seidel-step, processing the rows level by level.
+ * For a schedule computed by LevelSchedule::init_levels the result is the same as
+ * for gs_step_LL above, for a multicoloring the sweep is done in color ordering.
+ * \sa LevelSchedule
+ */
+template<typename Matrix_type, typename Vector_type>
+void gs_step_LL(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor,
+                const LevelSchedule &sched)
+{
+	ScheduledGSRow<Matrix_type, Vector_type> row(A, c, d, relaxFactor, sched, true);
+	sched.forward(row);
+}
+
+/**
+ * \brief Performs a backward gauss-seidel-step, processing the rows level by level.
+ * \sa gs_step_UR, LevelSchedule
+ */
+template<typename Matrix_type, typename Vector_type>
+void gs_step_UR(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor,
+                const LevelSchedule &sched)
+{
+	ScheduledGSRow<Matrix_type, Vector_type> row(A, c, d, relaxFactor, sched, false);
+	sched.backward(row);
+}
+
+/**
+ * \brief Performs a symmetric gauss-seidel step, processing the rows level by level.
+ * \sa sgs_step, LevelSchedule
+ */
+template<typename Matrix_type, typename Vector_type>
+void sgs_step(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor,
+              const LevelSchedule &sched)
+{
+	// c1 = (D-L)^{-1} d
+	gs_step_LL(A, c, d, relaxFactor, sched);
+
+	// c2 = D c1
+	typename Vector_type::value_type s;
+	for(size_t i = 0; i<c.size(); i++)
+	{
+		s=c[i];
+		MatMult(c[i], 1.0, A(i, i), s);
+	}
+
+	// c3 = (D-U)^{-1} c2
+	gs_step_UR(A, c, c, relaxFactor, sched);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 //	diag_step
 /**
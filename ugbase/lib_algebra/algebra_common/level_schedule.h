@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__LEVEL_SCHEDULE__
+#define __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__LEVEL_SCHEDULE__
+
+#include <vector>
+#include <algorithm>
+#include "common/profiler/profiler.h"
+#include "common/util/thread_util.h"
+
+namespace ug{
+
+/// \addtogroup lib_algebra
+///	@{
+
+///	Row schedule for thread-parallel forward and backward substitutions.
+/**
+ * A triangular solve (Gauss-Seidel sweep, ILU-inversion) is sequential in
+ * the row order, but rows that do not depend on each other can be processed
+ * concurrently. This class groups the rows of a matrix into levels, such that
+ * all rows of a level only depend on rows of previous levels. The sweeps then
+ * process the levels one after another and distribute the rows of each level
+ * among the threads.
+ *
+ * Two modes are available:
+ * - init_levels: level-set analysis of the dependency DAG of the natural
+ *   ordering. The sweeps compute exactly the same result as the sequential
+ *   ones.
+ * - init_colors: greedy multicoloring of the matrix graph (largest degree
+ *   first, like the ParallelColoring of processes). Rows of one color are
+ *   never coupled, so the number of levels is the number of colors.
+ *   The sweeps are then Gauss-Seidel sweeps w.r.t. the color ordering, i.e.
+ *   the result differs from the sequential sweep in natural ordering. Use this
+ *   only for smoothers that tolerate the reordering.
+ *
+ * The schedule has to be recomputed whenever the matrix pattern changes.
+ */
+class LevelSchedule
+{
+	public:
+		LevelSchedule() : m_lowerWork(0), m_upperWork(0) {}
+
+	///	level-set analysis of the natural ordering of A
+		template <typename TMatrix>
+		void init_levels(const TMatrix& A)
+		{
+			PROFILE_FUNC_GROUP("algebra");
+			const size_t n = A.num_rows();
+			clear();
+
+		//	level of row i: one more than the maximum level of the rows it depends on
+			std::vector<size_t> level(n, 0);
+			size_t nnz = 0;
+			for(size_t i = 0; i < n; ++i)
+			{
+				size_t l = 0;
+				for(typename TMatrix::const_row_iterator it = A.begin_row(i);
+						it != A.end_row(i); ++it, ++nnz)
+					if(it.index() < i) l = std::max(l, level[it.index()] + 1);
+				level[i] = l;
+			}
+			bucket(m_lower, level);
+
+			for(size_t i = n; i-- != 0;)
+			{
+				size_t l = 0;
+				for(typename TMatrix::const_row_iterator it = A.begin_row(i);
+						it != A.end_row(i); ++it)
+					if(it.index() > i && it.index() < n)
+						l = std::max(l, level[it.index()] + 1);
+				level[i] = l;
+			}
+			bucket(m_upper, level);
+
+			m_lowerWork = nnz / std::max<size_t>(num_lower_levels(), 1);
+			m_upperWork = nnz / std::max<size_t>(num_upper_levels(), 1);
+		}
+
+	///	greedy multicoloring of the (symmetrized) matrix graph of A
+		template <typename TMatrix>
+		void init_colors(const TMatrix& A)
+		{
+			PROFILE_FUNC_GROUP("algebra");
+			const size_t n = A.num_rows();
+			clear();
+
+		//	transposed pattern, so that unsymmetric couplings are respected, too
+			std::vector<size_t> tStart(n+1, 0), tCols;
+			size_t nnz = 0;
+			for(size_t i = 0; i < n; ++i)
+				for(typename TMatrix::const_row_iterator it = A.begin_row(i);
+						it != A.end_row(i); ++it, ++nnz)
+					if(it.index() != i && it.index() < n) ++tStart[it.index()+1];
+			for(size_t i = 0; i < n; ++i) tStart[i+1] += tStart[i];
+			tCols.resize(tStart[n]);
+			{
+				std::vector<size_t> pos(tStart.begin(), tStart.end() - 1);
+				for(size_t i = 0; i < n; ++i)
+					for(typename TMatrix::const_row_iterator it = A.begin_row(i);
+							it != A.end_row(i); ++it)
+						if(it.index() != i && it.index() < n)
+							tCols[pos[it.index()]++] = i;
+			}
+
+		//	color rows with largest degree first
+			std::vector<std::pair<size_t, size_t> > order(n);
+			for(size_t i = 0; i < n; ++i)
+				order[i] = std::make_pair(n - (A.num_connections(i) + tStart[i+1] - tStart[i]), i);
+			std::sort(order.begin(), order.end());
+
+			const size_t noColor = (size_t)-1;
+			m_color.assign(n, noColor);
+			std::vector<size_t> forbidden;
+			for(size_t k = 0; k < n; ++k)
+			{
+				const size_t i = order[k].second;
+				for(typename TMatrix::const_row_iterator it = A.begin_row(i);
+						it != A.end_row(i); ++it)
+					if(it.index() < n && m_color[it.index()] != noColor)
+						forbidden[m_color[it.index()]] = i;
+				for(size_t t = tStart[i]; t < tStart[i+1]; ++t)
+					if(m_color[tCols[t]] != noColor)
+						forbidden[m_color[tCols[t]]] = i;
+
+			//	smallest color not used by a neighbor
+				size_t c = 0;
+				while(c < forbidden.size() && forbidden[c] == i) ++c;
+				if(c == forbidden.size()) forbidden.push_back(noColor);
+				m_color[i] = c;
+			}
+
+			bucket(m_lower, m_color);
+
+		//	backward sweeps process the colors in reverse order
+			const size_t numColors = num_lower_levels();
+			m_upper.start.resize(numColors + 1);
+			m_upper.rows.resize(n);
+			m_upper.start[0] = 0;
+			for(size_t l = 0; l < numColors; ++l)
+			{
+				const size_t c = numColors - 1 - l;
+				m_upper.start[l+1] = m_upper.start[l] + m_lower.start[c+1] - m_lower.start[c];
+				std::copy(m_lower.rows.begin() + m_lower.start[c],
+				          m_lower.rows.begin() + m_lower.start[c+1],
+				          m_upper.rows.begin() + m_upper.start[l]);
+			}
+
+			m_lowerWork = m_upperWork = nnz / std::max<size_t>(numColors, 1);
+		}
+
+	///	removes the schedule
+		void clear()
+		{
+			m_lower.start.clear(); m_lower.rows.clear();
+			m_upper.start.clear(); m_upper.rows.clear();
+			m_color.clear();
+			m_lowerWork = m_upperWork = 0;
+		}
+
+	///	returns if the schedule is a multicoloring
+		bool multicolor() const {return !m_color.empty();}
+
+	///	number of levels of forward sweeps (number of colors for multicoloring)
+		size_t num_lower_levels() const {return m_lower.start.empty() ? 0 : m_lower.start.size() - 1;}
+
+	///	number of levels of backward sweeps
+		size_t num_upper_levels() const {return m_upper.start.empty() ? 0 : m_upper.start.size() - 1;}
+
+	///	returns if the entry (i,j) belongs to the strict lower part w.r.t. the schedule
+		bool lower(size_t i, size_t j) const
+		{
+			if(m_color.empty()) return j < i;
+			return m_color[j] < m_color[i];
+		}
+
+	///	returns if the entry (i,j) belongs to the strict upper part w.r.t. the schedule
+		bool upper(size_t i, size_t j) const
+		{
+			if(m_color.empty()) return j > i;
+			return m_color[j] > m_color[i];
+		}
+
+	///	returns the ordering of the forward sweep as permutation i -> newIndex[i]
+		void get_order(std::vector<size_t>& newIndex) const
+		{
+			newIndex.resize(m_lower.rows.size());
+			for(size_t k = 0; k < m_lower.rows.size(); ++k)
+				newIndex[m_lower.rows[k]] = k;
+		}
+
+	///	calls op(i) for all rows in forward sweep order, levels in parallel
+		template <typename TRowOp>
+		void forward(TRowOp& op) const {run(m_lower, m_lowerWork, op);}
+
+	///	calls op(i) for all rows in backward sweep order, levels in parallel
+		template <typename TRowOp>
+		void backward(TRowOp& op) const {run(m_upper, m_upperWork, op);}
+
+	protected:
+	///	rows grouped by level, rows of level l are rows[start[l]], ..., rows[start[l+1]-1]
+		struct Levels
+		{
+			std::vector<size_t> start;
+			std::vector<size_t> rows;
+		};
+
+	///	sorts the rows by level (stable, i.e. ascending within a level)
+		static void bucket(Levels& lv, const std::vector<size_t>& level)
+		{
+			size_t numLevels = 0;
+			for(size_t i = 0; i < level.size(); ++i)
+				numLevels = std::max(numLevels, level[i] + 1);
+
+			lv.start.assign(numLevels + 1, 0);
+			for(size_t i = 0; i < level.size(); ++i) ++lv.start[level[i]+1];
+			for(size_t l = 0; l < numLevels; ++l) lv.start[l+1] += lv.start[l];
+
+			lv.rows.resize(level.size());
+			std::vector<size_t> pos(lv.start.begin(), lv.start.end() - 1);
+			for(size_t i = 0; i < level.size(); ++i)
+				lv.rows[pos[level[i]]++] = i;
+		}
+
+		template <typename TRowOp>
+		static void run(const Levels& lv, size_t workPerLevel, TRowOp& op)
+		{
+			const int numThreads = NumThreadsForRange(workPerLevel);
+			if(numThreads == 1){
+				for(size_t k = 0; k < lv.rows.size(); ++k) op(lv.rows[k]);
+				return;
+			}
+
+		#ifdef UG_OPENMP
+			const size_t numLevels = lv.start.size() - 1;
+			#pragma omp parallel num_threads(numThreads)
+			{
+				const int nt = NumActiveThreads();
+				const int tid = ThreadIndex();
+				for(size_t l = 0; l < numLevels; ++l)
+				{
+					size_t from, to;
+					ThreadChunk(lv.start[l+1] - lv.start[l], nt, tid, from, to);
+					const size_t* rows = &lv.rows[lv.start[l]];
+					for(size_t k = from; k < to; ++k) op(rows[k]);
+
+				//	next level depends on the results of this one
+					#pragma omp barrier
+				}
+			}
+		#endif
+		}
+
+	protected:
+		Levels m_lower, m_upper;
+		std::vector<size_t> m_color;
+		size_t m_lowerWork, m_upperWork;
+};
+
+/// @}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__LEVEL_SCHEDULE__ */
@@ -1037,6 +1037,26 @@ bool Axpy_transposedCommonSparseMatrix(const TSparseMatrix &A, vector_t &dest,
 }
 
 
+/// copies the entries of A into M, converting them to the value type of M
+/**
+ * Used to create reduced precision (e.g. float) copies of matrices for
+ * preconditioners, see reduced_precision_traits. M gets the sparsity pattern
+ * of A, no layouts are copied.
+ */
+template<typename TDestMatrix, typename TSparseMatrix>
+void CopyMatrixConverted(TDestMatrix &M, const TSparseMatrix &A)
+{
+	typedef typename TSparseMatrix::const_row_iterator iterator;
+	M.resize_and_clear(A.num_rows(), A.num_cols());
+	for(size_t i=0; i<A.num_rows(); i++)
+	{
+		iterator itEnd = A.end_row(i);
+		for(iterator it = A.begin_row(i); it != itEnd; ++it)
+			M(i, it.index()) = it.value();
+	}
+	M.defragment();
+}
+
 /// returns the number of non-zeroes (!= number of connections)
 template<typename TSparseMatrix>
 size_t GetNNZs(const TSparseMatrix &A)
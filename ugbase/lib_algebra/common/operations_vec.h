@@ -208,6 +208,51 @@ inline double VecNormSquared(const vector_t &a)
 	return sum;
 }
 
+// fused operations
+//-----------------------------------------------------------------------------
+// these functions combine an update with a reduction (or two reductions) in
+// one sweep over the vectors. Krylov methods are bound by the memory bandwidth,
+// so every pass over the vectors saved pays off. The parallel versions
+// (parallel_vector_impl.h) need only one allreduce per call.
+
+//! calculates dest = alpha1*v1 + alpha2*v2 and returns norm_2^2(dest)
+template<typename vector_t>
+inline double VecScaleAddNormSquared(vector_t &dest, double alpha1, const vector_t &v1, double alpha2, const vector_t &v2)
+{
+	double sum=0;
+	for(size_t i=0; i<dest.size(); i++)
+	{
+		VecScaleAdd(dest[i], alpha1, v1[i], alpha2, v2[i]);
+		VecNormSquaredAdd(dest[i], sum);
+	}
+	return sum;
+}
+
+//! calculates dest = alpha1*v1 + alpha2*v2 and returns scal<dest, w>
+template<typename vector_t>
+inline double VecScaleAddProd(vector_t &dest, double alpha1, const vector_t &v1, double alpha2, const vector_t &v2, const vector_t &w)
+{
+	double sum=0;
+	for(size_t i=0; i<dest.size(); i++)
+	{
+		VecScaleAdd(dest[i], alpha1, v1[i], alpha2, v2[i]);
+		VecProdAdd(dest[i], w[i], sum);
+	}
+	return sum;
+}
+
+//! calculates prod1 = scal<a1, b1> and prod2 = scal<a2, b2> in one sweep
+template<typename vector_t>
+inline void VecProdPair(const vector_t &a1, const vector_t &b1, const vector_t &a2, const vector_t &b2, double &prod1, double &prod2)
+{
+	prod1 = 0; prod2 = 0;
+	for(size_t i=0; i<a1.size(); i++)
+	{
+		VecProdAdd(a1[i], b1[i], prod1);
+		VecProdAdd(a2[i], b2[i], prod2);
+	}
+}
+
 // Elementwise (Hadamard) product of two vectors
 template<typename vector_t>
 inline void VecHadamardProd(vector_t &dest, const vector_t &v1, const vector_t &v2)
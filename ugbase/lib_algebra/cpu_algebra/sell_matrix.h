@@ -0,0 +1,493 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__CPU_ALGEBRA__SELL_MATRIX__
+#define __H__UG__CPU_ALGEBRA__SELL_MATRIX__
+
+#include <vector>
+#include <algorithm>
+#include "common/util/thread_util.h"
+#include "../small_algebra/blocks.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace ug{
+
+/// \addtogroup cpu_algebra
+///	@{
+
+///	Enables or disables the automatic use of SELL-C-sigma copies in SparseMatrix::axpy.
+/**	If enabled (default), a SparseMatrix whose sparsity pattern is used unmodified
+ * for several matrix-vector products decides whether a SELL-C-sigma copy of
+ * itself (\sa SellMatrix) is expected to be faster, i.e. if it is large and its
+ * rows are of similar length (see SparseMatrix::sell_suitable). If so, the
+ * frozen copy is created and used for all following products until the
+ * pattern is changed. Changed entries are copied row-wise before the next
+ * product. The copy needs about as much memory as the matrix itself.*/
+void EnableSellSpMV(bool bEnable);
+
+///	Returns whether SparseMatrix::axpy may use frozen SELL-C-sigma copies.
+bool SellSpMVEnabled();
+
+
+#if defined(__AVX2__) && !defined(__AVX512F__)
+///	Gathers w[col[0..3]], entries with negative column index are set to zero.
+inline __m256d SellGather4(const double* w, const int* col)
+{
+	const __m128i idx = _mm_loadu_si128((const __m128i*)col);
+//	the sign bit of each 64 bit lane selects the entry
+	const __m256d mask = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(
+							_mm_xor_si128(idx, _mm_set1_epi32(-1))));
+	return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), w, idx, mask, 8);
+}
+#endif
+
+///	Computes the C=8 row sums of one slice of a SELL-C-sigma matrix.
+/**	sum[l] = sum_j val[8*j+l] * w[col[8*j+l]] for l=0..7 and j=0..width-1.
+ * Padding entries (col < 0) are skipped, i.e. w is not read for them.*/
+inline void SellSliceProduct(const double* val, const int* col, size_t width,
+							 const double* w, double* sum)
+{
+#if defined(__AVX512F__)
+	__m512d s = _mm512_setzero_pd();
+	for(size_t j = 0; j < width; ++j, val += 8, col += 8){
+		const __m256i idx = _mm256_loadu_si256((const __m256i*)col);
+		const __mmask8 m = _mm512_cmpge_epi64_mask(_mm512_cvtepi32_epi64(idx),
+												   _mm512_setzero_si512());
+		s = _mm512_fmadd_pd(_mm512_loadu_pd(val),
+							_mm512_mask_i32gather_pd(_mm512_setzero_pd(), m, idx, w, 8), s);
+	}
+	_mm512_storeu_pd(sum, s);
+#elif defined(__AVX2__)
+	__m256d s0 = _mm256_setzero_pd();
+	__m256d s1 = _mm256_setzero_pd();
+	for(size_t j = 0; j < width; ++j, val += 8, col += 8){
+		const __m256d x0 = SellGather4(w, col);
+		const __m256d x1 = SellGather4(w, col+4);
+	#ifdef __FMA__
+		s0 = _mm256_fmadd_pd(_mm256_loadu_pd(val), x0, s0);
+		s1 = _mm256_fmadd_pd(_mm256_loadu_pd(val+4), x1, s1);
+	#else
+		s0 = _mm256_add_pd(s0, _mm256_mul_pd(_mm256_loadu_pd(val), x0));
+		s1 = _mm256_add_pd(s1, _mm256_mul_pd(_mm256_loadu_pd(val+4), x1));
+	#endif
+	}
+	_mm256_storeu_pd(sum, s0);
+	_mm256_storeu_pd(sum+4, s1);
+#else
+	for(size_t l = 0; l < 8; ++l) sum[l] = 0.0;
+	for(size_t j = 0; j < width; ++j, val += 8, col += 8)
+		for(size_t l = 0; l < 8; ++l)
+			if(col[l] >= 0) sum[l] += val[l] * w[col[l]];
+#endif
+}
+
+
+///	Computes the C=8 row sums of one slice with entries stored in single precision.
+/**	The entries are converted to double before the multiplication, i.e. only
+ * the storage of the matrix is reduced, the sums are computed in double.*/
+inline void SellSliceProduct(const float* val, const int* col, size_t width,
+							 const double* w, double* sum)
+{
+#if defined(__AVX512F__)
+	__m512d s = _mm512_setzero_pd();
+	for(size_t j = 0; j < width; ++j, val += 8, col += 8){
+		const __m256i idx = _mm256_loadu_si256((const __m256i*)col);
+		const __mmask8 m = _mm512_cmpge_epi64_mask(_mm512_cvtepi32_epi64(idx),
+												   _mm512_setzero_si512());
+		s = _mm512_fmadd_pd(_mm512_cvtps_pd(_mm256_loadu_ps(val)),
+							_mm512_mask_i32gather_pd(_mm512_setzero_pd(), m, idx, w, 8), s);
+	}
+	_mm512_storeu_pd(sum, s);
+#elif defined(__AVX2__)
+	__m256d s0 = _mm256_setzero_pd();
+	__m256d s1 = _mm256_setzero_pd();
+	for(size_t j = 0; j < width; ++j, val += 8, col += 8){
+		const __m256d x0 = SellGather4(w, col);
+		const __m256d x1 = SellGather4(w, col+4);
+		const __m256d v0 = _mm256_cvtps_pd(_mm_loadu_ps(val));
+		const __m256d v1 = _mm256_cvtps_pd(_mm_loadu_ps(val+4));
+	#ifdef __FMA__
+		s0 = _mm256_fmadd_pd(v0, x0, s0);
+		s1 = _mm256_fmadd_pd(v1, x1, s1);
+	#else
+		s0 = _mm256_add_pd(s0, _mm256_mul_pd(v0, x0));
+		s1 = _mm256_add_pd(s1, _mm256_mul_pd(v1, x1));
+	#endif
+	}
+	_mm256_storeu_pd(sum, s0);
+	_mm256_storeu_pd(sum+4, s1);
+#else
+	for(size_t l = 0; l < 8; ++l) sum[l] = 0.0;
+	for(size_t j = 0; j < width; ++j, val += 8, col += 8)
+		for(size_t l = 0; l < 8; ++l)
+			if(col[l] >= 0) sum[l] += (double)val[l] * w[col[l]];
+#endif
+}
+
+
+///	Slice kernel for arbitrary (fixed size) block types
+template<typename value_type, typename vector_t>
+struct SellSliceKernel
+{
+	typedef typename vector_t::value_type vec_value_type;
+
+	static void sum(const value_type* val, const int* col, size_t width,
+					const vector_t& w, vec_value_type* sum)
+	{
+		for(size_t l = 0; l < 8; ++l) sum[l] = 0.0;
+		for(size_t j = 0; j < width; ++j, val += 8, col += 8)
+			for(size_t l = 0; l < 8; ++l)
+				if(col[l] >= 0) MatMultAdd(sum[l], 1.0, sum[l], 1.0, val[l], w[col[l]]);
+	}
+};
+
+///	Slice kernel for scalar matrices (uses the SIMD kernel if available)
+template<typename vector_t>
+struct SellSliceKernel<double, vector_t>
+{
+	static void sum(const double* val, const int* col, size_t width,
+					const vector_t& w, double* sum)
+	{
+		SellSliceProduct(val, col, width, &w[0], sum);
+	}
+};
+
+///	Slice kernel for scalar matrices stored in single precision
+template<typename vector_t>
+struct SellSliceKernel<float, vector_t>
+{
+	static void sum(const float* val, const int* col, size_t width,
+					const vector_t& w, double* sum)
+	{
+		SellSliceProduct(val, col, width, &w[0], sum);
+	}
+};
+
+
+/** SellMatrix
+ *  \brief frozen, read-only SELL-C-sigma copy of a sparse matrix
+ *
+ *  The rows are sorted by their number of connections inside windows of
+ *  sigma rows and grouped into slices of C=8 rows. All rows of a slice are
+ *  padded to the length of the longest row of the slice and stored
+ *  column-major, i.e. the j-th connection of the 8 rows of a slice are
+ *  consecutive in memory. This way the matrix-vector product processes
+ *  8 rows at once and vectorizes over rows (AVX2/AVX-512 gathers for double,
+ *  if the compiler is allowed to use those instructions, e.g. -march=native).
+ *
+ *  The copy is created by SparseMatrix itself, see EnableSellSpMV. For
+ *  scalar matrices the entries can be stored in single precision (see
+ *  SparseMatrix::set_reduced_precision), halving the memory traffic of the
+ *  product while the sums are still computed in double.
+ *  References: Kreutzer et al., "A unified sparse matrix data format for
+ *  efficient general sparse matrix-vector multiplication on modern processors
+ *  with wide SIMD units", SIAM J. Sci. Comput. 36(5), 2014.
+ *
+ * \param TValueType blocktype (must be a fixed size block type)
+ */
+template<typename TValueType>
+class SellMatrix
+{
+	public:
+		typedef TValueType value_type;
+
+	///	type of the entries if stored in reduced precision
+		typedef typename reduced_precision_traits<TValueType>::value_type reduced_value_type;
+
+	///	slice height C and sorting scope sigma
+		enum {sliceHeight = 8, sortingScope = 256};
+
+	public:
+		SellMatrix() : m_numRows(0), m_nnz(0) {}
+
+	///	creates the SELL-C-sigma copy of the matrix A
+	/**	If bReduced is true and the value type can be reduced (see
+	 * reduced_precision_traits), the entries are stored as reduced_value_type.*/
+		template<typename TMatrix>
+		void init(const TMatrix& A, bool bReduced = false);
+
+	///	copies the entries of A into an existing copy
+	/**	The sparsity pattern of A must not have changed since init.*/
+		template<typename TMatrix>
+		void copy_values(const TMatrix& A);
+
+	///	copies the entries of one row of A into an existing copy
+	/**	The sparsity pattern of A must not have changed since init.*/
+		template<typename TMatrix>
+		void copy_row_values(const TMatrix& A, size_t row);
+
+	///	frees all memory
+		void clear();
+
+	///	returns true if no copy has been created
+		bool empty() const {return m_sliceStart.empty();}
+
+	///	returns true if the entries are stored in reduced precision
+		bool reduced() const {return !m_reducedValues.empty();}
+
+	///	returns the fraction of non-padding entries in the stored entries
+		double fill_ratio() const
+		{
+			if(m_cols.empty()) return 1.0;
+			return (double)m_nnz / (double)m_cols.size();
+		}
+
+	///	calculate dest = alpha1*v1 + beta1*A*w1
+		template<typename vector_t>
+		void axpy(vector_t& dest,
+				  const number& alpha1, const vector_t& v1,
+				  const number& beta1, const vector_t& w1) const;
+
+	protected:
+	///	axpy restricted to slices [sliceFrom, sliceTo)
+		template<typename vector_t>
+		void axpy_slices(size_t sliceFrom, size_t sliceTo, vector_t& dest,
+						 const number& alpha1, const vector_t& v1,
+						 const number& beta1, const vector_t& w1) const;
+
+		size_t num_slices() const {return m_sliceStart.size() - 1;}
+
+	///	orders rows by decreasing number of connections
+		struct CompareRowLength
+		{
+			bool operator()(const std::pair<size_t, int>& a,
+							const std::pair<size_t, int>& b) const
+			{return a.first > b.first;}
+		};
+
+	protected:
+		size_t m_numRows;
+		size_t m_nnz;
+
+	///	start of the entries of each slice in m_cols/m_values (size: numSlices+1)
+		std::vector<size_t> m_sliceStart;
+
+	///	original row index for each row position in the slices (-1 for padding rows)
+		std::vector<int> m_rowPerm;
+
+	///	row position in the slices for each original row (inverse of m_rowPerm)
+		std::vector<size_t> m_rowPos;
+
+	///	column indices and values, column-major inside each slice (column -1 for padding)
+		std::vector<int> m_cols;
+		std::vector<value_type> m_values;
+
+	///	values in reduced precision (if used, m_values is empty)
+		std::vector<reduced_value_type> m_reducedValues;
+};
+
+
+template<typename T>
+template<typename TMatrix>
+void SellMatrix<T>::init(const TMatrix& A, bool bReduced)
+{
+	typedef typename TMatrix::const_row_iterator const_row_iterator;
+	const size_t C = sliceHeight;
+
+	m_numRows = A.num_rows();
+	m_nnz = 0;
+	const size_t numSlices = (m_numRows + C - 1) / C;
+
+//	sort rows by length (descending) inside each window of sigma rows
+	std::vector<std::pair<size_t, int> > vRowLen(m_numRows);
+	for(size_t i = 0; i < m_numRows; ++i){
+		vRowLen[i] = std::make_pair(A.num_connections(i), (int)i);
+		m_nnz += vRowLen[i].first;
+	}
+	for(size_t from = 0; from < m_numRows; from += sortingScope){
+		const size_t to = std::min(from + (size_t)sortingScope, m_numRows);
+		std::stable_sort(vRowLen.begin() + from, vRowLen.begin() + to,
+						 CompareRowLength());
+	}
+
+	m_rowPerm.assign(numSlices * C, -1);
+	m_rowPos.resize(m_numRows);
+	m_sliceStart.resize(numSlices + 1);
+	m_sliceStart[0] = 0;
+	for(size_t s = 0; s < numSlices; ++s){
+		size_t width = 0;
+		for(size_t l = 0; l < C && s*C+l < m_numRows; ++l){
+			m_rowPerm[s*C+l] = vRowLen[s*C+l].second;
+			m_rowPos[vRowLen[s*C+l].second] = s*C+l;
+			width = std::max(width, vRowLen[s*C+l].first);
+		}
+		m_sliceStart[s+1] = m_sliceStart[s] + width * C;
+	}
+
+	m_cols.assign(m_sliceStart[numSlices], -1);
+	for(size_t s = 0; s < numSlices; ++s){
+		for(size_t l = 0; l < C; ++l){
+			const int row = m_rowPerm[s*C+l];
+			if(row < 0) continue;
+
+			size_t k = m_sliceStart[s] + l;
+			for(const_row_iterator it = A.begin_row(row); it != A.end_row(row); ++it, k += C)
+				m_cols[k] = (int)it.index();
+		}
+	}
+
+//	padding entries have value zero and are skipped by the kernels. In
+//	reduced precision the double precision values are not stored at all.
+	std::vector<value_type>().swap(m_values);
+	std::vector<reduced_value_type>().swap(m_reducedValues);
+	if(bReduced && reduced_precision_traits<T>::is_reduced)
+		m_reducedValues.resize(m_cols.size());
+	else{
+		value_type zero; zero = 0.0;
+		m_values.assign(m_cols.size(), zero);
+	}
+
+	copy_values(A);
+}
+
+
+template<typename T>
+template<typename TMatrix>
+void SellMatrix<T>::copy_values(const TMatrix& A)
+{
+	typedef typename TMatrix::const_row_iterator const_row_iterator;
+	const size_t C = sliceHeight;
+	const bool bReduced = reduced();
+
+	for(size_t s = 0; s < num_slices(); ++s){
+		for(size_t l = 0; l < C; ++l){
+			const int row = m_rowPerm[s*C+l];
+			if(row < 0) continue;
+
+			size_t k = m_sliceStart[s] + l;
+			for(const_row_iterator it = A.begin_row(row); it != A.end_row(row); ++it, k += C){
+				if(bReduced) m_reducedValues[k] = (reduced_value_type)it.value();
+				else m_values[k] = it.value();
+			}
+		}
+	}
+}
+
+
+template<typename T>
+template<typename TMatrix>
+void SellMatrix<T>::copy_row_values(const TMatrix& A, size_t row)
+{
+	typedef typename TMatrix::const_row_iterator const_row_iterator;
+	const size_t C = sliceHeight;
+	const bool bReduced = reduced();
+
+	const size_t pos = m_rowPos[row];
+	size_t k = m_sliceStart[pos / C] + pos % C;
+	for(const_row_iterator it = A.begin_row(row); it != A.end_row(row); ++it, k += C){
+		if(bReduced) m_reducedValues[k] = (reduced_value_type)it.value();
+		else m_values[k] = it.value();
+	}
+}
+
+
+template<typename T>
+void SellMatrix<T>::clear()
+{
+	m_numRows = 0;
+	m_nnz = 0;
+	std::vector<size_t>().swap(m_sliceStart);
+	std::vector<int>().swap(m_rowPerm);
+	std::vector<size_t>().swap(m_rowPos);
+	std::vector<int>().swap(m_cols);
+	std::vector<value_type>().swap(m_values);
+	std::vector<reduced_value_type>().swap(m_reducedValues);
+}
+
+
+template<typename T>
+template<typename vector_t>
+void SellMatrix<T>::axpy_slices(size_t sliceFrom, size_t sliceTo, vector_t& dest,
+								const number& alpha1, const vector_t& v1,
+								const number& beta1, const vector_t& w1) const
+{
+	typedef typename vector_t::value_type vec_value_type;
+	const size_t C = sliceHeight;
+	vec_value_type sum[sliceHeight];
+
+	for(size_t s = sliceFrom; s < sliceTo; ++s)
+	{
+		const size_t start = m_sliceStart[s];
+		const size_t width = (m_sliceStart[s+1] - start) / C;
+		if(width > 0 && reduced())
+			SellSliceKernel<reduced_value_type, vector_t>::sum
+				(&m_reducedValues[start], &m_cols[start], width, w1, sum);
+		else if(width > 0)
+			SellSliceKernel<value_type, vector_t>::sum
+				(&m_values[start], &m_cols[start], width, w1, sum);
+		else
+			for(size_t l = 0; l < C; ++l) sum[l] = 0.0;
+
+		for(size_t l = 0; l < C; ++l)
+		{
+			const int row = m_rowPerm[s*C+l];
+			if(row < 0) continue;
+
+			if(alpha1 == 0.0)
+				VecScaleAssign(dest[row], beta1, sum[l]);
+			else
+				VecScaleAdd(dest[row], alpha1, v1[row], beta1, sum[l]);
+		}
+	}
+}
+
+
+template<typename T>
+template<typename vector_t>
+void SellMatrix<T>::axpy(vector_t& dest,
+						 const number& alpha1, const vector_t& v1,
+						 const number& beta1, const vector_t& w1) const
+{
+	const int numThreads = NumThreadsForRange(m_numRows);
+	if(numThreads == 1){
+		axpy_slices(0, num_slices(), dest, alpha1, v1, beta1, w1);
+		return;
+	}
+
+#ifdef UG_OPENMP
+	#pragma omp parallel num_threads(numThreads)
+	{
+		size_t from, to;
+		ThreadChunk(num_slices(), NumActiveThreads(), ThreadIndex(), from, to);
+		axpy_slices(from, to, dest, alpha1, v1, beta1, w1);
+	}
+#endif
+}
+
+// end group cpu_algebra
+/// \}
+
+} // namespace ug
+
+#endif
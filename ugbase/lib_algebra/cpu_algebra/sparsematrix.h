@@ -39,6 +39,8 @@
 #include <iostream>
 #include <algorithm>
 #include "common/util/ostream_util.h"
+#include "common/util/thread_util.h"
+#include "sell_matrix.h"
 
 #include "../algebra_common/connection.h"
 #include "../algebra_common/matrixrow.h"
@@ -291,6 +293,7 @@ public:
 	value_type &operator() (size_t r, size_t c)
 	{
 		check_rc(r, c);
+		values_modified(r);
 		int j=get_index(r, c);
         UG_ASSERT(j != -1 && cols[j]==(int)c && j >= rowStart[r] && j < rowEnd[r], "");
         return values[j];
@@ -400,12 +403,12 @@ public:
 
 
 
-	row_iterator         begin_row(size_t r)         { return row_iterator(*this, r, rowStart[r]);  }
-    row_iterator         end_row(size_t r)           { return row_iterator(*this, r, rowEnd[r]);  }
+	row_iterator         begin_row(size_t r)         { values_modified(r); return row_iterator(*this, r, rowStart[r]);  }
+    row_iterator         end_row(size_t r)           { values_modified(r); return row_iterator(*this, r, rowEnd[r]);  }
     const_row_iterator   begin_row(size_t r) const   { return const_row_iterator(*this, r, rowStart[r]);  }
     const_row_iterator   end_row(size_t r)   const   { return const_row_iterator(*this, r, rowEnd[r]);  }
 
-    row_type 		get_row(size_t r) 		{ return row_type(*this, r); }
+    row_type 		get_row(size_t r) 		{ values_modified(r); return row_type(*this, r); }
     const_row_type 	get_row(size_t r) const { return const_row_type(*this, r); }
 
 public:
@@ -428,6 +431,7 @@ public:
 	row_iterator get_iterator_or_next(size_t r, size_t c)
 	{
 		check_rc(r, c);
+		values_modified(r);
 		if(rowStart[r] == -1 || rowStart[r] == rowEnd[r])
         	return end_row(r);
         else
@@ -466,6 +470,7 @@ public:
 	row_iterator get_connection(size_t r, size_t c, bool &bFound)
 	{
 		check_rc(r, c);
+		values_modified(r);
 		int j=get_index_const(r, c);
 		if(j != -1)
 		{
@@ -498,6 +503,7 @@ public:
 	row_iterator get_connection(size_t r, size_t c)
 	{
 		check_rc(r, c);
+		values_modified(r);
 		assert(bNeedsValues);
         int j=get_index(r, c);
 		return row_iterator(*this, r, j);
@@ -515,6 +521,25 @@ public:
 		(const_cast<this_type*>(this))->defragment();
 	}
 
+	/**
+	 * enables storing the frozen SELL-C-sigma copy (see EnableSellSpMV) in
+	 * reduced precision, i.e. with float entries for scalar matrices. The
+	 * matrix itself and the vectors stay in double, so this only affects
+	 * the matrix-vector products. If enabled, the copy is also created when
+	 * SELL-C-sigma copies are disabled globally. No effect for block matrices.
+	 */
+	void set_reduced_precision(bool bReduced)
+	{
+		if(bReduced != m_bReducedPrecision) drop_frozen_copy();
+		m_bReducedPrecision = bReduced;
+	}
+
+	//! returns true if matrix-vector products use a reduced precision copy of the matrix
+	bool reduced_precision() const {return m_bReducedPrecision;}
+
+	//! returns a number which is changed whenever the sparsity pattern may have changed
+	size_t pattern_revision() const {return m_patternRevision;}
+
 	/**
 	 * copies the matrix to the standard CRS format
 	 * @param numRows   	(out) num rows of A
@@ -611,6 +636,41 @@ private:
     void assureValuesSize(size_t s);
     size_t get_nnz() const { return nnz; }
 
+	//! number of unmodified products after which the frozen SELL-C-sigma copy is created
+	enum {freezeAfterProducts = 2};
+
+	//! has to be called by all functions changing the sparsity pattern
+	inline void modified()
+	{
+		++m_patternRevision;
+		if(m_numUnmodifiedProducts != 0 || !m_sell.empty()) drop_frozen_copy();
+	}
+
+	//! has to be called by all functions granting write access to entries of row r
+	/**	Only the row is marked, so that the frozen copy keeps its structure and
+	 * only the entries of the marked rows are updated before the next product.
+	 * Rows are marked by a flag of their own, so that different rows may be
+	 * accessed by several threads.*/
+	inline void values_modified(size_t r)
+	{
+		if(m_sell.empty()) return;
+		m_vSellRowModified[r] = true;
+		m_bSellValuesModified = true;
+	}
+
+	//! removes the frozen SELL-C-sigma copy
+	void drop_frozen_copy();
+
+	//! counts unmodified products, creates the frozen copy if needed and returns true if it can be used
+	bool use_frozen_copy() const;
+
+	//! updates the entries of the rows of the frozen copy marked by values_modified
+	void update_frozen_copy() const;
+
+	//! returns true if the matrix is large and its rows are of similar length
+	/**	Only then the SELL-C-sigma copy is expected to be faster than CRS.*/
+	bool sell_suitable() const;
+
 private:
 	// disallowed operations (not defined):
 	//---------------------------------------
@@ -629,6 +689,26 @@ protected:
 	void check_fragmentation() const;
 	int get_nnz_max_cols(size_t maxCols);
 
+	//! axpy restricted to rows [rowFrom, rowTo)
+	template<typename vector_t>
+	void axpy_rows(size_t rowFrom, size_t rowTo, vector_t &dest,
+			const number &alpha1, const vector_t &v1,
+			const number &beta1, const vector_t &w1) const;
+
+	//! apply_ignore_zero_rows restricted to rows [rowFrom, rowTo)
+	template<typename vector_t>
+	void apply_ignore_zero_rows_rows(size_t rowFrom, size_t rowTo, vector_t &dest,
+			const number &beta1, const vector_t &w1) const;
+
+	//! dest[j] += beta1 * sum_i A(i,j)^T * w1[i] for rows i in [rowFrom, rowTo)
+	template<typename vector_t, typename dest_t>
+	void add_transposed_rows(size_t rowFrom, size_t rowTo, dest_t &dest,
+			const number &beta1, const vector_t &w1) const;
+
+	//! adds beta1*A^T*w1 to dest. Uses per-thread partial buffers if threads are enabled.
+	template<typename vector_t>
+	void add_transposed(vector_t &dest, const number &beta1, const vector_t &w1) const;
+
 
 protected:
     std::vector<int> rowStart;
@@ -644,6 +724,19 @@ protected:
     int m_numCols;
     mutable int iIterators;
 
+    //	frozen SELL-C-sigma copy used by axpy as long as the matrix is not modified
+    mutable SellMatrix<value_type> m_sell;
+    mutable int m_numUnmodifiedProducts;
+    mutable std::vector<char> m_vSellRowModified;
+    mutable bool m_bSellValuesModified;
+    bool m_bReducedPrecision;
+
+    //	changed by modified(), i.e. whenever the sparsity pattern may have changed
+    size_t m_patternRevision;
+
+    //	per thread buffers of the threaded transposed product (numThreads x num_cols())
+    mutable std::vector<typename block_traits<value_type>::vec_type> m_transposedBuffer;
+
 #ifdef CHECK_ROW_ITERATORS
 public:
     mutable std::vector<int> nrOfRowIterators;
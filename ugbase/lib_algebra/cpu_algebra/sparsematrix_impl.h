@@ -54,6 +54,10 @@ SparseMatrix<T>::SparseMatrix()
 	PROFILE_SPMATRIX(SparseMatrix_constructor);
 	bNeedsValues = true;
 	iIterators=0;
+	m_numUnmodifiedProducts = 0;
+	m_bSellValuesModified = false;
+	m_bReducedPrecision = false;
+	m_patternRevision = 0;
 	nnz = 0;
 	m_numCols = 0;
 	maxValues = 0;
@@ -64,6 +68,7 @@ SparseMatrix<T>::SparseMatrix()
 template<typename T>
 void SparseMatrix<T>::clear_and_free()
 {
+	modified();
 	std::vector<int>().swap(rowStart);
 	std::vector<int>().swap(rowMax);
 	std::vector<int>().swap(rowEnd);
@@ -73,6 +78,7 @@ void SparseMatrix<T>::clear_and_free()
 	std::vector<int>().swap(cols);
 	std::vector<value_type>().swap(values);
 	maxValues = 0;
+	std::vector<typename block_traits<value_type>::vec_type>().swap(m_transposedBuffer);
 
 #ifdef CHECK_ROW_ITERATORS
 	std::vector<int>().swap(nrOfRowIterators);
@@ -84,6 +90,7 @@ template<typename T>
 void SparseMatrix<T>::resize_and_clear(size_t newRows, size_t newCols)
 {
 	PROFILE_SPMATRIX(SparseMatrix_resize_and_clear);
+	modified();
 	rowStart.clear(); rowStart.resize(newRows+1, -1);
 	rowMax.clear(); rowMax.resize(newRows);
 	rowEnd.clear(); rowEnd.resize(newRows, -1);
@@ -105,6 +112,7 @@ template<typename T>
 void SparseMatrix<T>::resize_and_keep_values(size_t newRows, size_t newCols)
 {
 	PROFILE_SPMATRIX(SparseMatrix_resize_and_keep_values);
+	modified();
 	//UG_LOG("SparseMatrix resize " << newRows << "x" << newCols << "\n");
 	if(newRows == 0 && newCols == 0)
 		return resize_and_clear(0,0);
@@ -184,10 +192,10 @@ inline void SparseMatrix<T>::mat_mult_add_row(size_t row, typename vector_t::val
 
 template<typename T>
 template<typename vector_t>
-void SparseMatrix<T>::apply_ignore_zero_rows(vector_t &dest,
-		const number &beta1, const vector_t &w1) const
+void SparseMatrix<T>::apply_ignore_zero_rows_rows(size_t rowFrom, size_t rowTo,
+		vector_t &dest, const number &beta1, const vector_t &w1) const
 {
-	for(size_t i=0; i < num_rows(); i++)
+	for(size_t i=rowFrom; i < rowTo; i++)
 	{
 		size_t rowIt=rowStart[i];
 		size_t itEnd=rowEnd[i];
@@ -202,18 +210,37 @@ void SparseMatrix<T>::apply_ignore_zero_rows(vector_t &dest,
 }
 
 
-// calculate dest = alpha1*v1 + beta1*A*w1 (A = this matrix)
 template<typename T>
 template<typename vector_t>
-void SparseMatrix<T>::axpy(vector_t &dest,
+void SparseMatrix<T>::apply_ignore_zero_rows(vector_t &dest,
+		const number &beta1, const vector_t &w1) const
+{
+	const int numThreads = NumThreadsForRange(num_rows());
+	if(numThreads == 1){
+		apply_ignore_zero_rows_rows(0, num_rows(), dest, beta1, w1);
+		return;
+	}
+
+#ifdef UG_OPENMP
+	#pragma omp parallel num_threads(numThreads)
+	{
+		size_t from, to;
+		ThreadChunk(num_rows(), NumActiveThreads(), ThreadIndex(), from, to);
+		apply_ignore_zero_rows_rows(from, to, dest, beta1, w1);
+	}
+#endif
+}
+
+
+template<typename T>
+template<typename vector_t>
+void SparseMatrix<T>::axpy_rows(size_t rowFrom, size_t rowTo, vector_t &dest,
 		const number &alpha1, const vector_t &v1,
 		const number &beta1, const vector_t &w1) const
 {
-	PROFILE_SPMATRIX(SparseMatrix_axpy);
-	check_fragmentation();
 	if(alpha1 == 0.0)
 	{
-		for(size_t i=0; i < num_rows(); i++)
+		for(size_t i=rowFrom; i < rowTo; i++)
 		{
 			size_t rowIt=rowStart[i];
 			size_t itEnd=rowEnd[i];
@@ -231,20 +258,20 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 	else if(&dest == &v1)
 	{
 		if(alpha1 != 1.0) {
-			for(size_t i=0; i < num_rows(); i++)
+			for(size_t i=rowFrom; i < rowTo; i++)
 			{
 				dest[i] *= alpha1;
 				mat_mult_add_row(i, dest[i], beta1, w1);
 			}
 		}
 		else
-			for(size_t i=0; i < num_rows(); i++)
+			for(size_t i=rowFrom; i < rowTo; i++)
 				mat_mult_add_row(i, dest[i], beta1, w1);
 
 	}
 	else
 	{
-		for(size_t i=0; i < num_rows(); i++)
+		for(size_t i=rowFrom; i < rowTo; i++)
 		{
 			VecScaleAssign(dest[i], alpha1, v1[i]);
 			mat_mult_add_row(i, dest[i], beta1, w1);
@@ -252,6 +279,214 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 	}
 }
 
+
+// calculate dest = alpha1*v1 + beta1*A*w1 (A = this matrix)
+template<typename T>
+template<typename vector_t>
+void SparseMatrix<T>::axpy(vector_t &dest,
+		const number &alpha1, const vector_t &v1,
+		const number &beta1, const vector_t &w1) const
+{
+	PROFILE_SPMATRIX(SparseMatrix_axpy);
+	if(use_frozen_copy()){
+		m_sell.axpy(dest, alpha1, v1, beta1, w1);
+		return;
+	}
+
+	check_fragmentation();
+
+	const int numThreads = NumThreadsForRange(num_rows());
+	if(numThreads == 1){
+		axpy_rows(0, num_rows(), dest, alpha1, v1, beta1, w1);
+		return;
+	}
+
+#ifdef UG_OPENMP
+	//	every thread works on a static, contiguous block of rows. Since all
+	//	threaded kernels use the same partitioning, the entries of dest and v1
+	//	are accessed by the thread which touched them first.
+	#pragma omp parallel num_threads(numThreads)
+	{
+		size_t from, to;
+		ThreadChunk(num_rows(), NumActiveThreads(), ThreadIndex(), from, to);
+		axpy_rows(from, to, dest, alpha1, v1, beta1, w1);
+	}
+#endif
+}
+
+
+template<typename T>
+void SparseMatrix<T>::drop_frozen_copy()
+{
+	m_numUnmodifiedProducts = 0;
+	m_sell.clear();
+	std::vector<char>().swap(m_vSellRowModified);
+	m_bSellValuesModified = false;
+}
+
+
+template<typename T>
+bool SparseMatrix<T>::sell_suitable() const
+{
+	//	small matrices are processed fast enough in CRS format, the conversion
+	//	would not pay off
+	const size_t minNNZ = 10000;
+	if(nnz < minNNZ || num_rows() == 0) return false;
+
+	//	rows of very different lengths lead to much padding. The padding is
+	//	checked exactly after the conversion, the coefficient of variation of
+	//	the row lengths is a cheap estimate to avoid needless conversions.
+	const double maxVariation = 0.5;
+	double sum = 0.0, sumSq = 0.0;
+	for(size_t r = 0; r < num_rows(); ++r){
+		const double len = num_connections(r);
+		sum += len;
+		sumSq += len * len;
+	}
+	const double mean = sum / num_rows();
+	const double var = sumSq / num_rows() - mean * mean;
+	return var <= maxVariation * maxVariation * mean * mean;
+}
+
+
+template<typename T>
+bool SparseMatrix<T>::use_frozen_copy() const
+{
+	//	the copy is only created after the sparsity pattern has been used
+	//	unmodified for a few products. This way matrices which are built between
+	//	products (e.g. during assembling) never pay for the conversion. Whether
+	//	SELL-C-sigma is used is decided once for each pattern.
+	if(m_numUnmodifiedProducts < freezeAfterProducts && NumActiveThreads() == 1)
+	{
+		if(++m_numUnmodifiedProducts == freezeAfterProducts)
+		{
+			if(!block_traits<value_type>::is_static)
+				m_sell.clear();
+			else if(!m_sell.empty()){
+				//	the copy was disabled after many rows had been changed,
+				//	only the entries are updated
+				PROFILE_SPMATRIX(SparseMatrix_update_sell_copy);
+				m_sell.copy_values(*this);
+				std::fill(m_vSellRowModified.begin(), m_vSellRowModified.end(), false);
+				m_bSellValuesModified = false;
+			}
+			else if(m_bReducedPrecision || (SellSpMVEnabled() && sell_suitable())){
+				PROFILE_SPMATRIX(SparseMatrix_create_sell_copy);
+				m_sell.init(*this, m_bReducedPrecision);
+
+				//	rows of very different lengths lead to much padding, CRS is
+				//	faster in that case
+				if(m_sell.fill_ratio() < 0.66)
+					m_sell.clear();
+				else{
+					m_vSellRowModified.assign(num_rows(), false);
+					m_bSellValuesModified = false;
+				}
+			}
+		}
+	}
+
+	if(m_bSellValuesModified && !m_sell.empty()
+		&& m_numUnmodifiedProducts == freezeAfterProducts && NumActiveThreads() == 1)
+		update_frozen_copy();
+
+	//	a copy with outdated entries is not used
+	return m_numUnmodifiedProducts == freezeAfterProducts && !m_sell.empty()
+			&& !m_bSellValuesModified;
+}
+
+
+template<typename T>
+void SparseMatrix<T>::update_frozen_copy() const
+{
+	size_t numModified = 0;
+	for(size_t r = 0; r < m_vSellRowModified.size(); ++r)
+		if(m_vSellRowModified[r]) ++numModified;
+
+	//	if many rows are changed, the matrix is probably rewritten between the
+	//	products. The copy is then not used until the matrix has again been used
+	//	unmodified for a few products, and all entries are updated at once.
+	if(4 * numModified > num_rows()){
+		m_numUnmodifiedProducts = 0;
+		return;
+	}
+
+	PROFILE_SPMATRIX(SparseMatrix_update_sell_rows);
+	for(size_t r = 0; r < m_vSellRowModified.size(); ++r){
+		if(!m_vSellRowModified[r]) continue;
+		m_sell.copy_row_values(*this, r);
+		m_vSellRowModified[r] = false;
+	}
+	m_bSellValuesModified = false;
+}
+
+
+template<typename T>
+template<typename vector_t, typename dest_t>
+void SparseMatrix<T>::add_transposed_rows(size_t rowFrom, size_t rowTo,
+		dest_t &dest, const number &beta1, const vector_t &w1) const
+{
+	for(size_t i=rowFrom; i<rowTo; i++)
+	{
+		size_t itEnd=rowEnd[i];
+		for(size_t rowIt=rowStart[i]; rowIt != itEnd; ++rowIt)
+			// dest[conn.index()] += beta1 * conn.value() * w1[i];
+			if(values[rowIt] != 0.0)
+				MatMultTransposedAdd(dest[cols[rowIt]], 1.0, dest[cols[rowIt]], beta1, values[rowIt], w1[i]);
+	}
+}
+
+
+template<typename T>
+template<typename vector_t>
+void SparseMatrix<T>::add_transposed(vector_t &dest,
+		const number &beta1, const vector_t &w1) const
+{
+	const int numThreads = NumThreadsForRange(num_rows());
+	if(numThreads == 1){
+		add_transposed_rows(0, num_rows(), dest, beta1, w1);
+		return;
+	}
+
+#ifdef UG_OPENMP
+	//	rows of A are columns of A^T, i.e. different threads would scatter into
+	//	the same entries of dest. Each thread therefore accumulates into a
+	//	private buffer, the buffers are summed up afterwards column-block-wise.
+	//	The buffers are kept by the matrix, so that they are only allocated
+	//	once for repeated products.
+	typedef typename block_traits<value_type>::vec_type vec_value_type;
+	const size_t n = num_cols();
+	if(n == 0) return;
+	if(m_transposedBuffer.size() < numThreads * n)
+		m_transposedBuffer.resize(numThreads * n);
+
+	#pragma omp parallel num_threads(numThreads)
+	{
+		const int nt = NumActiveThreads();
+		const int tid = ThreadIndex();
+
+		vec_value_type* buf = &m_transposedBuffer[tid * n];
+		for(size_t j=0; j<n; ++j){
+			//	copying dest first gives variable size blocks the right size
+			buf[j] = dest[j];
+			buf[j] = 0.0;
+		}
+
+		size_t from, to;
+		ThreadChunk(num_rows(), nt, tid, from, to);
+		add_transposed_rows(from, to, buf, beta1, w1);
+
+		#pragma omp barrier
+
+		ThreadChunk(n, nt, tid, from, to);
+		for(size_t j=from; j<to; ++j)
+			for(int t=0; t<nt; ++t)
+				dest[j] += m_transposedBuffer[t * n + j];
+	}
+#endif
+}
+
+
 // calculate dest = alpha1*v1 + beta1*A^T*w1 (A = this matrix)
 template<typename T>
 template<typename vector_t>
@@ -272,15 +507,7 @@ void SparseMatrix<T>::axpy_transposed(vector_t &dest,
 	else
 		VecScaleAssign(dest, alpha1, v1);
 
-	for(size_t i=0; i<num_rows(); i++)
-	{
-
-		size_t itEnd=rowEnd[i];
-		for(size_t rowIt=rowStart[i]; rowIt != itEnd; ++rowIt)
-			// dest[conn.index()] += beta1 * conn.value() * w1[i];
-			if(values[rowIt] != 0.0)
-				MatMultTransposedAdd(dest[cols[rowIt]], 1.0, dest[cols[rowIt]], beta1, values[rowIt], w1[i]);
-	}
+	add_transposed(dest, beta1, w1);
 }
 
 
@@ -296,14 +523,7 @@ void SparseMatrix<T>::apply_transposed_ignore_zero_rows(vector_t &dest,
 			dest[conn.index()] = 0.0;
 	}
 
-	for(size_t i=0; i<num_rows(); i++)
-	{
-		size_t itEnd=rowEnd[i];
-		for(size_t rowIt=rowStart[i]; rowIt != itEnd; ++rowIt)
-			// dest[conn.index()] += beta1 * conn.value() * w1[i];
-			if(values[rowIt] != 0.0)
-				MatMultTransposedAdd(dest[cols[rowIt]], 1.0, dest[cols[rowIt]], beta1, values[rowIt], w1[i]);
-	}
+	add_transposed(dest, beta1, w1);
 }
 
 
@@ -515,6 +735,7 @@ int SparseMatrix<T>::get_index(int r, int c)
 	{
 //		UG_LOG("new row\n");
 		// row did not start, start new row at the end of cols array
+		modified();
 		assureValuesSize(maxValues+1);
 		rowStart[r] = maxValues;
 		rowEnd[r] = maxValues+1;
@@ -543,6 +764,7 @@ int SparseMatrix<T>::get_index(int r, int c)
 	// we did not find it, so we have to add it
 
 	check_row_modifiable(r);
+	modified();
 
 #ifndef NDEBUG
 	assert(index == rowEnd[r] || cols[index] > c);
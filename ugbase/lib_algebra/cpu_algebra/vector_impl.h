@@ -39,6 +39,7 @@
 #include "algebra_misc.h"
 #include "common/math/ugmath.h"
 #include "vector.h" // for urand
+#include "common/util/thread_util.h"
 
 #define prefetchReadWrite(a)
 
@@ -82,8 +83,24 @@ inline double Vector<value_type>::dotprod(const Vector &w) //const
 template<typename value_type>
 inline double Vector<value_type>::operator = (double d)
 {
-	for(size_t i=0; i<m_size; i++)
-		values[i] = d;
+	const int numThreads = NumThreadsForRange(m_size);
+	if(numThreads == 1){
+		for(size_t i=0; i<m_size; i++)
+			values[i] = d;
+		return d;
+	}
+
+#ifdef UG_OPENMP
+//	same static partitioning as in SparseMatrix::axpy, so that the memory pages
+//	are first touched by the threads which will work on them later on
+	#pragma omp parallel num_threads(numThreads)
+	{
+		size_t from, to;
+		ThreadChunk(m_size, NumActiveThreads(), ThreadIndex(), from, to);
+		for(size_t i=from; i<to; i++)
+			values[i] = d;
+	}
+#endif
 	return d;
 }
 
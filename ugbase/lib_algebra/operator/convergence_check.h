@@ -83,6 +83,11 @@ class IConvergenceCheck
 		/// computes the defect and sets it a the next defect value
 		virtual void update(const TVector& d) = 0;
 
+		///	returns if update(d) only depends on the euclidean norm of d
+		/**	In this case solvers may compute the norm within a fused vector
+		 *	operation and pass it to update_defect() instead.*/
+		virtual bool uses_euclidean_norm() const {return false;}
+
 		/** iteration_ended
 		 *
 		 *	Checks if the iteration must be ended.
@@ -198,6 +203,8 @@ class StdConvCheck : public IConvergenceCheck<TVector>
 
 		void update(const TVector& d);
 
+		virtual bool uses_euclidean_norm() const {return true;}
+
 		bool iteration_ended();
 
 		bool post();
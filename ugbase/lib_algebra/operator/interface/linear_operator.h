@@ -138,6 +138,14 @@ class ILinearOperator : public IOperator<X,Y>
 	 */
 		virtual void apply_sub(Y& f, const X& u) = 0;
 
+#ifdef UG_PARALLEL
+	///	returns true if apply and apply_sub accept u in additive or unique storage
+	/**	If true, the operator changes u to consistent storage itself (overlapping
+	 * the communication with its computation), so that callers don't have to
+	 * make u consistent before apply. Otherwise u must be consistent.*/
+		virtual bool makes_domain_consistent() const {return false;}
+#endif
+
 	/// virtual	destructor
 		virtual ~ILinearOperator() {};
 };
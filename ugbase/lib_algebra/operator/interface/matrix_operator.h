@@ -35,6 +35,9 @@
 
 #include "linear_operator.h"
 #include "lib_algebra/common/operations_mat/matrix_algebra_types.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallel_storage_type.h"
+#endif
 
 namespace ug{
 
@@ -70,6 +73,12 @@ class MatrixOperator :	public virtual ILinearOperator<X,Y>,
 	// 	Apply Operator, i.e. f = f - L*u;
 		virtual void apply_sub(Y& f, const X& u) {matrix_type::matmul_minus(f,u);}
 
+#ifdef UG_PARALLEL
+	//	an additive parallel matrix makes u consistent during apply
+		virtual bool makes_domain_consistent() const
+			{return matrix_type::has_storage_type(PST_ADDITIVE);}
+#endif
+
 	// 	Access to matrix
 		virtual M& get_matrix() {return *this;};
 };
@@ -244,10 +244,12 @@ class BiCGStab
 				{
 					q = p;
 
-				// 	make q consistent
+				// 	make q consistent (unless the operator does it while computing A*q)
 					#ifdef UG_PARALLEL
-					if(!q.change_storage_type(PST_CONSISTENT))
-						UG_THROW("BiCGStab: Cannot convert q to consistent vector.");
+					if(m_corr_post_process.size() != 0
+						|| !linear_operator()->makes_domain_consistent())
+						if(!q.change_storage_type(PST_CONSISTENT))
+							UG_THROW("BiCGStab: Cannot convert q to consistent vector.");
 					#endif
 				}
 
@@ -282,11 +284,8 @@ class BiCGStab
 			// 	add: x := x + alpha * q
 				VecScaleAdd(x, 1.0, x, alpha, q);
 
-			//  compute s = r - alpha*v
-				VecScaleAdd(s, 1.0, r, -alpha, v);
-
-			// 	check convergence
-				convergence_check()->update(s);
+			//  compute s = r - alpha*v and check convergence
+				update_defect(s, r, alpha, v);
 
 				write_debugXR(x, s, convergence_check()->step(), 'a');
 
@@ -313,10 +312,12 @@ class BiCGStab
 				{
 					q = s;
 
-				// 	make q consistent
+				// 	make q consistent (unless the operator does it while computing A*q)
 					#ifdef UG_PARALLEL
-					if(!q.change_storage_type(PST_CONSISTENT))
-						UG_THROW("BiCGStab: Cannot convert q to consistent vector.");
+					if(m_corr_post_process.size() != 0
+						|| !linear_operator()->makes_domain_consistent())
+						if(!q.change_storage_type(PST_CONSISTENT))
+							UG_THROW("BiCGStab: Cannot convert q to consistent vector.");
 					#endif
 				}
 
@@ -332,18 +333,15 @@ class BiCGStab
 					UG_THROW("BiCGStab: Cannot convert t to unique vector.");
 				#endif
 
-			// 	tt = (t,t)
+			// 	tt = (t,t), omega = (s,t) (in one sweep)
 				number tt;
 				if (!t.size())
+				{
 					tt = 1.0;
-				else
-					tt = VecProd(t, t);
-
-			// 	omega = (s,t)
-				if (!s.size())
 					omega = 1.0;
+				}
 				else
-					omega = VecProd(s, t);
+					VecProdPair(t, t, s, t, tt, omega);
 
 			//	check tt
 				if(tt == 0.0)
@@ -359,11 +357,8 @@ class BiCGStab
 			// 	add: x := x + omega * q
 				VecScaleAdd(x, 1.0, x, omega, q);
 
-			//  compute r = s - omega*t
-				VecScaleAdd(r, 1.0, s, -omega, t);
-
-			// 	check convergence
-				convergence_check()->update(r);
+			//  compute r = s - omega*t and check convergence
+				update_defect(r, s, omega, t);
 
 				write_debugXR(x, r, convergence_check()->step(), 'b');
 
@@ -399,6 +394,23 @@ class BiCGStab
 			m_corr_post_process.remove (p);
 		}
 
+	protected:
+	///	computes d = a - alpha*b and updates the convergence check with d
+	/**	If the convergence check only needs the euclidean norm of d, it is
+	 * computed in the same sweep as the update.*/
+		void update_defect(vector_type& d, const vector_type& a,
+						   number alpha, const vector_type& b)
+		{
+			if(convergence_check()->uses_euclidean_norm())
+				convergence_check()->update_defect
+					(sqrt(VecScaleAddNormSquared(d, 1.0, a, -alpha, b)));
+			else
+			{
+				VecScaleAdd(d, 1.0, a, -alpha, b);
+				convergence_check()->update(d);
+			}
+		}
+
 	protected:
 	///	prepares the output of the convergence check
 		void prepare_conv_check()
@@ -139,7 +139,8 @@ class CG
 			}
 			else z = r;
 			
-		// 	make z consistent
+		// 	make z consistent. This can't be left to the operator, since (z,r)
+		//	needs z consistent before A*z is computed.
 			#ifdef UG_PARALLEL
 			if(!z.change_storage_type(PST_CONSISTENT))
 				UG_THROW("CG::apply_return_defect: "
@@ -189,13 +190,20 @@ class CG
 			// 	Update x := x + alpha*p
 				VecScaleAdd(x, 1.0, x, alpha, p);
 
-			// 	Update r := r - alpha*t
-				VecScaleAdd(r, 1.0, r, -alpha, q);
+			// 	Update r := r - alpha*q (computing ||r|| in the same sweep if
+			//	the convergence check only needs the norm)
+				const bool bFusedNorm = convergence_check()->uses_euclidean_norm();
+				number defect = 0.0;
+				if(bFusedNorm)
+					defect = sqrt(VecScaleAddNormSquared(r, 1.0, r, -alpha, q));
+				else
+					VecScaleAdd(r, 1.0, r, -alpha, q);
 
 				write_debugXR(x, r, convergence_check()->step());
 
 			// 	Check convergence
-				convergence_check()->update(r);
+				if(bFusedNorm) convergence_check()->update_defect(defect);
+				else convergence_check()->update(r);
 				if(convergence_check()->iteration_ended()) break;
 
 			// 	Preconditioning
@@ -174,8 +174,10 @@ class GMRES
 					if(v[j+1].invalid()) v[j+1] = x.clone_without_values();
 
 #ifdef UG_PARALLEL
-					if(!v[j]->change_storage_type(PST_CONSISTENT))
-						UG_THROW("GMRES: Cannot convert v["<<j+1<<"] to consistent vector.");
+				//	the operator may make v[j] consistent while computing A*v[j]
+					if(!linear_operator()->makes_domain_consistent())
+						if(!v[j]->change_storage_type(PST_CONSISTENT))
+							UG_THROW("GMRES: Cannot convert v["<<j+1<<"] to consistent vector.");
 #endif
 
 				//	compute r = A*v[j]
@@ -204,19 +206,20 @@ class GMRES
 				//	post-process the correction
 					m_corr_post_process.apply (*v[j+1]);
 
-				//	loop previous steps
+				//	loop previous steps (modified Gram-Schmidt). The update
+				//	v[j+1] -= h_ij * v[i] and the next product (v[j+1], v[i+1])
+				//	resp. the final norm are computed in one sweep.
+					h[0][j] = VecProd(*v[j+1], *v[0]);
 					for(size_t i = 0; i <= j; ++i)
 					{
-					//	h_ij := (r, v[j])
-						h[i][j] = VecProd(*v[j+1], *v[i]);
-
-					//	v[j+1] -= h_ij * v[i]
-						VecScaleAppend(*v[j+1], *v[i], (-1)*h[i][j]);
+						if(i < j)
+						//	v[j+1] -= h_ij * v[i], h_(i+1)j := (v[j+1], v[i+1])
+							h[i+1][j] = VecScaleAddProd(*v[j+1], 1.0, *v[j+1], -h[i][j], *v[i], *v[i+1]);
+						else
+						//	v[j+1] -= h_jj * v[j], h_{j+1,j} := ||v[j+1]||
+							h[j+1][j] = sqrt(VecScaleAddNormSquared(*v[j+1], 1.0, *v[j+1], -h[j][j], *v[j]));
 					}
 
-				//	compute h_{j+1,j}
-					h[j+1][j] = v[j+1]->norm();
-
 				//	update h
 					for(size_t i = 0; i < j; ++i)
 					{
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__NONBLOCKING_SUM__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__NONBLOCKING_SUM__
+
+#include "common/common.h"
+#ifdef UG_PARALLEL
+	#include "pcl/pcl_process_communicator.h"
+	#include "pcl/pcl_methods.h"
+#endif
+
+namespace ug{
+
+///	sums up N process-local values over all processes of a vector, in the background
+/**
+ * The local values are set via local(i), then start(v) begins the reduction
+ * over the processes of the layouts of v (a non-blocking MPI_Iallreduce).
+ * The process can do other work (e.g. apply a preconditioner) until it needs
+ * the results, which are available via global(i) after wait().
+ *
+ * In serial builds the local values are simply copied.
+ *
+ * \tparam	TVector		vector type
+ * \tparam	N			number of values
+ */
+template <typename TVector, int N>
+class NonblockingSum
+{
+	public:
+		NonblockingSum() : m_bActive(false)
+		{
+			for(int i = 0; i < N; ++i) m_local[i] = m_global[i] = 0.0;
+		}
+
+		~NonblockingSum() {wait();}
+
+	///	access to the process-local values
+		double& local(int i) {return m_local[i];}
+
+	///	starts the reduction of the local values
+		void start(const TVector& v)
+		{
+			wait();
+			#ifdef UG_PARALLEL
+			if(!v.layouts()->proc_comm().empty())
+			{
+				v.layouts()->proc_comm().iallreduce(m_local, m_global, N,
+									PCL_DT_DOUBLE, PCL_RO_SUM, &m_request);
+				m_bActive = true;
+				return;
+			}
+			#endif
+			for(int i = 0; i < N; ++i) m_global[i] = m_local[i];
+		}
+
+	///	waits for the reduction to finish
+		void wait()
+		{
+			if(!m_bActive) return;
+			#ifdef UG_PARALLEL
+			pcl::MPI_Wait(&m_request);
+			#endif
+			m_bActive = false;
+		}
+
+	///	returns the i-th global value (call wait() first)
+		number global(int i) const {return m_global[i];}
+
+	private:
+	//	disallow copy (a running reduction writes to m_global)
+		NonblockingSum(const NonblockingSum&);
+		NonblockingSum& operator=(const NonblockingSum&);
+
+	protected:
+		double m_local[N];
+		double m_global[N];
+		bool m_bActive;
+		#ifdef UG_PARALLEL
+		MPI_Request m_request;
+		#endif
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__NONBLOCKING_SUM__ */
@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPE_BICGSTAB__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPE_BICGSTAB__
+
+#include <iostream>
+#include <string>
+#include <sstream>
+
+#include "lib_algebra/operator/interface/operator.h"
+#include "lib_algebra/operator/interface/preconditioned_linear_operator_inverse.h"
+#include "lib_algebra/operator/interface/linear_solver_profiling.h"
+#include "nonblocking_sum.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	the pipelined BiCGStab method as a solver for linear operators
+/**
+ * This class implements the pipelined BiCGStab method (p-BiCGStab) of Cools
+ * and Vanroose with right preconditioning. Each iteration needs two global
+ * reductions as BiCGStab does, but they do not block: each one is reduced in
+ * the background while the preconditioner and the operator are applied.
+ * The defect norm is part of the second reduction.
+ *
+ * Vectors without hat (r, w, t, s, z, v, q, y) are kept unique, the
+ * preconditioned ones (rh = M^-1 r, ...) consistent, so that all products
+ * are process-local.
+ *
+ * For detailed description of the algorithm, please refer to:
+ *
+ * - Cools, Vanroose, "The communication-hiding pipelined BiCGStab method for
+ *   the parallel solution of large unsymmetric linear systems", Parallel
+ *   Computing 65 (2017), p. 1-20, Alg. 3 and 4
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class PipeBiCGStab
+	: public IPreconditionedLinearOperatorInverse<TVector>
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	///	Base type
+		typedef IPreconditionedLinearOperatorInverse<vector_type> base_type;
+
+	protected:
+		using base_type::convergence_check;
+		using base_type::linear_operator;
+		using base_type::preconditioner;
+		using base_type::write_debug;
+
+	public:
+	///	constructors
+		PipeBiCGStab() : base_type() {}
+
+		PipeBiCGStab(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond)
+			: base_type ( spPrecond )  {}
+
+		PipeBiCGStab(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond, SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
+			: base_type ( spPrecond, spConvCheck)  {}
+
+	///	name of solver
+		virtual const char* name() const {return "PipeBiCGStab";}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			if(preconditioner().valid())
+				return preconditioner()->supports_parallel();
+			return true;
+		}
+
+	// 	Solve J(u)*x = b, such that x = J(u)^{-1} b
+		virtual bool apply_return_defect(vector_type& x, vector_type& b)
+		{
+			LS_PROFILE_BEGIN(LS_ApplyReturnDefect);
+
+		//	check correct storage type in parallel
+			#ifdef UG_PARALLEL
+			if(!b.has_storage_type(PST_ADDITIVE) || !x.has_storage_type(PST_CONSISTENT))
+				UG_THROW("PipeBiCGStab: Inadequate storage format of Vectors.");
+			#endif
+
+		// 	build defect:  r := b - A*x
+			linear_operator()->apply_sub(b, x);
+			vector_type& r = b;
+			make_unique(r);
+
+		// 	create vectors
+			SmartPtr<vector_type> spR0 = r.clone_without_values(); vector_type& r0 = *spR0;
+			SmartPtr<vector_type> spW = r.clone_without_values(); vector_type& w = *spW;
+			SmartPtr<vector_type> spT = r.clone_without_values(); vector_type& t = *spT;
+			SmartPtr<vector_type> spS = r.clone_without_values(); vector_type& s = *spS;
+			SmartPtr<vector_type> spZ = r.clone_without_values(); vector_type& z = *spZ;
+			SmartPtr<vector_type> spV = r.clone_without_values(); vector_type& v = *spV;
+			SmartPtr<vector_type> spQ = r.clone_without_values(); vector_type& q = *spQ;
+			SmartPtr<vector_type> spY = r.clone_without_values(); vector_type& y = *spY;
+			SmartPtr<vector_type> spRh = x.clone_without_values(); vector_type& rh = *spRh;
+			SmartPtr<vector_type> spWh = x.clone_without_values(); vector_type& wh = *spWh;
+			SmartPtr<vector_type> spPh = x.clone_without_values(); vector_type& ph = *spPh;
+			SmartPtr<vector_type> spSh = x.clone_without_values(); vector_type& sh = *spSh;
+			SmartPtr<vector_type> spZh = x.clone_without_values(); vector_type& zh = *spZh;
+			SmartPtr<vector_type> spQh = x.clone_without_values(); vector_type& qh = *spQh;
+
+		//	prepare convergence check
+			prepare_conv_check();
+
+		//	compute start defect norm
+			convergence_check()->start(r);
+
+			write_debugXR(x, r, convergence_check()->step());
+
+		//	shadow residual
+			r0 = r;
+
+		//	rh := M^-1 r, w := A*rh, wh := M^-1 w, t := A*wh
+			if(!precondition(rh, r)) return false;
+			linear_operator()->apply(w, rh);
+			make_unique(w);
+			if(!precondition(wh, w)) return false;
+			linear_operator()->apply(t, wh);
+			make_unique(t);
+
+		//	sums (q,y), (y,y) resp. (r0,r), (r0,w), (r0,s), (r0,z), (r,r)
+			NonblockingSum<vector_type, 2> sums1;
+			NonblockingSum<vector_type, 5> sums2;
+
+		//	alpha := (r0,r) / (r0,w)
+			sums2.local(0) = VecProdLocal(r0, r);
+			sums2.local(1) = VecProdLocal(r0, w);
+			sums2.start(r);
+			sums2.wait();
+			number rho = sums2.global(0);
+			if(sums2.global(1) == 0.0)
+			{
+				UG_LOG("PipeBiCGStab: Method breakdown with (r0,w) = 0. Aborting iteration.\n");
+				return false;
+			}
+			number alpha = rho / sums2.global(1);
+			number beta = 0.0, omega = 1.0;
+
+		// 	Iteration loop
+			for(int iter = 0; !convergence_check()->iteration_ended(); ++iter)
+			{
+			//	update directions
+				if(iter == 0)
+				{
+					ph = rh; s = w; sh = wh; z = t;
+				}
+				else
+				{
+				//	ph := rh + beta*(ph - omega*sh), s := w + beta*(s - omega*z),
+				//	sh := wh + beta*(sh - omega*zh), z := t + beta*(z - omega*v)
+					VecScaleAdd(ph, 1.0, rh, beta, ph, -beta*omega, sh);
+					VecScaleAdd(s, 1.0, w, beta, s, -beta*omega, z);
+					VecScaleAdd(sh, 1.0, wh, beta, sh, -beta*omega, zh);
+					VecScaleAdd(z, 1.0, t, beta, z, -beta*omega, v);
+				}
+
+			//	q := r - alpha*s, qh := rh - alpha*sh, y := w - alpha*z
+				VecScaleAdd(q, 1.0, r, -alpha, s);
+				VecScaleAdd(qh, 1.0, rh, -alpha, sh);
+				VecScaleAdd(y, 1.0, w, -alpha, z);
+
+			//	start reduction of (q,y), (y,y)
+				local_sums(sums1, q, y);
+				sums1.start(r);
+
+			//	meanwhile: zh := M^-1 z, v := A*zh
+				if(!precondition(zh, z)) return false;
+				linear_operator()->apply(v, zh);
+				make_unique(v);
+
+				sums1.wait();
+				if(sums1.global(1) == 0.0)
+				{
+					UG_LOG("PipeBiCGStab: Method breakdown with (y,y) = 0. Aborting iteration.\n");
+					return false;
+				}
+				omega = sums1.global(0) / sums1.global(1);
+
+			//	x := x + alpha*ph + omega*qh
+				VecScaleAdd(x, 1.0, x, alpha, ph, omega, qh);
+
+			//	r := q - omega*y, rh := qh - omega*(wh - alpha*zh),
+			//	w := y - omega*(t - alpha*v)
+				VecScaleAdd(r, 1.0, q, -omega, y);
+				VecScaleAdd(rh, 1.0, qh, -omega, wh, omega*alpha, zh);
+				VecScaleAdd(w, 1.0, y, -omega, t, omega*alpha, v);
+
+			//	start reduction of (r0,r), (r0,w), (r0,s), (r0,z), (r,r)
+				local_sums(sums2, r0, r, w, s, z);
+				sums2.start(r);
+
+			//	meanwhile: wh := M^-1 w, t := A*wh
+				if(!precondition(wh, w)) return false;
+				linear_operator()->apply(t, wh);
+				make_unique(t);
+
+				sums2.wait();
+
+			// 	check convergence
+				if(convergence_check()->uses_euclidean_norm())
+					convergence_check()->update_defect(sqrt(sums2.global(4)));
+				else
+					convergence_check()->update(r);
+
+				write_debugXR(x, r, convergence_check()->step());
+
+				if(convergence_check()->iteration_ended()) break;
+
+			//	check values
+				if(omega == 0.0 || rho == 0.0)
+				{
+					UG_LOG("PipeBiCGStab: Method breakdown with omega = "<<omega<<
+						   ", rho = "<<rho<<". Aborting iteration.\n");
+					return false;
+				}
+
+			//	beta := (alpha/omega) * (r0,r_new)/(r0,r_old)
+				const number rhoNew = sums2.global(0);
+				beta = (alpha/omega) * (rhoNew/rho);
+				rho = rhoNew;
+
+			//	alpha := (r0,r) / ((r0,w) + beta*(r0,s) - beta*omega*(r0,z))
+				const number denom = sums2.global(1) + beta*sums2.global(2)
+									- beta*omega*sums2.global(3);
+				if(denom == 0.0)
+				{
+					UG_LOG("PipeBiCGStab: Method breakdown: alpha is an "
+						   "invalid value. Aborting iteration.\n");
+					return false;
+				}
+				alpha = rho / denom;
+			}
+
+		//	print ending output
+			return convergence_check()->post();
+		}
+
+	protected:
+	///	returns the process-local part of (a,b)
+		number VecProdLocal(const vector_type& a, const vector_type& b)
+		{
+			double sum = 0.0;
+			for(size_t i = 0; i < a.size(); ++i)
+				VecProdAdd(a[i], b[i], sum);
+			return sum;
+		}
+
+	///	computes the process-local parts of (q,y), (y,y) in one sweep
+		void local_sums(NonblockingSum<vector_type, 2>& sums,
+						const vector_type& q, const vector_type& y)
+		{
+			double qy = 0.0, yy = 0.0;
+			for(size_t i = 0; i < q.size(); ++i)
+			{
+				VecProdAdd(q[i], y[i], qy);
+				VecNormSquaredAdd(y[i], yy);
+			}
+			sums.local(0) = qy;
+			sums.local(1) = yy;
+		}
+
+	///	computes the process-local parts of (r0,r), (r0,w), (r0,s), (r0,z), (r,r) in one sweep
+		void local_sums(NonblockingSum<vector_type, 5>& sums, const vector_type& r0,
+						const vector_type& r, const vector_type& w,
+						const vector_type& s, const vector_type& z)
+		{
+			double r0r = 0.0, r0w = 0.0, r0s = 0.0, r0z = 0.0, rr = 0.0;
+			for(size_t i = 0; i < r0.size(); ++i)
+			{
+				VecProdAdd(r0[i], r[i], r0r);
+				VecProdAdd(r0[i], w[i], r0w);
+				VecProdAdd(r0[i], s[i], r0s);
+				VecProdAdd(r0[i], z[i], r0z);
+				VecNormSquaredAdd(r[i], rr);
+			}
+			sums.local(0) = r0r;
+			sums.local(1) = r0w;
+			sums.local(2) = r0s;
+			sums.local(3) = r0z;
+			sums.local(4) = rr;
+		}
+
+	///	c := M^-1 d (c := d without preconditioner)
+	/**	c is consistent afterwards or is made consistent by the operator in the
+	 * following apply.*/
+		bool precondition(vector_type& c, const vector_type& d)
+		{
+			if(preconditioner().valid())
+			{
+				if(!preconditioner()->apply(c, d))
+				{
+					UG_LOG("PipeBiCGStab: Cannot apply preconditioner. Aborting.\n");
+					return false;
+				}
+			}
+			else c = d;
+
+			#ifdef UG_PARALLEL
+			if(!linear_operator()->makes_domain_consistent())
+				if(!c.change_storage_type(PST_CONSISTENT))
+					UG_THROW("PipeBiCGStab: Cannot convert vector to consistent vector.");
+			#endif
+			return true;
+		}
+
+	///	changes the storage type of a defect-like vector to unique
+		void make_unique(vector_type& v)
+		{
+			#ifdef UG_PARALLEL
+			if(!v.change_storage_type(PST_UNIQUE))
+				UG_THROW("PipeBiCGStab: Cannot convert vector to unique vector.");
+			#endif
+		}
+
+	///	prepares the output of the convergence check
+		void prepare_conv_check()
+		{
+		//	set iteration symbol and name
+			convergence_check()->set_name(name());
+			convergence_check()->set_symbol('%');
+
+		//	set preconditioner string
+			std::string s;
+			if(preconditioner().valid())
+			  s = std::string(" (Precond: ") + preconditioner()->name() + ")";
+			else
+				s = " (No Preconditioner) ";
+			convergence_check()->set_info(s);
+		}
+
+	/// debugger output: solution and residual
+		void write_debugXR(vector_type &x, vector_type &r, int loopCnt)
+		{
+			if(!this->vector_debug_writer_valid()) return;
+			char ext[20]; sprintf(ext, "_iter%03d", loopCnt);
+			write_debug(r, std::string("PipeBiCGStab_Residual") + ext + ".vec");
+			write_debug(x, std::string("PipeBiCGStab_Solution") + ext + ".vec");
+		}
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPE_BICGSTAB__ */
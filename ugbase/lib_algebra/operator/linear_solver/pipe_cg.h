@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPE_CG__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPE_CG__
+
+#include <iostream>
+#include <string>
+#include <sstream>
+
+#include "lib_algebra/operator/interface/operator.h"
+#include "lib_algebra/operator/interface/preconditioned_linear_operator_inverse.h"
+#include "common/profiler/profiler.h"
+#include "nonblocking_sum.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	the pipelined CG method as a solver for linear operators
+/**
+ * This class implements the pipelined (preconditioned) CG method of
+ * Ghysels and Vanroose. Compared to CG it needs a few more vector updates per
+ * iteration, but only one global reduction, which does not block: the sums
+ * (r,u), (w,u) and ||r|| are reduced in the background while the
+ * preconditioner and the operator are applied. This pays off for a large
+ * number of processes, where the latency of the global reductions dominates.
+ *
+ * The defect r is updated recursively and may differ from b-A*x by rounding
+ * errors for very small relative reductions.
+ *
+ * For detailed description of the algorithm, please refer to:
+ *
+ * - Ghysels, Vanroose, "Hiding global synchronization latency in the
+ *   preconditioned Conjugate Gradient algorithm", Parallel Computing 40 (2014),
+ *   p. 224-238, Alg. 4
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class PipeCG
+	: public IPreconditionedLinearOperatorInverse<TVector>
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	///	Base type
+		typedef IPreconditionedLinearOperatorInverse<vector_type> base_type;
+
+	protected:
+		using base_type::convergence_check;
+		using base_type::linear_operator;
+		using base_type::preconditioner;
+		using base_type::write_debug;
+
+	public:
+	///	constructors
+		PipeCG() : base_type() {}
+
+		PipeCG(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond)
+			: base_type ( spPrecond )  {}
+
+		PipeCG(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond, SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
+			: base_type ( spPrecond, spConvCheck)  {}
+
+	///	name of solver
+		virtual const char* name() const {return "PipeCG";}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			if(preconditioner().valid())
+				return preconditioner()->supports_parallel();
+			return true;
+		}
+
+	///	Solve J(u)*x = b, such that x = J(u)^{-1} b
+		virtual bool apply_return_defect(vector_type& x, vector_type& b)
+		{
+			PROFILE_BEGIN_GROUP(PipeCG_apply_return_defect, "CG algebra");
+		//	check parallel storage types
+			#ifdef UG_PARALLEL
+			if(!b.has_storage_type(PST_ADDITIVE) || !x.has_storage_type(PST_CONSISTENT))
+				UG_THROW("PipeCG::apply_return_defect:"
+								"Inadequate storage format of Vectors.");
+			#endif
+
+		// 	rename r as b (for convenience)
+			vector_type& r = b;
+
+		// 	Build defect:  r := b - J(u)*x
+			linear_operator()->apply_sub(r, x);
+
+		//	r, w, n, s, z are kept unique, such that all products are local
+			make_unique(r);
+
+		// 	create help vectors
+			SmartPtr<vector_type> spU = x.clone_without_values(); vector_type& u = *spU;
+			SmartPtr<vector_type> spW = r.clone_without_values(); vector_type& w = *spW;
+			SmartPtr<vector_type> spM = x.clone_without_values(); vector_type& m = *spM;
+			SmartPtr<vector_type> spN = r.clone_without_values(); vector_type& n = *spN;
+			SmartPtr<vector_type> spZ = r.clone_without_values(); vector_type& z = *spZ;
+			SmartPtr<vector_type> spQ = x.clone_without_values(); vector_type& q = *spQ;
+			SmartPtr<vector_type> spS = r.clone_without_values(); vector_type& s = *spS;
+			SmartPtr<vector_type> spP = x.clone_without_values(); vector_type& p = *spP;
+
+		//	compute start defect
+			prepare_conv_check();
+			convergence_check()->start(r);
+
+			write_debugXR(x, r, convergence_check()->step());
+
+		// 	u := M^-1 r, w := A*u
+			if(!precondition(u, r)) return false;
+			linear_operator()->apply(w, u);
+			make_unique(w);
+
+		//	sums (r,u), (w,u), (r,r)
+			NonblockingSum<vector_type, 3> sums;
+			number gammaOld = 1.0, alphaOld = 1.0;
+
+		// 	Iteration loop
+			for(int iter = 0; ; ++iter)
+			{
+			//	start reduction of gamma = (r,u), delta = (w,u) and ||r||^2
+				local_sums(sums, r, u, w);
+				sums.start(r);
+
+			//	meanwhile: m := M^-1 w, n := A*m
+				if(!precondition(m, w)) return false;
+				linear_operator()->apply(n, m);
+				make_unique(n);
+
+				sums.wait();
+				const number gamma = sums.global(0);
+				const number delta = sums.global(1);
+
+			// 	check convergence (the norm of the start defect is already known)
+				if(iter > 0)
+				{
+					if(convergence_check()->uses_euclidean_norm())
+						convergence_check()->update_defect(sqrt(sums.global(2)));
+					else
+						convergence_check()->update(r);
+				}
+				if(convergence_check()->iteration_ended()) break;
+
+			//	compute alpha and beta
+				number beta = 0.0, lambda = delta;
+				if(iter > 0)
+				{
+					beta = gamma / gammaOld;
+					lambda = delta - beta * gamma / alphaOld;
+				}
+
+			//	check lambda
+				if(lambda == 0.0)
+				{
+					UG_LOG("ERROR in 'PipeCG::apply_return_defect': lambda=" <<
+						lambda<< " is not admitted. Aborting solver.\n");
+					return false;
+				}
+				const number alpha = gamma / lambda;
+
+			//	update directions: z := n + beta*z, q := m + beta*q,
+			//	s := w + beta*s, p := u + beta*p
+				if(iter == 0)
+				{
+					z = n; q = m; s = w; p = u;
+				}
+				else
+				{
+					VecScaleAdd(z, 1.0, n, beta, z);
+					VecScaleAdd(q, 1.0, m, beta, q);
+					VecScaleAdd(s, 1.0, w, beta, s);
+					VecScaleAdd(p, 1.0, u, beta, p);
+				}
+
+			//	x := x + alpha*p, r := r - alpha*s, u := u - alpha*q, w := w - alpha*z
+				VecScaleAdd(x, 1.0, x, alpha, p);
+				VecScaleAdd(r, 1.0, r, -alpha, s);
+				VecScaleAdd(u, 1.0, u, -alpha, q);
+				VecScaleAdd(w, 1.0, w, -alpha, z);
+
+				write_debugXR(x, r, convergence_check()->step()+1);
+
+				gammaOld = gamma;
+				alphaOld = alpha;
+			}
+
+		//	post output
+			return convergence_check()->post();
+		}
+
+	protected:
+	///	computes the process-local parts of (r,u), (w,u) and (r,r) in one sweep
+		void local_sums(NonblockingSum<vector_type, 3>& sums, const vector_type& r,
+						const vector_type& u, const vector_type& w)
+		{
+			double gamma = 0.0, delta = 0.0, rr = 0.0;
+			for(size_t i = 0; i < r.size(); ++i)
+			{
+				VecProdAdd(r[i], u[i], gamma);
+				VecProdAdd(w[i], u[i], delta);
+				VecNormSquaredAdd(r[i], rr);
+			}
+			sums.local(0) = gamma;
+			sums.local(1) = delta;
+			sums.local(2) = rr;
+		}
+
+	///	c := M^-1 d (c := d without preconditioner)
+	/**	c is consistent afterwards or is made consistent by the operator in the
+	 * following apply.*/
+		bool precondition(vector_type& c, const vector_type& d)
+		{
+			if(preconditioner().valid())
+			{
+				if(!preconditioner()->apply(c, d))
+				{
+					UG_LOG("ERROR in 'PipeCG::apply_return_defect': "
+							"Cannot apply preconditioner. Aborting.\n");
+					return false;
+				}
+			}
+			else c = d;
+
+			#ifdef UG_PARALLEL
+			if(!linear_operator()->makes_domain_consistent())
+				if(!c.change_storage_type(PST_CONSISTENT))
+					UG_THROW("PipeCG::apply_return_defect: "
+									"Cannot convert vector to consistent vector.");
+			#endif
+			return true;
+		}
+
+	///	changes the storage type of a defect-like vector to unique
+		void make_unique(vector_type& v)
+		{
+			#ifdef UG_PARALLEL
+			if(!v.change_storage_type(PST_UNIQUE))
+				UG_THROW("PipeCG::apply_return_defect: "
+								"Cannot convert vector to unique vector.");
+			#endif
+		}
+
+	///	adjust output of convergence check
+		void prepare_conv_check()
+		{
+		//	set iteration symbol and name
+			convergence_check()->set_name(name());
+			convergence_check()->set_symbol('%');
+
+		//	set preconditioner string
+			std::string s;
+			if(preconditioner().valid())
+			  s = std::string(" (Precond: ") + preconditioner()->name() + ")";
+			else
+				s = " (No Preconditioner) ";
+			convergence_check()->set_info(s);
+		}
+
+	/// debugger output: solution and residual
+		void write_debugXR(vector_type &x, vector_type &r, int loopCnt)
+		{
+			if(!this->vector_debug_writer_valid()) return;
+			char ext[20]; sprintf(ext, "_iter%03d", loopCnt);
+			write_debug(r, std::string("PipeCG_Residual") + ext + ".vec");
+			write_debug(x, std::string("PipeCG_Solution") + ext + ".vec");
+		}
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPE_CG__ */
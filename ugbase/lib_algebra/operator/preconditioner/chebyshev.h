@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__
+
+#include "lib_algebra/operator/interface/preconditioner.h"
+#include "jacobi.h"
+
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	Chebyshev smoother
+/**
+ * This preconditioner computes the correction c for a defect d by a fixed
+ * number of steps of the Jacobi-preconditioned Chebyshev iteration for
+ * A*c = d, starting with c = 0. The Chebyshev polynomial is chosen to damp
+ * the error components with eigenvalues of D^{-1}A in
+ *
+ * 		\f$ [\lambda_{max} / ratio, \lambda_{max}] \f$,
+ *
+ * i.e. the upper part of the spectrum, which makes it a smoother for
+ * multigrid methods. The largest eigenvalue is estimated in the preprocess
+ * by a few steps of the power method for D^{-1}A and multiplied by a safety
+ * factor. Only matrix-vector
+ * products, the inverse diagonal and vector updates are needed, so the
+ * smoother is independent of the ordering of the unknowns and fully parallel
+ * (threads and processes).
+ *
+ * As for all preconditioners, the correction is scaled by the damping set by
+ * set_damp (see IPreconditioner::apply).
+ *
+ * The matrix must be symmetric positive definite (or close to it) for the
+ * eigenvalue bounds to be meaningful.
+ *
+ * References:
+ * <ul>
+ * <li> Y. Saad. Iterative Methods for Sparse Linear Systems, Alg. 12.1
+ * <li> M. Adams, M. Brezina, J. Hu, R. Tuminaro. Parallel multigrid smoothing:
+ *		polynomial versus Gauss-Seidel. J. Comput. Phys. 188 (2003)
+ * </ul>
+ */
+template <typename TAlgebra>
+class Chebyshev : public IPreconditioner<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Matrix Operator type
+		typedef typename IPreconditioner<TAlgebra>::matrix_operator_type matrix_operator_type;
+
+	///	Base type
+		typedef IPreconditioner<TAlgebra> base_type;
+
+	protected:
+		using base_type::set_debug;
+		using base_type::debug_writer;
+		using base_type::write_debug;
+		using base_type::approx_operator;
+
+	public:
+	///	default constructor
+		Chebyshev()
+			: m_degree(3), m_eigRatio(30.0), m_numPowerIter(10),
+			  m_safety(1.1), m_userMaxEig(0.0), m_maxEig(0.0)
+		{}
+
+	///	constructor setting the degree
+		Chebyshev(int degree)
+			: m_degree(degree), m_eigRatio(30.0), m_numPowerIter(10),
+			  m_safety(1.1), m_userMaxEig(0.0), m_maxEig(0.0)
+		{}
+
+	/// clone constructor
+		Chebyshev(const Chebyshev<TAlgebra>& parent)
+			: base_type(parent),
+			  m_degree(parent.m_degree), m_eigRatio(parent.m_eigRatio),
+			  m_numPowerIter(parent.m_numPowerIter), m_safety(parent.m_safety),
+			  m_userMaxEig(parent.m_userMaxEig), m_maxEig(0.0)
+		{}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new Chebyshev<algebra_type>(*this));
+		}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const {return true;}
+
+	///	Destructor
+		virtual ~Chebyshev() {};
+
+	///	sets the degree of the polynomial (number of matrix-vector products)
+		void set_degree(int degree) {m_degree = degree;}
+
+	///	sets the ratio of largest and smallest eigenvalue to be damped
+		void set_eigenvalue_ratio(number ratio) {m_eigRatio = ratio;}
+
+	///	sets the maximum number of power iterations used to estimate the largest eigenvalue
+		void set_num_power_iterations(size_t num) {m_numPowerIter = num;}
+
+	///	sets the factor the estimated largest eigenvalue is multiplied with
+		void set_safety_factor(number safety) {m_safety = safety;}
+
+	///	sets the largest eigenvalue of D^{-1}A (no estimation if > 0)
+		void set_max_eigenvalue(number maxEig) {m_userMaxEig = maxEig;}
+
+	///	returns the largest eigenvalue used for the polynomial
+		number max_eigenvalue() const {return m_maxEig;}
+
+		virtual std::string config_string() const
+		{
+			std::stringstream ss;
+			ss << name() << "(degree = " << m_degree << ", ratio = " << m_eigRatio
+			   << ", max. eigenvalue = " << m_maxEig << ")";
+			return ss.str();
+		}
+
+	protected:
+	///	Name of preconditioner
+		virtual const char* name() const {return "Chebyshev";}
+
+	///	Preprocess routine
+		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_preprocess, "algebra Chebyshev");
+
+			if(m_degree < 1)
+				UG_THROW(name() << "::preprocess: Degree must be positive.");
+			if(m_eigRatio <= 1.0)
+				UG_THROW(name() << "::preprocess: Eigenvalue ratio must be greater than 1.");
+
+		//	inverse diagonal
+			m_spJacobi = make_sp(new Jacobi<TAlgebra>(1.0));
+			if(!m_spJacobi->init(pOp))
+				return false;
+
+			if(m_userMaxEig > 0.0)
+			{
+				m_maxEig = m_userMaxEig;
+				return true;
+			}
+
+		//	estimate the largest eigenvalue of D^{-1}A by the power method. Each
+		//	step computes y = A x and x = D^{-1} y and uses the Rayleigh quotient
+		//	(D^{-1}Ax, Ax) / (x, Ax), which is a lower bound for A s.p.d.
+			const matrix_type& A = *pOp;
+			vector_type x(A.num_rows()), y(A.num_rows());
+		#ifdef UG_PARALLEL
+			x.set_layouts(A.layouts());
+			y.set_layouts(A.layouts());
+		#endif
+
+		//	random start vector, smoothed by one Jacobi step
+			y.set_random(-1.0, 1.0);
+		#ifdef UG_PARALLEL
+			y.set_storage_type(PST_ADDITIVE);
+		#endif
+			if(!m_spJacobi->apply(x, y))
+				return false;
+
+			number maxEig = 0.0;
+			for(size_t it = 0; it < m_numPowerIter; ++it)
+			{
+				const number norm = x.norm();
+				if(norm == 0.0)
+					UG_THROW(name() << "::preprocess: Power iteration vector vanished.");
+				x *= 1.0 / norm;
+
+				pOp->apply(y, x);
+				const number xAx = x.dotprod(y);
+
+				if(!m_spJacobi->apply(x, y))
+					return false;
+				maxEig = x.dotprod(y) / xAx;
+			}
+
+			m_maxEig = m_safety * maxEig;
+			if(m_maxEig <= 0.0)
+				UG_THROW(name() << "::preprocess: Estimated largest eigenvalue "
+						"is not positive: " << m_maxEig);
+
+			return true;
+		}
+
+		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp,
+		                  vector_type& c, const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_step, "algebra Chebyshev");
+
+		//	center and half width of the interval
+			const number minEig = m_maxEig / m_eigRatio;
+			const number theta = 0.5 * (m_maxEig + minEig);
+			const number delta = 0.5 * (m_maxEig - minEig);
+			const number sigma = theta / delta;
+			number rho = 1.0 / sigma;
+
+			SmartPtr<vector_type> spR = d.clone(); vector_type& r = *spR;
+			SmartPtr<vector_type> spZ = c.clone_without_values(); vector_type& z = *spZ;
+			SmartPtr<vector_type> spP = c.clone_without_values(); vector_type& p = *spP;
+
+		//	p = c = 1/theta D^{-1} d
+			if(!m_spJacobi->apply(z, r)) return false;
+			VecScaleAssign(p, 1.0 / theta, z);
+			VecAssign(c, p);
+
+			for(int k = 1; k < m_degree; ++k)
+			{
+			//	r -= A p
+				pOp->apply_sub(r, p);
+
+			//	z = D^{-1} r
+				if(!m_spJacobi->apply(z, r)) return false;
+
+			//	p = rho_new * rho * p + 2 rho_new / delta * z
+				const number rhoNew = 1.0 / (2.0 * sigma - rho);
+				VecScaleAdd(p, rhoNew * rho, p, 2.0 * rhoNew / delta, z);
+				rho = rhoNew;
+
+			//	c += p
+				VecScaleAdd(c, 1.0, c, 1.0, p);
+			}
+
+			return true;
+		}
+
+	///	Postprocess routine
+		virtual bool postprocess() {return true;}
+
+	protected:
+	///	degree of polynomial
+		int m_degree;
+
+	///	ratio of largest and smallest eigenvalue to be damped
+		number m_eigRatio;
+
+	///	number of power iterations
+		size_t m_numPowerIter;
+
+	///	safety factor for the estimated eigenvalue
+		number m_safety;
+
+	///	largest eigenvalue set by the user
+		number m_userMaxEig;
+
+	///	largest eigenvalue used
+		number m_maxEig;
+
+	///	Jacobi iteration applying the inverse diagonal
+		SmartPtr<ILinearIterator<vector_type> > m_spJacobi;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__ */
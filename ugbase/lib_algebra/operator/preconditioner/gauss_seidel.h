@@ -36,6 +36,9 @@
 #include "lib_algebra/operator/interface/preconditioner.h"
 #include "lib_algebra/algebra_common/core_smoothers.h"
 #include "lib_algebra/algebra_common/sparsematrix_util.h"
+#include "lib_algebra/algebra_common/level_schedule.h"
+#include "lib_algebra/cpu_algebra/sparsematrix.h"
+#include "common/util/thread_util.h"
 #ifdef UG_PARALLEL
 	#include "lib_algebra/parallelization/parallelization.h"
 	#include "lib_algebra/parallelization/matrix_overlap.h"
@@ -63,6 +66,9 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 	///	Base type
 		typedef IPreconditioner<TAlgebra> base_type;
 
+	///	Matrix type of the reduced precision copy (mixed precision mode)
+		typedef SparseMatrix<typename reduced_precision_traits<typename matrix_type::value_type>::value_type> reduced_matrix_type;
+
 	protected:
 		using base_type::set_debug;
 		using base_type::debug_writer;
@@ -73,13 +79,19 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 		GaussSeidelBase() :
 			m_relax(1.0),
 			m_bConsistentInterfaces(false),
-			m_useOverlap(false) {};
+			m_useOverlap(false),
+			m_bLevelScheduling(false),
+			m_bMulticolor(false),
+			m_bMixedPrecision(false) {};
 
 	/// clone constructor
 		GaussSeidelBase( const GaussSeidelBase<TAlgebra> &parent )
 			: base_type(parent),
 			  m_bConsistentInterfaces(parent.m_bConsistentInterfaces),
-			  m_useOverlap(parent.m_useOverlap)
+			  m_useOverlap(parent.m_useOverlap),
+			  m_bLevelScheduling(parent.m_bLevelScheduling),
+			  m_bMulticolor(parent.m_bMulticolor),
+			  m_bMixedPrecision(parent.m_bMixedPrecision)
 		{
 			set_sor_relax(parent.m_relax);
 		}
@@ -92,6 +104,22 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 
 		void enable_overlap (bool enable) {m_useOverlap = enable;}
 
+	///	enables thread-parallel sweeps over the levels of the dependency graph
+	/**	The level sets are computed in preprocess. The result is the same as
+	 * for the sequential sweeps.*/
+		void enable_level_scheduling(bool enable) {m_bLevelScheduling = enable;}
+
+	///	enables thread-parallel sweeps in a multicolor ordering of the unknowns
+	/**	The unknowns are colored in preprocess, such that unknowns of the same
+	 * color are not coupled. The sweeps then process the colors one after
+	 * another, i.e. the smoother works on a reordered system.*/
+		void enable_multicoloring(bool enable) {m_bMulticolor = enable;}
+
+	///	enables the mixed precision mode (disabled by default)
+	/**	The sweeps then use a float copy of the matrix created in preprocess,
+	 * while defect and correction stay in double. Only for scalar algebra.*/
+		void enable_mixed_precision(bool enable) {m_bMixedPrecision = enable;}
+
 		virtual const char* name() const = 0;
 	protected:
 
@@ -137,14 +165,49 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 			THROW_IF_NOT_EQUAL(pA->num_rows(), pA->num_cols());
 //			UG_ASSERT(CheckDiagonalInvertible(A), "GS: A has noninvertible diagonal");
 			UG_COND_THROW(CheckDiagonalInvertible(*pA) == false, name() << ": A has noninvertible diagonal");
+
+		//	row schedule for thread-parallel sweeps
+			if(m_bMulticolor) m_schedule.init_colors(*pA);
+			else if(m_bLevelScheduling) m_schedule.init_levels(*pA);
+			else m_schedule.clear();
+
+		//	reduced precision copy of the matrix
+			if(m_bMixedPrecision)
+			{
+				UG_COND_THROW(!reduced_precision_traits<typename matrix_type::value_type>::is_reduced,
+				              name() << ": mixed precision only supported for scalar algebra.");
+				CopyMatrixConverted(m_reducedA, *pA);
+			}
+			else m_reducedA.clear_and_free();
 			return true;
 		}
 
+	///	returns the schedule for the sweeps, NULL for sequential sweeps in natural ordering
+		const LevelSchedule* schedule() const
+		{
+			if(m_schedule.multicolor()) return &m_schedule;
+			if(m_bLevelScheduling && NumThreads() > 1) return &m_schedule;
+			return NULL;
+		}
+
 	//	Postprocess routine
 		virtual bool postprocess() {return true;}
 
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax) = 0;
 
+	///	same as step, but on the reduced precision copy of the matrix
+		virtual void step_reduced(const reduced_matrix_type &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			UG_THROW(name() << ": mixed precision not supported.");
+		}
+
+	///	calls step on A or on its reduced precision copy
+		void sweep(const matrix_type &A, vector_type &c, const vector_type &d)
+		{
+			if(m_bMixedPrecision) step_reduced(m_reducedA, c, d, m_relax);
+			else step(A, c, d, m_relax);
+		}
+
 	//	Stepping routine
 		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp, vector_type& c, const vector_type& d)
 		{
@@ -161,7 +224,7 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 					m_oD.set_storage_type(PST_ADDITIVE);
 					m_oD.change_storage_type(PST_CONSISTENT);
 
-					step(m_A, m_oC, m_oD, m_relax);
+					sweep(m_A, m_oC, m_oD);
 
 					for(size_t i = 0; i < c.size(); ++i)
 						c[i] = m_oC[i];
@@ -175,7 +238,7 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 					spDtmp->change_storage_type(PST_CONSISTENT);
 
 					THROW_IF_NOT_EQUAL_3(c.size(), spDtmp->size(), m_A.num_rows());
-					step(m_A, c, *spDtmp, m_relax);
+					sweep(m_A, c, *spDtmp);
 
 					// declare c unique to enforce that only master correction is used
 					// when it is made consistent below
@@ -193,7 +256,7 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 					spDtmp->change_storage_type(PST_UNIQUE);
 
 					THROW_IF_NOT_EQUAL_3(c.size(), spDtmp->size(), m_A.num_rows());
-					step(m_A, c, *spDtmp, m_relax);
+					sweep(m_A, c, *spDtmp);
 					c.set_storage_type(PST_UNIQUE);
 				}
 
@@ -207,7 +270,7 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 			{
 				matrix_type &A = *pOp;
 				THROW_IF_NOT_EQUAL_4(c.size(), d.size(), A.num_rows(), A.num_cols());
-				step(A, c, d, m_relax);
+				sweep(A, c, d);
 #ifdef UG_PARALLEL
 				c.set_storage_type(PST_CONSISTENT);
 #endif
@@ -230,6 +293,15 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 
 		bool m_bConsistentInterfaces;
 		bool m_useOverlap;
+
+	///	row schedule for level scheduling resp. multicoloring
+		LevelSchedule m_schedule;
+		bool m_bLevelScheduling;
+		bool m_bMulticolor;
+
+	///	reduced precision copy of the matrix for the mixed precision mode
+		reduced_matrix_type m_reducedA;
+		bool m_bMixedPrecision;
 };
 
 /// Gauss-Seidel preconditioner for the 'forward' ordering of the dofs
@@ -251,6 +323,7 @@ class GaussSeidel : public GaussSeidelBase<TAlgebra>
 	typedef typename TAlgebra::vector_type vector_type;
 	typedef typename TAlgebra::matrix_type matrix_type;
 	typedef GaussSeidelBase<TAlgebra> base_type;
+	typedef typename base_type::reduced_matrix_type reduced_matrix_type;
 
 public:
 	//	Name of preconditioner
@@ -273,7 +346,20 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			gs_step_LL(A, c, d, relax);
+			do_step(A, c, d, relax);
+		}
+
+		virtual void step_reduced(const reduced_matrix_type &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			do_step(A, c, d, relax);
+		}
+
+	protected:
+		template<typename TMatrix>
+		void do_step(const TMatrix &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			if(base_type::schedule()) gs_step_LL(A, c, d, relax, *base_type::schedule());
+			else gs_step_LL(A, c, d, relax);
 		}
 };
 
@@ -296,6 +382,7 @@ class BackwardGaussSeidel : public GaussSeidelBase<TAlgebra>
 	typedef typename TAlgebra::vector_type vector_type;
 	typedef typename TAlgebra::matrix_type matrix_type;
 	typedef GaussSeidelBase<TAlgebra> base_type;
+	typedef typename base_type::reduced_matrix_type reduced_matrix_type;
 
 public:
 	//	Name of preconditioner
@@ -318,7 +405,20 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			gs_step_UR(A, c, d, relax);
+			do_step(A, c, d, relax);
+		}
+
+		virtual void step_reduced(const reduced_matrix_type &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			do_step(A, c, d, relax);
+		}
+
+	protected:
+		template<typename TMatrix>
+		void do_step(const TMatrix &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			if(base_type::schedule()) gs_step_UR(A, c, d, relax, *base_type::schedule());
+			else gs_step_UR(A, c, d, relax);
 		}
 };
 
@@ -330,6 +430,7 @@ class SymmetricGaussSeidel : public GaussSeidelBase<TAlgebra>
 	typedef typename TAlgebra::vector_type vector_type;
 	typedef typename TAlgebra::matrix_type matrix_type;
 	typedef GaussSeidelBase<TAlgebra> base_type;
+	typedef typename base_type::reduced_matrix_type reduced_matrix_type;
 
 public:
 	//	Name of preconditioner
@@ -352,7 +453,20 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			sgs_step(A, c, d, relax);
+			do_step(A, c, d, relax);
+		}
+
+		virtual void step_reduced(const reduced_matrix_type &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			do_step(A, c, d, relax);
+		}
+
+	protected:
+		template<typename TMatrix>
+		void do_step(const TMatrix &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			if(base_type::schedule()) sgs_step(A, c, d, relax, *base_type::schedule());
+			else sgs_step(A, c, d, relax);
 		}
 };
 
@@ -46,6 +46,10 @@
 	#include "lib_algebra/parallelization/overlap_writer.h"
 #endif
 #include "lib_algebra/algebra_common/permutation_util.h"
+#include "lib_algebra/algebra_common/level_schedule.h"
+#include "lib_algebra/algebra_common/sparsematrix_util.h"
+#include "lib_algebra/cpu_algebra/sparsematrix.h"
+#include "common/util/thread_util.h"
 
 namespace ug{
 
@@ -315,6 +319,93 @@ bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
 }
 
 
+///	computes row i of x = L^-1 b
+template<typename Matrix_type, typename Vector_type>
+struct InvertLRow
+{
+	InvertLRow(const Matrix_type &A_, Vector_type &x_, const Vector_type &b_)
+		: A(A_), x(x_), b(b_) {}
+
+	void operator()(size_t i)
+	{
+		typename Vector_type::value_type s = b[i];
+		for(typename Matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+		{
+			if(it.index() >= i) continue;
+			MatMultAdd(s, 1.0, s, -1.0, it.value(), x[it.index()]);
+		}
+		x[i] = s;
+	}
+
+	const Matrix_type &A;
+	Vector_type &x;
+	const Vector_type &b;
+};
+
+///	computes row i of x = U^-1 b
+template<typename Matrix_type, typename Vector_type>
+struct InvertURow
+{
+	InvertURow(const Matrix_type &A_, Vector_type &x_, const Vector_type &b_, number eps_)
+		: A(A_), x(x_), b(b_), eps(eps_), result(true) {}
+
+	void operator()(size_t i)
+	{
+		typename Vector_type::value_type s = b[i];
+		for(typename Matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+		{
+			if(it.index() <= i) continue;
+			MatMultAdd(s, 1.0, s, -1.0, it.value(), x[it.index()]);
+		}
+
+	//	near-zero last diagonal entry, see invert_U above
+		if(i == x.size()-1 && BlockNorm(A(i,i)) <= eps * BlockNorm(s))
+		{
+			UG_LOG("ILU Warning: Near-zero last diagonal entry "
+					"with norm "<<BlockNorm(A(i,i))<<" in U "
+					"for non-near-zero rhs entry with norm "
+					<< BlockNorm(s) << ". Setting rhs to zero.\n"
+					"NOTE: Reduce 'eps' using e.g. ILU::set_inversion_eps(...) "
+					"to avoid this warning. Current eps: " << eps << ".\n")
+			x[i] = 0;
+			result = false;
+			return;
+		}
+		InverseMatMult(x[i], 1.0, A(i,i), s);
+	}
+
+	const Matrix_type &A;
+	Vector_type &x;
+	const Vector_type &b;
+	number eps;
+	bool result;
+};
+
+// solve x = L^-1 b, processing the rows level by level (thread-parallel)
+// The result is the same as for the sequential invert_L.
+template<typename Matrix_type, typename Vector_type>
+bool invert_L(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+			  const LevelSchedule &sched)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	InvertLRow<Matrix_type, Vector_type> row(A, x, b);
+	sched.forward(row);
+	return true;
+}
+
+// solve x = U^-1 b, processing the rows level by level (thread-parallel)
+// The result is the same as for the sequential invert_U.
+template<typename Matrix_type, typename Vector_type>
+bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+			  const LevelSchedule &sched, const number eps = 1e-8)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	InvertURow<Matrix_type, Vector_type> row(A, x, b, eps);
+	sched.backward(row);
+	return row.result;
+}
+
+
 #ifdef UG_PARALLEL
 inline void
 LayoutEntriesToEndPermutation(std::vector<size_t>& newIndexOut,
@@ -370,6 +461,9 @@ class ILU : public IPreconditioner<TAlgebra>
 	///	Base type
 		typedef IPreconditioner<TAlgebra> base_type;
 
+	///	Matrix type of the reduced precision factors (mixed precision mode)
+		typedef SparseMatrix<typename reduced_precision_traits<typename matrix_type::value_type>::value_type> reduced_matrix_type;
+
 	protected:
 		using base_type::set_debug;
 		using base_type::debug_writer;
@@ -385,7 +479,10 @@ class ILU : public IPreconditioner<TAlgebra>
 			m_bSort(false),
 			m_bDisablePreprocessing(false),
 			m_useConsistentInterfaces(false),
-			m_useOverlap(false) {};
+			m_useOverlap(false),
+			m_bLevelScheduling(false),
+			m_bMulticolor(false),
+			m_bMixedPrecision(false) {};
 
 	/// clone constructor
 		ILU( const ILU<TAlgebra> &parent )
@@ -396,7 +493,10 @@ class ILU : public IPreconditioner<TAlgebra>
 			  m_bSort(parent.m_bSort),
 			  m_bDisablePreprocessing(parent.m_bDisablePreprocessing),
 			  m_useConsistentInterfaces(parent.m_useConsistentInterfaces),
-			  m_useOverlap(parent.m_useOverlap)
+			  m_useOverlap(parent.m_useOverlap),
+			  m_bLevelScheduling(parent.m_bLevelScheduling),
+			  m_bMulticolor(parent.m_bMulticolor),
+			  m_bMixedPrecision(parent.m_bMixedPrecision)
 		{	}
 
 	///	Clone
@@ -436,6 +536,23 @@ class ILU : public IPreconditioner<TAlgebra>
 
 		void enable_overlap (bool enable)				{m_useOverlap = enable;}
 
+	///	enables thread-parallel triangular solves over the levels of the factors
+		void enable_level_scheduling(bool enable)		{m_bLevelScheduling = enable;}
+
+	///	enables a multicolor reordering of the matrix before factorization
+	/**	The factors of the reordered matrix have (at most) as many levels as
+	 * colors, so that the triangular solves are well suited for threads. Note
+	 * that the factorization depends on the ordering. Replaces cuthill-mckee
+	 * sorting.*/
+		void enable_multicoloring(bool enable)			{m_bMulticolor = enable;}
+
+	///	enables the mixed precision mode (disabled by default)
+	/**	The factorization is computed in double, but the factors are stored
+	 * in single precision for the triangular solves. Defect and correction
+	 * stay in double. The double factors are released after the conversion.
+	 * Takes effect at the next preprocess. Only for scalar algebra.*/
+		void enable_mixed_precision(bool enable)		{m_bMixedPrecision = enable;}
+
 	protected:
 	//	Name of preconditioner
 		virtual const char* name() const {return "ILU";}
@@ -456,6 +573,31 @@ class ILU : public IPreconditioner<TAlgebra>
 			}
 		}
 
+		// multicolor reordering
+		void calc_multicolor_order()
+		{
+			PROFILE_BEGIN_GROUP(ILU_ReorderMulticolor, "ilu algebra");
+			LevelSchedule colors;
+			colors.init_colors(m_ILU);
+			colors.get_order(m_newIndex);
+			m_bSortIsIdentity = GetInversePermutation(m_newIndex, m_oldIndex);
+
+			if(!m_bSortIsIdentity)
+			{
+				matrix_type mat;
+				mat = m_ILU;
+				SetMatrixAsPermutation(m_ILU, mat, m_newIndex);
+			}
+		}
+
+		bool permuted() const {return (m_bSort || m_bMulticolor) && !m_bSortIsIdentity;}
+
+		const LevelSchedule* schedule() const
+		{
+			if(m_schedule.num_lower_levels() == 0 || NumThreads() == 1) return NULL;
+			return &m_schedule;
+		}
+
 	protected:
 
 	//	Preprocess routine
@@ -528,7 +670,9 @@ class ILU : public IPreconditioner<TAlgebra>
 			#endif
 
 		//	if using overlap we already sort in a different way
-			if(m_bSort && !(m_useOverlap && sortSlaveToEnd))
+			if(m_bMulticolor)
+				calc_multicolor_order();
+			else if(m_bSort && !(m_useOverlap && sortSlaveToEnd))
 				calc_cuthill_mckee();
 
 		//	Debug output of matrices
@@ -545,6 +689,10 @@ class ILU : public IPreconditioner<TAlgebra>
 			else FactorizeILU(m_ILU);
 			m_ILU.defragment();
 
+		//	level sets of the factors for thread-parallel inversion
+			if(m_bLevelScheduling || m_bMulticolor) m_schedule.init_levels(m_ILU);
+			else m_schedule.clear();
+
 		//	Debug output of matrices
 			#ifdef UG_PARALLEL
 			write_overlap_debug(m_ILU, "ILU_prep_04_A_AfterFactorize");
@@ -552,28 +700,65 @@ class ILU : public IPreconditioner<TAlgebra>
 			write_debug(m_ILU, "ILU_PreProcess_U_AfterFactor");
 			#endif
 
+		//	reduced precision copy of the factors. The double factors are not
+		//	needed anymore afterwards and are released.
+			if(m_bMixedPrecision)
+			{
+				UG_COND_THROW(!reduced_precision_traits<typename matrix_type::value_type>::is_reduced,
+				              name() << ": mixed precision only supported for scalar algebra.");
+				CopyMatrixConverted(m_ILUreduced, m_ILU);
+				m_ILU.clear_and_free();
+			}
+			else m_ILUreduced.clear_and_free();
+
 		//	we're done
 			return true;
 		}
 
 
+		bool invertL(vector_type &x, const vector_type &b)
+		{
+			if(m_ILUreduced.num_rows() != 0) return invertL(m_ILUreduced, x, b);
+			return invertL(m_ILU, x, b);
+		}
+
+		bool invertU(vector_type &x, const vector_type &b)
+		{
+			if(m_ILUreduced.num_rows() != 0) return invertU(m_ILUreduced, x, b);
+			return invertU(m_ILU, x, b);
+		}
+
+		template<typename TMatrix>
+		bool invertL(const TMatrix &A, vector_type &x, const vector_type &b)
+		{
+			if(schedule()) return invert_L(A, x, b, *schedule());
+			return invert_L(A, x, b);
+		}
+
+		template<typename TMatrix>
+		bool invertU(const TMatrix &A, vector_type &x, const vector_type &b)
+		{
+			if(schedule()) return invert_U(A, x, b, *schedule(), m_invEps);
+			return invert_U(A, x, b, m_invEps);
+		}
+
 		void applyLU(vector_type &c, const vector_type &d, vector_type &tmp)
 		{	
-			if(!m_bSort || m_bSortIsIdentity)
+			if(!permuted())
 			{
 				// 	apply iterator: c = LU^{-1}*d
-				if(! invert_L(m_ILU, tmp, d)) // h := L^-1 d
+				if(! invertL(tmp, d)) // h := L^-1 d
 					print_debugger_message("ILU: There were issues at inverting L\n");
-				if(! invert_U(m_ILU, c, tmp, m_invEps)) // c := U^-1 h = (LU)^-1 d
+				if(! invertU(c, tmp)) // c := U^-1 h = (LU)^-1 d
 					print_debugger_message("ILU: There were issues at inverting U\n");
 			}
 			else
 			{
 				// we save one vector here by renaming
 				SetVectorAsPermutation(tmp, d, m_newIndex);
-				if(! invert_L(m_ILU, c, tmp)) // c = L^{-1} d
+				if(! invertL(c, tmp)) // c = L^{-1} d
 					print_debugger_message("ILU: There were issues at inverting L (after permutation)\n");
-				if(! invert_U(m_ILU, tmp, c, m_invEps)) // tmp = (LU)^{-1} d
+				if(! invertU(tmp, c)) // tmp = (LU)^{-1} d
 					print_debugger_message("ILU: There were issues at inverting U (after permutation)\n");
 				SetVectorAsPermutation(c, tmp, m_oldIndex);
 			}
@@ -667,6 +852,9 @@ class ILU : public IPreconditioner<TAlgebra>
 	///	storage for factorization
 		matrix_type m_ILU;
 
+	///	factors in reduced precision (mixed precision mode only)
+		reduced_matrix_type m_ILUreduced;
+
 	///	help vector
 		vector_type m_h;
 
@@ -696,6 +884,14 @@ class ILU : public IPreconditioner<TAlgebra>
 
 		bool m_useConsistentInterfaces;
 		bool m_useOverlap;
+
+	///	level sets of the factors for thread-parallel inversion
+		LevelSchedule m_schedule;
+		bool m_bLevelScheduling;
+		bool m_bMulticolor;
+
+	///	apply the factors in reduced precision
+		bool m_bMixedPrecision;
 };
 
 } // end namespace ug
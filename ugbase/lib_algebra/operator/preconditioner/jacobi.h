@@ -114,16 +114,17 @@ class Jacobi : public IPreconditioner<TAlgebra>
 
 	public:
 	///	default constructor
-		Jacobi() {this->set_damp(1.0); m_bBlock = true;};
+		Jacobi() {this->set_damp(1.0); m_bBlock = true; m_bMixedPrecision = false;};
 
 	///	constructor setting the damping parameter
-		Jacobi(number damp) {this->set_damp(damp); m_bBlock = true;};
+		Jacobi(number damp) {this->set_damp(damp); m_bBlock = true; m_bMixedPrecision = false;};
 
 	/// clone constructor
 		Jacobi( const Jacobi<TAlgebra> &parent )
 			: base_type(parent)
 		{
 			set_block(parent.m_bBlock);
+			enable_mixed_precision(parent.m_bMixedPrecision);
 		}
 
 	///	Clone
@@ -147,6 +148,12 @@ class Jacobi : public IPreconditioner<TAlgebra>
 			m_bBlock = b;
 		}
 
+	///	enables storing the inverse diagonal in single precision (scalar algebra only)
+		void enable_mixed_precision(bool enable)
+		{
+			m_bMixedPrecision = enable;
+		}
+
 	protected:
 	///	Name of preconditioner
 		virtual const char* name() const {return "Jacobi";}
@@ -215,6 +222,19 @@ class Jacobi : public IPreconditioner<TAlgebra>
 				GetInverse(m_diagInv[i], m);
 			}
 
+		//	reduced precision copy of the inverse diagonal
+			if(m_bMixedPrecision)
+			{
+				UG_COND_THROW(!reduced_precision_traits<inverse_type>::is_reduced,
+				              name() << ": mixed precision only supported for scalar algebra.");
+				m_diagInvReduced.resize(m_diagInv.size());
+				for(size_t i = 0; i < m_diagInv.size(); ++i)
+					m_diagInvReduced[i] = (reduced_inverse_type) m_diagInv[i];
+				std::vector<inverse_type>().swap(m_diagInv);
+			}
+			else
+				std::vector<reduced_inverse_type>().swap(m_diagInvReduced);
+
 		//	done
 			return true;
 		}
@@ -225,11 +245,15 @@ class Jacobi : public IPreconditioner<TAlgebra>
 
 		// 	multiply defect with diagonal, c = damp * D^{-1} * d
 		//	note, that the damping is already included in the inverse diagonal
-			for(size_t i = 0; i < m_diagInv.size(); ++i)
-			{
-			// 	c[i] = m_diagInv[i] * d[i];
-				MatMult(c[i], 1.0, m_diagInv[i], d[i]);
-			}
+			if(m_bMixedPrecision)
+				for(size_t i = 0; i < m_diagInvReduced.size(); ++i)
+					MatMult(c[i], 1.0, m_diagInvReduced[i], d[i]);
+			else
+				for(size_t i = 0; i < m_diagInv.size(); ++i)
+				{
+				// 	c[i] = m_diagInv[i] * d[i];
+					MatMult(c[i], 1.0, m_diagInv[i], d[i]);
+				}
 
 #ifdef UG_PARALLEL
 
@@ -307,6 +331,11 @@ class Jacobi : public IPreconditioner<TAlgebra>
 		std::vector<inverse_type> m_diagInv;
 		bool m_bBlock;
 
+	///	inverse diagonal in reduced precision (mixed precision mode only)
+		typedef typename reduced_precision_traits<inverse_type>::value_type reduced_inverse_type;
+		std::vector<reduced_inverse_type> m_diagInvReduced;
+		bool m_bMixedPrecision;
+
 
 };
 
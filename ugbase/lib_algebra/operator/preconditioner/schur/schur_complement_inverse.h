@@ -251,6 +251,11 @@ public:
 // 	Apply Operator, i.e. f = f - L*u;
 	virtual void apply_sub(Y& f, const X& u) {m_op->apply_sub(f,u);}
 
+#ifdef UG_PARALLEL
+//	apply is forwarded to the schur complement operator
+	virtual bool makes_domain_consistent() const {return false;}
+#endif
+
 // 	Access to matrix
 	virtual M& get_matrix() {return *this;};
 };
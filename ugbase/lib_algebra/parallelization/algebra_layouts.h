@@ -36,6 +36,7 @@
 #ifdef UG_PARALLEL
 #include "pcl/pcl_base.h"
 #include "lib_algebra/parallelization/parallel_index_layout.h"
+#include "pcl/pcl_persistent_interface_communicator.h"
 #endif
 
 namespace ug{
@@ -47,12 +48,15 @@ namespace ug{
 class HorizontalAlgebraLayouts
 {
 	public:
-		HorizontalAlgebraLayouts() : m_overlapEnabled(false) 	{}
+		HorizontalAlgebraLayouts() :
+			m_overlapEnabled(false), m_persistentCommEnabled(true),
+			m_revision(0)	{}
 
 	///	clears the struct
 		void clear()
 		{
 			masterLayout.clear();			slaveLayout.clear();
+			invalidate_persistent_comms();
 		}
 
 	public:
@@ -83,12 +87,50 @@ class HorizontalAlgebraLayouts
 	///	Tells whether overlap interfaces should be considered
 		bool overlap_enabled() const		{return m_overlapEnabled;}
 
+	///	enables persistent communication for master/slave exchanges of fixed-size values
+	/**	enabled by default. It has to be enabled or disabled on all
+	 * involved processes at the same time.*/
+		void enable_persistent_communication(bool enable)	{m_persistentCommEnabled = enable;}
+	///	Tells whether persistent communication shall be used where possible
+		bool persistent_communication_enabled() const		{return m_persistentCommEnabled;}
+
+	///	returns a number which is changed whenever the master/slave layouts may have changed
+	/**	Can be used to detect whether data computed from the layouts is outdated.*/
+		size_t revision() const								{return m_revision;}
+
+	///	returns a persistent communicator which sends values from slaves to masters
+	/**	The communicator is (re-)initialized if required. Note that it is
+	 * shared between all users of the layouts.*/
+		pcl::PersistentInterfaceCommunicator<IndexLayout>&
+		slave_to_master_comm(size_t valueSize) const
+		{
+			if(!m_slaveToMasterComm.matches(slaveLayout, masterLayout, valueSize))
+				m_slaveToMasterComm.init(slaveLayout, masterLayout, valueSize, 749346);
+			return m_slaveToMasterComm;
+		}
+
+	///	returns a persistent communicator which sends values from masters to slaves
+	/**	The communicator is (re-)initialized if required. Note that it is
+	 * shared between all users of the layouts.*/
+		pcl::PersistentInterfaceCommunicator<IndexLayout>&
+		master_to_slave_comm(size_t valueSize) const
+		{
+			if(!m_masterToSlaveComm.matches(masterLayout, slaveLayout, valueSize))
+				m_masterToSlaveComm.init(masterLayout, slaveLayout, valueSize, 749347);
+			return m_masterToSlaveComm;
+		}
+
 	public:
 	/// returns the horizontal slave/master index layout
+	/**	Since the layouts may be changed through the returned references,
+	 * persistent communicators are invalidated. This is required, since
+	 * PersistentInterfaceCommunicator::matches only compares the involved
+	 * processes and the interface sizes, so that changed indices of an
+	 * interface with unchanged size would not be detected.*/
 	/// \{
-		IndexLayout& master()			{return masterLayout;}
+		IndexLayout& master()			{invalidate_persistent_comms(); return masterLayout;}
 		IndexLayout& master_overlap() 	{return masterOverlapLayout;}
-		IndexLayout& slave()			{return slaveLayout;}
+		IndexLayout& slave()			{invalidate_persistent_comms(); return slaveLayout;}
 		IndexLayout& slave_overlap() 	{return slaveOverlapLayout;}
 	/// \}
 
@@ -114,6 +156,21 @@ class HorizontalAlgebraLayouts
 		pcl::InterfaceCommunicator<IndexLayout> communicator;
 
 		bool m_overlapEnabled;
+
+		bool m_persistentCommEnabled;
+
+		size_t m_revision;
+
+		void invalidate_persistent_comms()
+		{
+			++m_revision;
+			m_slaveToMasterComm.clear();
+			m_masterToSlaveComm.clear();
+		}
+
+		///	persistent communicators, created on demand
+		mutable pcl::PersistentInterfaceCommunicator<IndexLayout>	m_slaveToMasterComm;
+		mutable pcl::PersistentInterfaceCommunicator<IndexLayout>	m_masterToSlaveComm;
 };
 
 ///	Extends the HorizontalAlgebraLayouts by vertical layouts.
@@ -33,6 +33,7 @@
 #ifndef __H__LIB_ALGEBRA__PARALLELIZATION__PARALLEL_MATRIX__
 #define __H__LIB_ALGEBRA__PARALLELIZATION__PARALLEL_MATRIX__
 
+#include <vector>
 #include "pcl/pcl.h"
 #include "parallel_index_layout.h"
 #include "parallelization_util.h"
@@ -78,12 +79,16 @@ class ParallelMatrix : public TMatrix
 	public:
 	///	Default Constructor
 		ParallelMatrix()
-			: TMatrix(), m_type(PST_UNDEFINED), m_spAlgebraLayouts(new AlgebraLayouts)
+			: TMatrix(), m_type(PST_UNDEFINED), m_spAlgebraLayouts(new AlgebraLayouts),
+			  m_pClassifiedLayouts(NULL), m_classifiedLayoutsRevision(0),
+			  m_classifiedPatternRevision(0)
 		{}
 
 	///	Constructor setting the layouts
 		ParallelMatrix(SmartPtr<AlgebraLayouts> layouts)
-			: TMatrix(), m_type(PST_UNDEFINED), m_spAlgebraLayouts(layouts)
+			: TMatrix(), m_type(PST_UNDEFINED), m_spAlgebraLayouts(layouts),
+			  m_pClassifiedLayouts(NULL), m_classifiedLayoutsRevision(0),
+			  m_classifiedPatternRevision(0)
 		{}
 
 		/////////////////////////
@@ -94,7 +99,11 @@ class ParallelMatrix : public TMatrix
 		ConstSmartPtr<AlgebraLayouts> layouts() const {return m_spAlgebraLayouts;}
 
 	///	sets the algebra layouts
-		void set_layouts(ConstSmartPtr<AlgebraLayouts> layouts) {m_spAlgebraLayouts = layouts;}
+		void set_layouts(ConstSmartPtr<AlgebraLayouts> layouts)
+		{
+			m_spAlgebraLayouts = layouts;
+			m_pClassifiedLayouts = NULL;
+		}
 
 	/// sets the storage type
 	/**	type may be any or-combination of constants enumerated in ug::ParallelStorageType.*/
@@ -125,6 +134,9 @@ class ParallelMatrix : public TMatrix
 		/////////////////////////
 
 	/// calculate res = A x
+	/**	If A is additive and x is additive or unique, x is made consistent
+	 * during the call (see apply_overlapped), i.e. x is changed although it
+	 * is passed as const.*/
 		template<typename TPVector>
 		bool apply(TPVector &res, const TPVector &x) const;
 
@@ -133,9 +145,33 @@ class ParallelMatrix : public TMatrix
 		bool apply_transposed(TPVector &res, const TPVector &x) const;
 
 	/// calculate res -= A x
+	/**	As for apply, x is made consistent if A is additive and x is not.*/
 		template<typename TPVector>
 		bool matmul_minus(TPVector &res, const TPVector &x) const;
 
+	/// calculate res = A x, overlapping the interface exchange of x with computation
+	/**
+	 * A has to be additive and x additive or unique. x is changed to consistent
+	 * storage during the call. The interface exchange is started first, then the
+	 * product is computed on all rows, using the (possibly threaded) product of
+	 * the process-local matrix. Only after that the exchange is finished and the
+	 * rows which couple to interface entries of x are computed again.
+	 *
+	 * If the exchange can't be split (variable size blocks, enabled overlap,
+	 * disabled persistent communication or different layouts of A and x), x is
+	 * made consistent by change_storage_type before the product is computed.
+	 *
+	 * \note	apply and matmul_minus forward to the overlapped versions if
+	 *			they are called with an additive A and an x which is not consistent.
+	 */
+		template<typename TPVector>
+		bool apply_overlapped(TPVector &res, TPVector &x) const;
+
+	/// calculate res -= A x, overlapping the interface exchange of x with computation
+	/**	see apply_overlapped. res has to be additive.*/
+		template<typename TPVector>
+		bool matmul_minus_overlapped(TPVector &res, TPVector &x) const;
+
 	///	assignment
 		this_type &operator =(const this_type &M);
 
@@ -145,6 +181,29 @@ class ParallelMatrix : public TMatrix
 
 	/// algebra layouts and communicators
 		ConstSmartPtr<AlgebraLayouts> m_spAlgebraLayouts;
+
+	///	computes res = A x (bSubtract == false) or res -= A x (bSubtract == true)
+		template<typename TPVector>
+		void overlapped_product(TPVector &res, TPVector &x, bool bSubtract) const;
+
+	///	computes the boundary rows of res = A x or res -= A x
+	/**	For res -= A x, vRes contains the values of res in the boundary rows
+	 * before the product.*/
+		template<typename TPVector>
+		void product_on_boundary_rows(TPVector &res, const TPVector &x, bool bSubtract,
+		                              const std::vector<typename TPVector::value_type>& vRes) const;
+
+	///	collects the rows which couple to master/slave entries
+	/**	The rows are only recomputed if the sparsity pattern or the layouts
+	 * have changed, which is detected by their revision numbers.*/
+		void classify_rows() const;
+
+	///	rows with connections to master/slave entries
+		mutable std::vector<size_t> m_vBoundaryRows;
+	///	describes the matrix for which the rows were classified
+		mutable const AlgebraLayouts* m_pClassifiedLayouts;
+		mutable size_t m_classifiedLayoutsRevision;
+		mutable size_t m_classifiedPatternRevision;
 };
 
 //	predaclaration.
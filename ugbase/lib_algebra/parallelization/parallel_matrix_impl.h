@@ -92,6 +92,14 @@ apply(TPVector &res, const TPVector &x) const
 	if(has_storage_type(PST_CONSISTENT)
 			&& x.has_storage_type(PST_CONSISTENT)) type = 2;
 
+//	an additive matrix may also be applied to an additive or unique vector.
+//	x is then made consistent while inner rows are computed.
+	if((type == -1) && has_storage_type(PST_ADDITIVE)
+		&& x.has_storage_type(PST_ADDITIVE))
+	{
+		return apply_overlapped(res, const_cast<TPVector&>(x));
+	}
+
 //	if no admissible type is found, return error
 	if(type == -1)
 	{
@@ -173,6 +181,14 @@ matmul_minus(TPVector &res, const TPVector &x) const
 			&& x.has_storage_type(PST_CONSISTENT)
 			&& res.has_storage_type(PST_ADDITIVE)) type = 0;
 
+//	an additive matrix may also be applied to an additive or unique vector.
+//	x is then made consistent while inner rows are computed.
+	if((type == -1) && this->has_storage_type(PST_ADDITIVE)
+		&& x.has_storage_type(PST_ADDITIVE) && res.has_storage_type(PST_ADDITIVE))
+	{
+		return matmul_minus_overlapped(res, const_cast<TPVector&>(x));
+	}
+
 //	if no admissible type is found, return error
 	if(type == -1)
 	{
@@ -197,6 +213,182 @@ matmul_minus(TPVector &res, const TPVector &x) const
 }
 
 
+// calculate res = A x, overlapping communication and computation
+template <typename TMatrix>
+template<typename TPVector>
+bool
+ParallelMatrix<TMatrix>::
+apply_overlapped(TPVector &res, TPVector &x) const
+{
+	PROFILE_FUNC_GROUP("algebra");
+	if(x.has_storage_type(PST_CONSISTENT))
+		return apply(res, x);
+
+	if(!(has_storage_type(PST_ADDITIVE) && x.has_storage_type(PST_ADDITIVE)))
+	{
+		UG_THROW("ParallelMatrix::apply_overlapped (b = A*x): "
+				"Wrong storage type of Matrix/Vector: Possibilities are:\n"
+				"    - A is PST_ADDITIVE and x is PST_ADDITIVE or PST_UNIQUE\n"
+				"    (storage type of A = " << get_storage_type() << ", x = " << x.get_storage_type() << ")");
+	}
+
+	overlapped_product(res, x, false);
+	res.set_storage_type(PST_ADDITIVE);
+	return true;
+}
+
+// calculate res -= A x, overlapping communication and computation
+template <typename TMatrix>
+template<typename TPVector>
+bool
+ParallelMatrix<TMatrix>::
+matmul_minus_overlapped(TPVector &res, TPVector &x) const
+{
+	PROFILE_FUNC_GROUP("algebra");
+	if(x.has_storage_type(PST_CONSISTENT))
+		return matmul_minus(res, x);
+
+	if(!(this->has_storage_type(PST_ADDITIVE) && x.has_storage_type(PST_ADDITIVE)
+		 && res.has_storage_type(PST_ADDITIVE)))
+	{
+		UG_THROW("ParallelMatrix::matmul_minus_overlapped (b -= A*x):"
+				" Wrong storage type of Matrix/Vector: Possibilities are:\n"
+				"    - A is PST_ADDITIVE and x is PST_ADDITIVE or PST_UNIQUE and b is PST_ADDITIVE\n"
+				"    (storage type of A = " << this->get_storage_type() << ", x = " << x.get_storage_type() << ", b = " << res.get_storage_type() << ")");
+	}
+
+	overlapped_product(res, x, true);
+	res.set_storage_type(PST_ADDITIVE);
+	return true;
+}
+
+template <typename TMatrix>
+template<typename TPVector>
+void
+ParallelMatrix<TMatrix>::
+overlapped_product(TPVector &res, TPVector &x, bool bSubtract) const
+{
+	typedef typename TPVector::value_type value_type;
+
+	const AlgebraLayouts* pLayouts = x.layouts().get();
+	const bool canSplit = block_traits<value_type>::is_static
+						&& (pLayouts != NULL)
+						&& (pLayouts == m_spAlgebraLayouts.get())
+						&& pLayouts->persistent_communication_enabled()
+						&& !pLayouts->overlap_enabled();
+
+//	fallback: blocking exchange followed by the product on all rows
+	if(!canSplit){
+		if(!x.change_storage_type(PST_CONSISTENT))
+			UG_THROW("ParallelMatrix: Cannot convert x to consistent vector.");
+		if(bSubtract)
+			TMatrix::axpy(res, 1.0, res, -1.0, x);
+		else
+			TMatrix::axpy(res, 0.0, res, 1.0, x);
+		return;
+	}
+
+	classify_rows();
+
+//	remember the boundary rows of res, they are computed again below
+	std::vector<value_type> vRes;
+	if(bSubtract){
+		vRes.resize(m_vBoundaryRows.size());
+		for(size_t i = 0; i < m_vBoundaryRows.size(); ++i)
+			vRes[i] = res[m_vBoundaryRows[i]];
+	}
+
+//	the product on all rows is computed while the interface values are sent.
+//	It is only wrong in the boundary rows, since the other rows do not couple
+//	to interface entries of x.
+	if(x.has_storage_type(PST_UNIQUE)){
+	//	copy master values to slaves
+		pcl::PersistentInterfaceCommunicator<IndexLayout>& comM2S
+			= pLayouts->master_to_slave_comm(sizeof(value_type));
+		comM2S.communicate_and_resume(x);
+		if(bSubtract) TMatrix::axpy(res, 1.0, res, -1.0, x);
+		else TMatrix::axpy(res, 0.0, res, 1.0, x);
+		comM2S.extract_copy(x);
+	}
+	else{
+	//	add slave values to masters and copy them back
+		pcl::PersistentInterfaceCommunicator<IndexLayout>& comS2M
+			= pLayouts->slave_to_master_comm(sizeof(value_type));
+		comS2M.communicate_and_resume(x);
+		if(bSubtract) TMatrix::axpy(res, 1.0, res, -1.0, x);
+		else TMatrix::axpy(res, 0.0, res, 1.0, x);
+		comS2M.extract_add(x);
+
+		pcl::PersistentInterfaceCommunicator<IndexLayout>& comM2S
+			= pLayouts->master_to_slave_comm(sizeof(value_type));
+		comM2S.communicate_and_resume(x);
+		comM2S.extract_copy(x);
+	}
+	x.set_storage_type(PST_CONSISTENT);
+
+	product_on_boundary_rows(res, x, bSubtract, vRes);
+}
+
+template <typename TMatrix>
+template<typename TPVector>
+void
+ParallelMatrix<TMatrix>::
+product_on_boundary_rows(TPVector &res, const TPVector &x, bool bSubtract,
+                         const std::vector<typename TPVector::value_type>& vRes) const
+{
+	for(size_t i = 0; i < m_vBoundaryRows.size(); ++i)
+	{
+		const size_t r = m_vBoundaryRows[i];
+		if(bSubtract) res[r] = vRes[i];
+		else res[r] = 0.0;
+		for(typename TMatrix::const_row_iterator conn = this->begin_row(r);
+			conn != this->end_row(r); ++conn)
+		{
+			MatMultAdd(res[r], 1.0, res[r], bSubtract ? -1.0 : 1.0, conn.value(), x[conn.index()]);
+		}
+	}
+}
+
+template <typename TMatrix>
+void
+ParallelMatrix<TMatrix>::
+classify_rows() const
+{
+	const size_t numRows = this->num_rows();
+	const AlgebraLayouts* pLayouts = m_spAlgebraLayouts.get();
+	if((m_pClassifiedLayouts == pLayouts)
+		&& (m_classifiedLayoutsRevision == pLayouts->revision())
+		&& (m_classifiedPatternRevision == this->pattern_revision()))
+	{
+		return;
+	}
+
+	PROFILE_FUNC_GROUP("algebra");
+
+//	mark all entries which are changed by the interface exchange
+	std::vector<bool> vIntfc(std::max(numRows, (size_t)this->num_cols()), false);
+	MarkAllFromLayout(vIntfc, pLayouts->master());
+	MarkAllFromLayout(vIntfc, pLayouts->slave());
+
+	m_vBoundaryRows.clear();
+	for(size_t r = 0; r < numRows; ++r)
+	{
+		bool bBoundary = vIntfc[r];
+		for(typename TMatrix::const_row_iterator conn = this->begin_row(r);
+			(!bBoundary) && (conn != this->end_row(r)); ++conn)
+		{
+			bBoundary = vIntfc[conn.index()];
+		}
+
+		if(bBoundary)
+			m_vBoundaryRows.push_back(r);
+	}
+
+	m_pClassifiedLayouts = pLayouts;
+	m_classifiedLayoutsRevision = pLayouts->revision();
+	m_classifiedPatternRevision = this->pattern_revision();
+}
+
 template<typename matrix_type, typename vector_type>
 ug::ParallelStorageType GetMultType(const ParallelMatrix<matrix_type> &A1, const ParallelVector<vector_type> &x)
 {
@@ -152,6 +152,13 @@ class ParallelVector : public TVector
 	 */
 		inline number dotprod(const this_type& v);
 
+	///	returns if the local dot products with v sum up to the global one
+	/**	This is the case for additive <-> consistent and unique <-> unique.*/
+		bool dotprod_compatible(const this_type& v) const;
+
+	///	changes the storage type of this vector such that dotprod_compatible(v) holds
+		void make_dotprod_compatible(const this_type& v);
+
 	/// assign number to whole Vector
 		number operator = (number d);
 
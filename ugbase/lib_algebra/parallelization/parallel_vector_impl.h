@@ -138,15 +138,13 @@ change_storage_type(ParallelStorageType type)
 		case PST_CONSISTENT:
 			if(has_storage_type(PST_UNIQUE)){
 				PARVEC_PROFILE_BEGIN(ParVec_CSTUnique2Consistent);
-				UniqueToConsistent(this, layouts()->master(), layouts()->slave(),
-				                   &layouts()->comm());
+				UniqueToConsistent(this, *layouts());
 				set_storage_type(PST_CONSISTENT);
 				PARVEC_PROFILE_END(); //ParVec_CSTUnique2Consistent
 			}
 			else if(has_storage_type(PST_ADDITIVE)){
 				PARVEC_PROFILE_BEGIN(ParVec_CSTAdditive2Consistent);
-				AdditiveToConsistent(this, layouts()->master(), layouts()->slave(),
-				                     &layouts()->comm());
+				AdditiveToConsistent(this, *layouts());
 				set_storage_type(PST_CONSISTENT);
 				PARVEC_PROFILE_END(); //ParVec_CSTAdditive2Consistent
 			}
@@ -182,15 +180,13 @@ change_storage_type(ParallelStorageType type)
 			if(has_storage_type(PST_ADDITIVE)){
 				PARVEC_PROFILE_BEGIN(ParVec_CSTAdditive2Unique);
 				if(layouts()->overlap_enabled()){
-					AdditiveToConsistent(this, layouts()->master(), layouts()->slave(),
-				                     	 &layouts()->comm());
+					AdditiveToConsistent(this, *layouts());
 					CopyValues(this, layouts()->slave_overlap(),
 				           	   layouts()->master_overlap(), &layouts()->comm());
 					ConsistentToUnique(this, layouts()->slave());
 				}
 				else{
-					AdditiveToUnique(this, layouts()->master(), layouts()->slave(),
-					                 &layouts()->comm());
+					AdditiveToUnique(this, *layouts());
 				}
 				add_storage_type(PST_UNIQUE);
 				PARVEC_PROFILE_END(); //ParVec_CSTAdditive2Unique
@@ -321,10 +317,22 @@ number ParallelVector<TVector>::maxnorm() const
 }
 
 template <typename TVector>
-inline
-number ParallelVector<TVector>::dotprod(const this_type& v)
+bool ParallelVector<TVector>::dotprod_compatible(const this_type& v) const
+{
+	//	additive (unique) <-> consistent is ok
+	//	unique <-> unique is ok
+	if(this->has_storage_type(PST_ADDITIVE)
+			&& v.has_storage_type(PST_CONSISTENT)) return true;
+	if(this->has_storage_type(PST_CONSISTENT)
+			&& v.has_storage_type(PST_ADDITIVE)) return true;
+	if(this->has_storage_type(PST_UNIQUE)
+			&& v.has_storage_type(PST_UNIQUE))     return true;
+	return false;
+}
+
+template <typename TVector>
+void ParallelVector<TVector>::make_dotprod_compatible(const this_type& v)
 {
-	PROFILE_FUNC_GROUP("algebra parallelization");
 	// 	step 0: check that storage type is given
 	if(this->has_storage_type(PST_UNDEFINED) || v.has_storage_type(PST_UNDEFINED))
 	{
@@ -335,33 +343,32 @@ number ParallelVector<TVector>::dotprod(const this_type& v)
 	}
 
 	//	step 1: Check if good storage type are given (no communication needed)
-	//         - additive (unique) <-> consistent is ok
-	//         - unique <-> unique is ok
-	bool check = false;
-	if(this->has_storage_type(PST_ADDITIVE)
-			&& v.has_storage_type(PST_CONSISTENT)) check = true;
-	if(this->has_storage_type(PST_CONSISTENT)
-			&& v.has_storage_type(PST_ADDITIVE)) check = true;
-	if(this->has_storage_type(PST_UNIQUE)
-			&& v.has_storage_type(PST_UNIQUE))     check = true;
+	if(dotprod_compatible(v)) return;
 
 	// 	step 2: fall back
 	//         	if storage type not as in the upper cases, communicate to
 	//			correct solution a user of this function should ideally avoid
 	//			such a change and do it outside of this function
-	if(!check)
-	{
-		// unique <-> additive => consistent <-> additive
-		if(this->has_storage_type(PST_UNIQUE)
-				&& v.has_storage_type(PST_ADDITIVE))
-		{this->change_storage_type(PST_CONSISTENT);}
-		// additive <-> unique => unique <-> unique
-		else if(this->has_storage_type(PST_ADDITIVE)
-				&& v.has_storage_type(PST_UNIQUE))
-		{this->change_storage_type(PST_UNIQUE);}
-		// consistent <-> consistent => unique <-> consistent
-		else {this->change_storage_type(PST_UNIQUE);}
-	}
+
+	// unique <-> additive => consistent <-> additive
+	if(this->has_storage_type(PST_UNIQUE)
+			&& v.has_storage_type(PST_ADDITIVE))
+	{this->change_storage_type(PST_CONSISTENT);}
+	// additive <-> unique => unique <-> unique
+	else if(this->has_storage_type(PST_ADDITIVE)
+			&& v.has_storage_type(PST_UNIQUE))
+	{this->change_storage_type(PST_UNIQUE);}
+	// consistent <-> consistent => unique <-> consistent
+	else {this->change_storage_type(PST_UNIQUE);}
+}
+
+template <typename TVector>
+inline
+number ParallelVector<TVector>::dotprod(const this_type& v)
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	//	steps 0 - 2: make storage types fit
+	make_dotprod_compatible(v);
 
 	// 	step 3: compute local dot product
 	double tSumLocal = (double)TVector::dotprod(v);
@@ -510,6 +517,97 @@ inline double VecProd(const ParallelVector<T> &a, const ParallelVector<T> &b)
 	return const_cast<ParallelVector<T>* >(&a)->dotprod(b);
 }
 
+// sums up n local values over all processes of the vector
+template<typename T>
+inline void AllreduceSum(const ParallelVector<T> &v, double* local, double* global, int n)
+{
+	if(v.layouts()->proc_comm().empty())
+		for(int i = 0; i < n; ++i) global[i] = local[i];
+	else
+		v.layouts()->proc_comm().allreduce(local, global, n,
+		                                   PCL_DT_DOUBLE, PCL_RO_SUM);
+}
+
+// dest = alpha1*v1 + alpha2*v2, returns norm_2^2(dest)
+template<typename T>
+inline double VecScaleAddNormSquared(ParallelVector<T> &dest,
+                                     double alpha1, const ParallelVector<T> &v1,
+                                     double alpha2, const ParallelVector<T> &v2)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	uint mask = v1.get_storage_mask() & v2.get_storage_mask();
+	UG_COND_THROW(mask == 0, "VecScaleAddNormSquared: cannot add vectors v1 and v2 because their storage masks are incompatible");
+	dest.set_storage_type(mask);
+
+	double local;
+	if(dest.has_storage_type(PST_UNIQUE))
+		local = VecScaleAddNormSquared((T&)dest, alpha1, (const T&)v1, alpha2, (const T&)v2);
+	else
+	{
+	//	the norm needs a unique vector, i.e. communication between update and norm
+		VecScaleAdd((T&)dest, alpha1, (const T&)v1, alpha2, (const T&)v2);
+		if(!dest.change_storage_type(PST_UNIQUE))
+			UG_THROW("VecScaleAddNormSquared: Cannot change ParallelStorageType to unique.");
+		local = VecNormSquared((const T&)dest);
+	}
+
+	double global;
+	AllreduceSum(dest, &local, &global, 1);
+	return global;
+}
+
+// dest = alpha1*v1 + alpha2*v2, returns scal<dest, w>
+template<typename T>
+inline double VecScaleAddProd(ParallelVector<T> &dest,
+                              double alpha1, const ParallelVector<T> &v1,
+                              double alpha2, const ParallelVector<T> &v2,
+                              const ParallelVector<T> &w)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	uint mask = v1.get_storage_mask() & v2.get_storage_mask();
+	UG_COND_THROW(mask == 0, "VecScaleAddProd: cannot add vectors v1 and v2 because their storage masks are incompatible");
+	dest.set_storage_type(mask);
+
+	double local;
+	if(dest.dotprod_compatible(w))
+		local = VecScaleAddProd((T&)dest, alpha1, (const T&)v1, alpha2, (const T&)v2, (const T&)w);
+	else
+	{
+	//	storage types do not fit, communication between update and product
+		VecScaleAdd((T&)dest, alpha1, (const T&)v1, alpha2, (const T&)v2);
+		dest.make_dotprod_compatible(w);
+		local = VecProd((const T&)dest, (const T&)w);
+	}
+
+	double global;
+	AllreduceSum(dest, &local, &global, 1);
+	return global;
+}
+
+// prod1 = scal<a1, b1>, prod2 = scal<a2, b2> with one allreduce
+template<typename T>
+inline void VecProdPair(const ParallelVector<T> &a1, const ParallelVector<T> &b1,
+                        const ParallelVector<T> &a2, const ParallelVector<T> &b2,
+                        double &prod1, double &prod2)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	const_cast<ParallelVector<T>* >(&a1)->make_dotprod_compatible(b1);
+	const_cast<ParallelVector<T>* >(&a2)->make_dotprod_compatible(b2);
+
+//	the second change of storage types might have affected the first pair
+	if(!a1.dotprod_compatible(b1))
+	{
+		prod1 = VecProd(a1, b1);
+		prod2 = VecProd(a2, b2);
+		return;
+	}
+
+	double local[2], global[2];
+	VecProdPair((const T&)a1, (const T&)b1, (const T&)a2, (const T&)b2, local[0], local[1]);
+	AllreduceSum(a1, local, global, 2);
+	prod1 = global[0]; prod2 = global[1];
+}
+
 // Elementwise (Hadamard) product of two vectors
 template<typename T>
 inline void VecHadamardProd(ParallelVector<T> &dest, const ParallelVector<T> &v1, const ParallelVector<T> &v2)
@@ -190,6 +190,40 @@ void AdditiveToConsistent(	TVector* pVec,
 		PU_PROFILE_END(AdditiveToConsistent_step2);
 }
 
+/// changes parallel storage type from additive to consistent
+/**
+ * If persistent communication is enabled in the given layouts and if the
+ * vector has entries of fixed size, the persistent communicators of the layouts
+ * are used. Otherwise the InterfaceCommunicator of the layouts is used.
+ *
+ * \param[in,out]		pVec			Parallel Vector
+ * \param[in]			layouts			Algebra Layouts
+ */
+template <typename TVector>
+void AdditiveToConsistent(TVector* pVec, const HorizontalAlgebraLayouts& layouts)
+{
+	typedef typename TVector::value_type value_type;
+	if(!(block_traits<value_type>::is_static
+		 && layouts.persistent_communication_enabled()))
+	{
+		AdditiveToConsistent(pVec, layouts.master(), layouts.slave(), &layouts.comm());
+		return;
+	}
+
+	PROFILE_FUNC_GROUP("algebra parallelization");
+//	step 1: add slave values to master
+	pcl::PersistentInterfaceCommunicator<IndexLayout>& comS2M
+		= layouts.slave_to_master_comm(sizeof(value_type));
+	comS2M.communicate_and_resume(*pVec);
+	comS2M.extract_add(*pVec);
+
+//	step 2: copy master values to slaves
+	pcl::PersistentInterfaceCommunicator<IndexLayout>& comM2S
+		= layouts.master_to_slave_comm(sizeof(value_type));
+	comM2S.communicate_and_resume(*pVec);
+	comM2S.extract_copy(*pVec);
+}
+
 /// changes parallel storage type from unique to consistent
 /**
  * This function changes the storage type of a parallel vector from unique
@@ -223,6 +257,33 @@ void UniqueToConsistent(	TVector* pVec,
 }
 
 
+/// changes parallel storage type from unique to consistent
+/**
+ * If persistent communication is enabled in the given layouts and if the
+ * vector has entries of fixed size, the persistent communicators of the layouts
+ * are used. Otherwise the InterfaceCommunicator of the layouts is used.
+ *
+ * \param[in,out]		pVec			Parallel Vector
+ * \param[in]			layouts			Algebra Layouts
+ */
+template <typename TVector>
+void UniqueToConsistent(TVector* pVec, const HorizontalAlgebraLayouts& layouts)
+{
+	typedef typename TVector::value_type value_type;
+	if(!(block_traits<value_type>::is_static
+		 && layouts.persistent_communication_enabled()))
+	{
+		UniqueToConsistent(pVec, layouts.master(), layouts.slave(), &layouts.comm());
+		return;
+	}
+
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	pcl::PersistentInterfaceCommunicator<IndexLayout>& com
+		= layouts.master_to_slave_comm(sizeof(value_type));
+	com.communicate_and_resume(*pVec);
+	com.extract_copy(*pVec);
+}
+
 ///	Copies values from the source to the target layout
 template <typename TVector>
 void CopyValues(	TVector* pVec,
@@ -340,6 +401,36 @@ void SetLayoutValues(	TVector* pVec,
 	}
 }
 
+/// changes parallel storage type from additive to unique
+/**
+ * If persistent communication is enabled in the given layouts and if the
+ * vector has entries of fixed size, the persistent communicators of the layouts
+ * are used. Otherwise the InterfaceCommunicator of the layouts is used.
+ *
+ * \param[in,out]		pVec			Parallel Vector
+ * \param[in]			layouts			Algebra Layouts
+ */
+template <typename TVector>
+void AdditiveToUnique(TVector* pVec, const HorizontalAlgebraLayouts& layouts)
+{
+	typedef typename TVector::value_type value_type;
+	if(!(block_traits<value_type>::is_static
+		 && layouts.persistent_communication_enabled()))
+	{
+		AdditiveToUnique(pVec, layouts.master(), layouts.slave(), &layouts.comm());
+		return;
+	}
+
+	PROFILE_FUNC_GROUP("algebra parallelization");
+//	add slave values to master and set slave values to zero. Slave values
+//	are gathered in communicate_and_resume and may be reset afterwards.
+	pcl::PersistentInterfaceCommunicator<IndexLayout>& com
+		= layouts.slave_to_master_comm(sizeof(value_type));
+	com.communicate_and_resume(*pVec);
+	SetLayoutValues(pVec, layouts.slave(), 0);
+	com.extract_add(*pVec);
+}
+
 /// scales the values of a vector by a given number only on the layout indices
 /**
  * \param[in,out]		pVec			Vector
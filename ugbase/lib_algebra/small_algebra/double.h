@@ -40,7 +40,7 @@
  *	by the same methods.
  */
 
-// todo: also with float / complex<float> / complex<double>
+// todo: also with complex<float> / complex<double>
 
 #ifndef __H__UG__SMALL_ALGEBRA__DOUBLE__
 #define __H__UG__SMALL_ALGEBRA__DOUBLE__
@@ -73,6 +73,24 @@ inline number BlockMaxNorm(const number &a)
 	return a>0 ? a : -a;
 }
 
+template <>
+inline number BlockNorm(const float &a)
+{
+	return a>0 ? a : -a;
+}
+
+template <>
+inline number BlockNorm2(const float &a)
+{
+	return (number)a*a;
+}
+
+template <>
+inline number BlockMaxNorm(const float &a)
+{
+	return a>0 ? a : -a;
+}
+
 //////////////////////////////////////////////////////
 // get/set specialization for numbers
 
@@ -160,6 +178,21 @@ inline bool InverseMatMult(number &dest, const double &beta, const number &mat,
 	return true;
 }
 
+///////////////////////////////////////////////////////////////////
+// float matrix entries acting on number vectors (reduced precision copies)
+
+inline bool InverseMatMult(number &dest, const double &beta, const float &mat, const number &vec)
+{
+	dest = beta*vec/mat;
+	return true;
+}
+
+inline bool GetInverse(float &inv, const float &m)
+{
+	inv = 1.0f/m;
+	return (m != 0.0f);
+}
+
 ///////////////////////////////////////////////////////////////////
 // traits: information for numbers
 
@@ -177,6 +210,36 @@ struct block_traits<number>
 	enum { depth = 0 };
 };
 
+template<>
+struct block_traits<float>
+{
+	typedef float vec_type;
+	typedef float inverse_type;
+
+	enum { is_static = true};
+	enum { static_num_rows = 1};
+	enum { static_num_cols = 1};
+	enum { static_size = 1 };
+	enum { depth = 0 };
+};
+
+///	type used to store reduced precision copies of matrices with entries of type T
+/**	For scalar entries the copies are stored in single precision, all other
+ * block types are kept (is_reduced == false).*/
+template<typename T>
+struct reduced_precision_traits
+{
+	typedef T value_type;
+	enum { is_reduced = false };
+};
+
+template<>
+struct reduced_precision_traits<double>
+{
+	typedef float value_type;
+	enum { is_reduced = true };
+};
+
 template<> struct block_multiply_traits<number, number>
 {
 	typedef number ReturnType;
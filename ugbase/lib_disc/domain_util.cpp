@@ -37,6 +37,8 @@
 #include "lib_grid/file_io/file_io.h"
 #include "lib_grid/file_io/file_io_ugx.h"
 #include "lib_grid/algorithms/geom_obj_util/misc_util.h"
+#include "lib_grid/algorithms/serialization.h"
+#include "lib_grid/parallelization/partitioned_grid_file.h"
 #include "lib_grid/refinement/projectors/projection_handler.h"
 #include "common/profiler/profiler.h"
 
@@ -147,6 +149,45 @@ void SaveDomain(TDomain& domain, const char* filename)
 }
 
 
+///	adds serializers for positions and subset handlers of the domain
+template <typename TDomain>
+static void AddDomainSerializers(GridDataSerializationHandler& handler, TDomain& domain)
+{
+	handler.add(GeomObjAttachmentSerializer<Vertex, typename TDomain::position_attachment_type>::
+				create(*domain.grid(), domain.position_attachment()));
+	handler.add(SubsetHandlerSerializer::create(*domain.subset_handler()));
+
+	vector<string> additionalSHNames = domain.additional_subset_handler_names();
+	for(size_t i_name = 0; i_name < additionalSHNames.size(); ++i_name)
+		handler.add(SubsetHandlerSerializer::create(
+					*domain.additional_subset_handler(additionalSHNames[i_name])));
+}
+
+template <typename TDomain>
+void SavePartitionedDomain(TDomain& domain, PartitionMap& partitionMap,
+						   const char* filename)
+{
+	PROFILE_FUNC_GROUP("grid");
+	UG_COND_THROW(partitionMap.get_partition_handler()->grid() != domain.grid().get(),
+				  "SavePartitionedDomain: The partition map has to operate on the"
+				  " grid of the domain.");
+
+	GridDataSerializationHandler serializer;
+	AddDomainSerializers(serializer, domain);
+	SavePartitionedGrid(*domain.grid(), *partitionMap.get_partition_handler(),
+						partitionMap.get_target_proc_vec(), serializer, filename);
+}
+
+template <typename TDomain>
+void LoadPartitionedDomain(TDomain& domain, const char* filename)
+{
+	PROFILE_FUNC_GROUP("grid");
+	GridDataSerializationHandler deserializer;
+	AddDomainSerializers(deserializer, domain);
+	LoadPartitionedGrid(*domain.grid(), deserializer, filename);
+}
+
+
 template <typename TDomain>
 number MaxElementDiameter(TDomain& domain, int level)
 {
@@ -177,6 +218,14 @@ template void SaveDomain<Domain1d>(Domain1d& domain, const char* filename);
 template void SaveDomain<Domain2d>(Domain2d& domain, const char* filename);
 template void SaveDomain<Domain3d>(Domain3d& domain, const char* filename);
 
+template void SavePartitionedDomain<Domain1d>(Domain1d& domain, PartitionMap& partitionMap, const char* filename);
+template void SavePartitionedDomain<Domain2d>(Domain2d& domain, PartitionMap& partitionMap, const char* filename);
+template void SavePartitionedDomain<Domain3d>(Domain3d& domain, PartitionMap& partitionMap, const char* filename);
+
+template void LoadPartitionedDomain<Domain1d>(Domain1d& domain, const char* filename);
+template void LoadPartitionedDomain<Domain2d>(Domain2d& domain, const char* filename);
+template void LoadPartitionedDomain<Domain3d>(Domain3d& domain, const char* filename);
+
 template number MaxElementDiameter<Domain1d>(Domain1d& domain, int level);
 template number MaxElementDiameter<Domain2d>(Domain2d& domain, int level);
 template number MaxElementDiameter<Domain3d>(Domain3d& domain, int level);
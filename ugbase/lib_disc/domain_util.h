@@ -35,6 +35,7 @@
 
 // other lib_discretization headers
 #include "domain.h"
+#include "lib_grid/tools/partition_map.h"
 
 namespace ug{
 
@@ -58,6 +59,21 @@ void LoadDomain(TDomain& domain, const char* filename, int procId);
 template <typename TDomain>
 void SaveDomain(TDomain& domain, const char* filename);
 
+///	Saves the domain to a partitioned grid file.
+/**	Each partition of the partition map is written to a separate block of the
+ * file, together with its horizontal interfaces. The domain must consist of
+ * one level only. See SavePartitionedGrid for details.*/
+template <typename TDomain>
+void SavePartitionedDomain(TDomain& domain, PartitionMap& partitionMap,
+						   const char* filename);
+
+///	Each process loads its partition of a partitioned grid file.
+/**	The domain has to be empty. Additional subset handlers have to be created
+ * in the same order as in the saved domain before the file is loaded.
+ * No redistribution is required afterwards.*/
+template <typename TDomain>
+void LoadPartitionedDomain(TDomain& domain, const char* filename);
+
 
 ////////////////////////////////////////////////////////////////////////
 ///	returns the corner coordinates of a geometric object
@@ -46,7 +46,14 @@
 #include "lib_disc/reference_element/reference_mapping_provider.h"
 #include "lib_grid/algorithms/space_partitioning/lg_ntree.h"
 
+#ifdef UG_PARALLEL
+#include "pcl/pcl_process_communicator.h"
+#endif
+
 #include <math.h>       /* fabs */
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 namespace ug{
 
@@ -74,6 +81,9 @@ class GlobalGridFunctionNumberData
 		typedef lg_ntree<dim, dim, element_t>	tree_t;
 		tree_t	m_tree;
 
+	///	bounding box of the local elements (empty if m_boxMin > m_boxMax)
+		MathVector<dim> m_boxMin, m_boxMax;
+
 	public:
 	/// constructor
 		GlobalGridFunctionNumberData(SmartPtr<TGridFunction> spGridFct, const char* cmp)
@@ -128,6 +138,22 @@ class GlobalGridFunctionNumberData
 
 			m_tree.create_tree(elemsWithGridFunctions.begin(), elemsWithGridFunctions.end());
 
+		//	bounding box of the local elements, used to forward points in
+		//	the batched evaluate_global
+			VecSet(m_boxMin, std::numeric_limits<number>::max());
+			VecSet(m_boxMax, -std::numeric_limits<number>::max());
+			const typename TGridFunction::domain_type::position_accessor_type& aaPos
+				= spGridFct->domain()->position_accessor();
+			for(size_t i = 0; i < elemsWithGridFunctions.size(); ++i){
+				element_t* elem = elemsWithGridFunctions[i];
+				for(size_t j = 0; j < NumVertices(elem); ++j){
+					const MathVector<dim>& p = aaPos[GetVertex(elem, j)];
+					for(int d = 0; d < dim; ++d){
+						m_boxMin[d] = std::min(m_boxMin[d], p[d]);
+						m_boxMax[d] = std::max(m_boxMax[d], p[d]);
+					}
+				}
+			}
 		};
 
 		virtual ~GlobalGridFunctionNumberData() {}
@@ -202,6 +228,86 @@ class GlobalGridFunctionNumberData
 			//			   << ElementDebugInfo(*m_spGridFct->domain()->grid(), elem));
 		}
 
+		///	evaluates the data at several points, returns the number of found points
+		/**	The points are processed along a Morton curve, so that consecutive
+		 * points mostly lie in the same element. For those points the tree
+		 * lookup is skipped and the reference mapping, the shape function set
+		 * and the DoF values of the element are reused.
+		 * vFound[i] is set to true, if vX[i] lies in a local element.*/
+		size_t evaluate(std::vector<number>& vValue, std::vector<bool>& vFound,
+						const std::vector<MathVector<dim> >& vX) const
+		{
+			const size_t numPts = vX.size();
+			vValue.assign(numPts, 0.0);
+			vFound.assign(numPts, false);
+			if(numPts == 0)
+				return 0;
+
+		//	sort the points along a Morton curve through their bounding box
+			MathVector<dim> boxMin = vX[0], boxMax = vX[0];
+			for(size_t i = 1; i < numPts; ++i){
+				for(int d = 0; d < dim; ++d){
+					boxMin[d] = std::min(boxMin[d], vX[i][d]);
+					boxMax[d] = std::max(boxMax[d], vX[i][d]);
+				}
+			}
+
+			std::vector<std::pair<uint64, size_t> > vOrder(numPts);
+			for(size_t i = 0; i < numPts; ++i)
+				vOrder[i] = std::make_pair(morton_key(vX[i], boxMin, boxMax), i);
+			std::sort(vOrder.begin(), vOrder.end());
+
+		//	data of the current element
+			element_t* elem = NULL;
+			DimReferenceMapping<elemDim, dim>* pMap = NULL;
+			const LocalShapeFunctionSet<elemDim>* pTrialSpace = NULL;
+			std::vector<MathVector<dim> > vCornerCoords;
+			std::vector<DoFIndex> ind;
+			std::vector<number> vDoFValue;
+			std::vector<number> vShape;
+			MathVector<elemDim> locPos;
+			size_t numFound = 0;
+
+			for(size_t k = 0; k < numPts; ++k){
+				const size_t i = vOrder[k].second;
+				const MathVector<dim>& x = vX[i];
+
+			//	reuse the element of the previous point if it contains x
+				if(!elem || !ContainsPoint(elem, x, m_tree.common_data().position_accessor()))
+				{
+					element_t* newElem = NULL;
+					if(!FindContainingElement(newElem, m_tree, x))
+						continue;
+
+					elem = newElem;
+					CollectCornerCoordinates(vCornerCoords, *elem, *m_spGridFct->domain());
+					const ReferenceObjectID roid = elem->reference_object_id();
+					pMap = &ReferenceMappingProvider::get<elemDim, dim>(roid, vCornerCoords);
+					pTrialSpace = &LocalFiniteElementProvider::get<elemDim>(roid, m_lfeID);
+
+					m_spGridFct->dof_indices(elem, m_fct, ind);
+					vDoFValue.resize(ind.size());
+					for(size_t sh = 0; sh < ind.size(); ++sh)
+						vDoFValue[sh] = DoFRef(*m_spGridFct, ind[sh]);
+				}
+
+			//	get local position and evaluate
+				VecSet(locPos, 0.5);
+				pMap->global_to_local(locPos, x);
+				pTrialSpace->shapes(vShape, locPos);
+
+				number value = 0.0;
+				for(size_t sh = 0; sh < vShape.size(); ++sh)
+					value += vDoFValue[sh] * vShape[sh];
+
+				vValue[i] = value;
+				vFound[i] = true;
+				++numFound;
+			}
+
+			return numFound;
+		}
+
 		/// evaluate value on all procs
 		inline void evaluate_global(number& value, const MathVector<dim>& x) const
 		{
@@ -254,6 +360,181 @@ class GlobalGridFunctionNumberData
 
 			return value;
 		}
+
+		///	evaluates the data at several points, which may lie on any process
+		/**	Each process passes its own points. Points which are not found
+		 * locally are sent to all processes whose element bounding box
+		 * contains them. If several processes find a point, the mean of their
+		 * values is used. The values are returned in the order of vX.
+		 * This method has to be called on all processes.*/
+		void evaluate_global(std::vector<number>& vValue,
+							 const std::vector<MathVector<dim> >& vX) const
+		{
+			std::vector<bool> vFound;
+			size_t numFound = evaluate(vValue, vFound, vX);
+
+#ifdef UG_PARALLEL
+			pcl::ProcessCommunicator com;
+			const int numProcs = com.size();
+			const int rank = pcl::ProcRank();
+
+		//	exchange the bounding boxes of the local elements
+			std::vector<number> vMyBox(2 * dim), vBoxes(2 * dim * numProcs);
+			for(int d = 0; d < dim; ++d){
+				vMyBox[d] = m_boxMin[d];
+				vMyBox[dim + d] = m_boxMax[d];
+			}
+			com.allgather(&vMyBox.front(), 2 * dim, PCL_DT_DOUBLE,
+						  &vBoxes.front(), 2 * dim, PCL_DT_DOUBLE);
+
+		//	collect the points which are sent to each process
+			const number tol = 1e-10;
+			std::vector<std::vector<number> > vSendPts(numProcs);
+			std::vector<std::vector<size_t> > vSendInd(numProcs);
+			for(size_t i = 0; i < vX.size(); ++i){
+				if(vFound[i])
+					continue;
+				for(int p = 0; p < numProcs; ++p){
+					if(p == rank)
+						continue;
+					const number* box = &vBoxes[2 * dim * p];
+					bool inBox = true;
+					for(int d = 0; d < dim; ++d){
+						if(vX[i][d] < box[d] - tol || vX[i][d] > box[dim + d] + tol){
+							inBox = false;
+							break;
+						}
+					}
+					if(inBox){
+						for(int d = 0; d < dim; ++d)
+							vSendPts[p].push_back(vX[i][d]);
+						vSendInd[p].push_back(i);
+					}
+				}
+			}
+
+		//	exchange the number of points
+			std::vector<int> vNumSend(numProcs), vNumRecv(numProcs);
+			for(int p = 0; p < numProcs; ++p)
+				vNumSend[p] = (int)vSendInd[p].size();
+			com.alltoall(&vNumSend.front(), 1, PCL_DT_INT,
+						 &vNumRecv.front(), 1, PCL_DT_INT);
+
+			std::vector<int> vSendTo, vSendSizes, vRecvFrom, vRecvSizes;
+			std::vector<number> vSendBuf;
+			size_t numRecvPts = 0;
+			for(int p = 0; p < numProcs; ++p){
+				if(vNumSend[p] > 0){
+					vSendTo.push_back(p);
+					vSendSizes.push_back(vNumSend[p] * dim * sizeof(number));
+					vSendBuf.insert(vSendBuf.end(), vSendPts[p].begin(), vSendPts[p].end());
+				}
+				if(vNumRecv[p] > 0){
+					vRecvFrom.push_back(p);
+					vRecvSizes.push_back(vNumRecv[p] * dim * sizeof(number));
+					numRecvPts += vNumRecv[p];
+				}
+			}
+
+		//	send the points to the processes which may contain them
+			std::vector<number> vRecvBuf(numRecvPts * dim + 1);
+			com.distribute_data(&vRecvBuf.front(), GetDataPtr(vRecvSizes),
+								GetDataPtr(vRecvFrom), (int)vRecvFrom.size(),
+								GetDataPtr(vSendBuf), GetDataPtr(vSendSizes),
+								GetDataPtr(vSendTo), (int)vSendTo.size());
+
+		//	evaluate the received points and send back (found, value) pairs
+			std::vector<MathVector<dim> > vRecvX(numRecvPts);
+			for(size_t i = 0; i < numRecvPts; ++i)
+				for(int d = 0; d < dim; ++d)
+					vRecvX[i][d] = vRecvBuf[i * dim + d];
+
+			std::vector<number> vRecvValue;
+			std::vector<bool> vRecvFound;
+			evaluate(vRecvValue, vRecvFound, vRecvX);
+
+			std::vector<number> vAnswerBuf(2 * numRecvPts + 1);
+			for(size_t i = 0; i < numRecvPts; ++i){
+				vAnswerBuf[2 * i] = vRecvFound[i] ? 1.0 : 0.0;
+				vAnswerBuf[2 * i + 1] = vRecvValue[i];
+			}
+			for(size_t i = 0; i < vRecvSizes.size(); ++i)
+				vRecvSizes[i] = vNumRecv[vRecvFrom[i]] * 2 * sizeof(number);
+			for(size_t i = 0; i < vSendSizes.size(); ++i)
+				vSendSizes[i] = vNumSend[vSendTo[i]] * 2 * sizeof(number);
+
+			std::vector<number> vResultBuf(2 * vSendBuf.size() / dim + 1);
+			com.distribute_data(&vResultBuf.front(), GetDataPtr(vSendSizes),
+								GetDataPtr(vSendTo), (int)vSendTo.size(),
+								&vAnswerBuf.front(), GetDataPtr(vRecvSizes),
+								GetDataPtr(vRecvFrom), (int)vRecvFrom.size());
+
+		//	average the values of all processes which found a point
+			std::vector<int> vNumFinders(vX.size(), 0);
+			size_t offset = 0;
+			for(size_t i = 0; i < vSendTo.size(); ++i){
+				const std::vector<size_t>& vInd = vSendInd[vSendTo[i]];
+				for(size_t j = 0; j < vInd.size(); ++j, ++offset){
+					if(vResultBuf[2 * offset] == 0.0)
+						continue;
+					vValue[vInd[j]] += vResultBuf[2 * offset + 1];
+					++vNumFinders[vInd[j]];
+				}
+			}
+
+			for(size_t i = 0; i < vX.size(); ++i){
+				if(vNumFinders[i] > 0){
+					vValue[i] /= vNumFinders[i];
+					vFound[i] = true;
+					++numFound;
+				}
+			}
+#endif
+
+			if(numFound < vX.size()){
+				for(size_t i = 0; i < vX.size(); ++i)
+					if(!vFound[i])
+						UG_THROW("Couldn't find an element containing the specified point: " << vX[i]);
+			}
+		}
+
+		///	evaluates at the given positions, passed as consecutive coordinates
+		std::vector<number> evaluate_global_batch(const std::vector<number>& vCoords)
+		{
+			if(vCoords.size() % dim != 0)
+				UG_THROW("Expected a multiple of "<<dim<<" components, but given "<<vCoords.size());
+
+			std::vector<MathVector<dim> > vX(vCoords.size() / dim);
+			for(size_t i = 0; i < vX.size(); ++i)
+				for(int d = 0; d < dim; ++d)
+					vX[i][d] = vCoords[i * dim + d];
+
+			std::vector<number> vValue;
+			evaluate_global(vValue, vX);
+			return vValue;
+		}
+
+	private:
+	///	returns the position of x on a Morton curve through [boxMin, boxMax]
+		static uint64 morton_key(const MathVector<dim>& x, const MathVector<dim>& boxMin,
+								 const MathVector<dim>& boxMax)
+		{
+			const int bitsPerDim = 20;
+			const number maxCoord = (number)(((uint64)1 << bitsPerDim) - 1);
+
+			uint64 coord[dim];
+			for(int d = 0; d < dim; ++d){
+				const number w = boxMax[d] - boxMin[d];
+				const number s = (w > 0) ? (x[d] - boxMin[d]) / w : 0;
+				coord[d] = (uint64)(std::min<number>(std::max<number>(s, 0), 1) * maxCoord);
+			}
+
+			uint64 key = 0;
+			for(int b = bitsPerDim - 1; b >= 0; --b)
+				for(int d = 0; d < dim; ++d)
+					key = (key << 1) | ((coord[d] >> b) & 1);
+			return key;
+		}
 };
 
 
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__IO__CHECKPOINT__
+#define __H__UG__LIB_DISC__IO__CHECKPOINT__
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "common/util/binary_buffer.h"
+#include "lib_grid/lib_grid.h"
+#include "lib_disc/function_spaces/grid_function.h"
+
+namespace ug{
+
+///	Writes and reads the full state of a (distributed) simulation for restarts
+/**
+ * A checkpoint contains the complete multigrid hierarchy of a domain with
+ * positions and subset handlers, the parallel grid layouts and the values of
+ * an arbitrary number of grid functions. All processes write their part in
+ * one pass into one common file (see pcl::WriteCombinedParallelFile). Each
+ * part is protected by a crc32 checksum that is verified on reading.
+ *
+ * Restarting only requires to deserialize the grid, i.e. no grid has to be
+ * loaded and refined and no redistribution is needed. The values of grid
+ * functions are stored per grid element, so that they are independent of the
+ * numbering of the dofs. A checkpoint has to be read with the same number of
+ * processes it was written with.
+ *
+ * Usage:
+ * - write: add the grid functions to be saved and call write.
+ * - read: call read with an empty domain, then create the approximation
+ *   space and the grid functions as usual and call load for each function.
+ *   Additional subset handlers are created in the domain if necessary.
+ *   The grid must not be changed between read and load.
+ */
+template <typename TDomain, typename TAlgebra>
+class Checkpoint
+{
+	public:
+	///	grid function type
+		typedef GridFunction<TDomain, TAlgebra> function_type;
+
+	///	position attachment type
+		typedef typename TDomain::position_attachment_type position_attachment_type;
+
+	public:
+		Checkpoint();
+		~Checkpoint();
+
+	///	adds a grid function to be written with the given name
+		void add(SmartPtr<function_type> spGridFct, const char* name);
+
+	///	removes all added grid functions
+		void clear_functions();
+
+	///	writes the domain and all added grid functions to a file
+		void write(const char* filename, SmartPtr<TDomain> spDomain);
+
+	///	reads the domain from a file
+	/**	The grid of the domain must be empty. The values of the grid functions
+	 * contained in the file are kept in memory until they are loaded.*/
+		void read(const char* filename, SmartPtr<TDomain> spDomain);
+
+	///	loads the values of the grid function with the given name
+	/**	The function must be defined on the domain passed to read.*/
+		void load(SmartPtr<function_type> spGridFct, const char* name);
+
+	///	returns the names of the grid functions in the last read file
+		std::vector<std::string> function_names() const;
+
+	///	releases the data of the last read file
+		void clear_read_data();
+
+	protected:
+		template <class TElem>
+		void write_values(BinaryBuffer& out, function_type& u,
+		                  MultiElementAttachmentAccessor<AInt>& aaIndex);
+
+		template <class TElem>
+		void read_values(BinaryBuffer& in, function_type& u,
+		                 const std::vector<TElem*>& vElem);
+
+	///	writes the buffer of all processes to one file
+		void write_file(BinaryBuffer& buffer, const char* filename);
+
+	///	reads the buffer of this process from the file
+		void read_file(BinaryBuffer& buffer, const char* filename);
+
+	protected:
+	///	grid functions to be written
+		std::vector<std::pair<std::string, SmartPtr<function_type> > > m_vFunction;
+
+	///	data of the last read file and read positions of the grid functions
+		BinaryBuffer m_readBuffer;
+		std::map<std::string, size_t> m_mFunctionPos;
+
+	///	grid elements of the last read file in the order of the file
+		std::vector<Vertex*> m_vVrt;
+		std::vector<Edge*> m_vEdge;
+		std::vector<Face*> m_vFace;
+		std::vector<Volume*> m_vVol;
+		SmartPtr<TDomain> m_spReadDomain;
+};
+
+} // end namespace ug
+
+#include "checkpoint_impl.h"
+
+#endif /* __H__UG__LIB_DISC__IO__CHECKPOINT__ */
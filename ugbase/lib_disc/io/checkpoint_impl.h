@@ -0,0 +1,503 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__IO__CHECKPOINT_IMPL__
+#define __H__UG__LIB_DISC__IO__CHECKPOINT_IMPL__
+
+#include <cstdio>
+#include <cstring>
+
+#include "common/log.h"
+#include "common/error.h"
+#include "common/serialization.h"
+#include "common/profiler/profiler.h"
+#include "common/util/crc32.h"
+#include "common/util/async_output.h"
+#include "lib_disc/common/multi_index.h"
+#include "lib_grid/algorithms/serialization.h"
+#include "lib_grid/algorithms/attachment_util.h"
+#include "lib_grid/parallelization/partitioned_grid_file.h"
+
+#ifdef UG_PARALLEL
+#include "pcl/pcl_base.h"
+#include "pcl/parallel_file.h"
+#include "lib_grid/parallelization/distributed_grid.h"
+#endif
+
+#include "checkpoint.h"
+
+namespace ug{
+
+///	magic numbers and version of the checkpoint format
+enum CheckpointConstants{
+	CHECKPOINT_MAGIC_BEGIN = 0x55474350,
+	CHECKPOINT_MAGIC_END = 0x45474350,
+	CHECKPOINT_VERSION = 1
+};
+
+template <typename TDomain, typename TAlgebra>
+Checkpoint<TDomain, TAlgebra>::
+Checkpoint()
+{}
+
+template <typename TDomain, typename TAlgebra>
+Checkpoint<TDomain, TAlgebra>::
+~Checkpoint()
+{}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+add(SmartPtr<function_type> spGridFct, const char* name)
+{
+	UG_COND_THROW(spGridFct.invalid(), "Checkpoint::add: Invalid grid function"
+				  " passed for '" << name << "'.");
+
+	for(size_t i = 0; i < m_vFunction.size(); ++i)
+		if(m_vFunction[i].first == name)
+			UG_THROW("Checkpoint::add: A grid function with name '" << name
+					 << "' has already been added.");
+
+	m_vFunction.push_back(std::make_pair(std::string(name), spGridFct));
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+clear_functions()
+{
+	m_vFunction.clear();
+}
+
+template <typename TDomain, typename TAlgebra>
+std::vector<std::string> Checkpoint<TDomain, TAlgebra>::
+function_names() const
+{
+	std::vector<std::string> vName;
+	for(std::map<std::string, size_t>::const_iterator iter = m_mFunctionPos.begin();
+		iter != m_mFunctionPos.end(); ++iter)
+		vName.push_back(iter->first);
+	return vName;
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+clear_read_data()
+{
+	m_readBuffer = BinaryBuffer();
+	m_mFunctionPos.clear();
+	m_vVrt.clear(); m_vEdge.clear(); m_vFace.clear(); m_vVol.clear();
+	m_spReadDomain = SPNULL;
+}
+
+template <typename TDomain, typename TAlgebra>
+template <class TElem>
+void Checkpoint<TDomain, TAlgebra>::
+write_values(BinaryBuffer& out, function_type& u,
+             MultiElementAttachmentAccessor<AInt>& aaIndex)
+{
+	typedef typename function_type::template traits<TElem>::const_iterator iterator;
+	std::vector<DoFIndex> vInd;
+
+//	count the elements carrying dofs
+	int numElem = 0;
+	for(iterator iter = u.template begin<TElem>(); iter != u.template end<TElem>(); ++iter)
+	{
+		vInd.clear();
+		for(size_t fct = 0; fct < u.num_fct(); ++fct)
+			u.inner_dof_indices(*iter, fct, vInd, false);
+		if(!vInd.empty())
+			++numElem;
+	}
+	Serialize(out, numElem);
+
+//	write index of element and values
+	for(iterator iter = u.template begin<TElem>(); iter != u.template end<TElem>(); ++iter)
+	{
+		vInd.clear();
+		for(size_t fct = 0; fct < u.num_fct(); ++fct)
+			u.inner_dof_indices(*iter, fct, vInd, false);
+		if(vInd.empty()) continue;
+
+		Serialize(out, aaIndex[*iter]);
+		Serialize(out, vInd.size());
+		for(size_t i = 0; i < vInd.size(); ++i)
+			Serialize(out, (double)DoFRef(u, vInd[i]));
+	}
+}
+
+template <typename TDomain, typename TAlgebra>
+template <class TElem>
+void Checkpoint<TDomain, TAlgebra>::
+read_values(BinaryBuffer& in, function_type& u, const std::vector<TElem*>& vElem)
+{
+	std::vector<DoFIndex> vInd;
+
+	int numElem = Deserialize<int>(in);
+	for(int i = 0; i < numElem; ++i)
+	{
+		int ind = Deserialize<int>(in);
+		size_t numDoF = Deserialize<size_t>(in);
+		UG_COND_THROW(ind < 0 || (size_t)ind >= vElem.size(),
+					  "Checkpoint::load: Invalid element index.");
+
+		vInd.clear();
+		for(size_t fct = 0; fct < u.num_fct(); ++fct)
+			u.inner_dof_indices(vElem[ind], fct, vInd, false);
+		UG_COND_THROW(vInd.size() != numDoF, "Checkpoint::load: Number of dofs"
+					  " of a " << vElem[ind]->reference_object_id() << " does not"
+					  " match ("<< numDoF << " in file, " << vInd.size() << " in"
+					  " grid function). The approximation space has to be the"
+					  " same as for the written function.");
+
+		for(size_t j = 0; j < vInd.size(); ++j)
+			DoFRef(u, vInd[j]) = Deserialize<double>(in);
+	}
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+write(const char* filename, SmartPtr<TDomain> spDomain)
+{
+	PROFILE_FUNC_GROUP("output");
+	UG_COND_THROW(spDomain.invalid(), "Checkpoint::write: Invalid domain.");
+
+	MultiGrid& mg = *spDomain->grid();
+	BinaryBuffer out;
+
+	int numProcs = 1;
+#ifdef UG_PARALLEL
+	numProcs = pcl::NumProcs();
+#endif
+
+	Serialize(out, (int)CHECKPOINT_MAGIC_BEGIN);
+	Serialize(out, (int)CHECKPOINT_VERSION);
+	Serialize(out, numProcs);
+	Serialize(out, (int)TDomain::dim);
+
+//	the grid hierarchy. The attachment holds the index of each element in the
+//	stream afterwards, which is used to reference elements in the following.
+	AInt aIndex;
+	mg.attach_to_all(aIndex);
+	MultiElementAttachmentAccessor<AInt> aaIndex(mg, aIndex);
+
+	SerializeMultiGridElements(mg, mg.get_grid_objects(), aaIndex, out);
+
+//	positions and subset handlers
+	std::vector<std::string> vSHName = spDomain->additional_subset_handler_names();
+	Serialize(out, vSHName);
+
+	GridDataSerializationHandler handler;
+	handler.add(GeomObjAttachmentSerializer<Vertex, position_attachment_type>::
+				create(mg, spDomain->position_attachment()));
+	handler.add(SubsetHandlerSerializer::create(*spDomain->subset_handler()));
+	for(size_t i = 0; i < vSHName.size(); ++i)
+		handler.add(SubsetHandlerSerializer::create(
+					*spDomain->additional_subset_handler(vSHName[i])));
+
+	handler.write_infos(out);
+	handler.serialize(out, mg.get_grid_objects());
+
+//	the dimensions of the subsets are global information and not restored
+//	from the local grid
+	MGSubsetHandler& sh = *spDomain->subset_handler();
+	Serialize(out, sh.num_subsets());
+	for(int si = 0; si < sh.num_subsets(); ++si)
+		Serialize(out, sh.subset_info(si).get_property("dim").to_int());
+
+//	parallel layouts
+#ifdef UG_PARALLEL
+	SerializeGridLayouts(out, mg.distributed_grid_manager()->grid_layout_map(), aaIndex);
+#else
+	GridLayoutMap glm;
+	SerializeGridLayouts(out, glm, aaIndex);
+#endif
+
+//	grid functions
+	Serialize(out, m_vFunction.size());
+	for(size_t i = 0; i < m_vFunction.size(); ++i)
+	{
+		function_type& u = *m_vFunction[i].second;
+		UG_COND_THROW(u.domain().get() != spDomain.get(), "Checkpoint::write:"
+					  " Grid function '" << m_vFunction[i].first << "' is not"
+					  " defined on the passed domain.");
+
+		Serialize(out, m_vFunction[i].first);
+	#ifdef UG_PARALLEL
+		Serialize(out, (uint)u.get_storage_mask());
+	#else
+		Serialize(out, (uint)0);
+	#endif
+		Serialize(out, u.num_fct());
+		write_values<Vertex>(out, u, aaIndex);
+		write_values<Edge>(out, u, aaIndex);
+		write_values<Face>(out, u, aaIndex);
+		write_values<Volume>(out, u, aaIndex);
+	}
+
+	Serialize(out, (int)CHECKPOINT_MAGIC_END);
+	mg.detach_from_all(aIndex);
+
+	uint32 crc = crc32(out.buffer(), out.write_pos());
+	Serialize(out, crc);
+
+	write_file(out, filename);
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+read(const char* filename, SmartPtr<TDomain> spDomain)
+{
+	PROFILE_FUNC_GROUP("output");
+	UG_COND_THROW(spDomain.invalid(), "Checkpoint::read: Invalid domain.");
+
+	MultiGrid& mg = *spDomain->grid();
+	UG_COND_THROW(mg.num_vertices() != 0, "Checkpoint::read: The grid of the"
+				  " domain has to be empty.");
+
+	clear_read_data();
+	BinaryBuffer& in = m_readBuffer;
+	read_file(in, filename);
+
+//	check integrity
+	UG_COND_THROW(in.write_pos() < sizeof(uint32), "Checkpoint::read: File '"
+				  << filename << "' is corrupt.");
+	size_t size = in.write_pos() - sizeof(uint32);
+	uint32 crc;
+	memcpy(&crc, in.buffer() + size, sizeof(uint32));
+	UG_COND_THROW(crc != crc32(in.buffer(), size), "Checkpoint::read: Checksum"
+				  " mismatch in file '" << filename << "'.");
+
+	UG_COND_THROW(Deserialize<int>(in) != CHECKPOINT_MAGIC_BEGIN,
+				  "Checkpoint::read: '" << filename << "' is no checkpoint file.");
+	int version = Deserialize<int>(in);
+	UG_COND_THROW(version != CHECKPOINT_VERSION, "Checkpoint::read: Unsupported"
+				  " version " << version << " of file '" << filename << "'.");
+	int numProcs = 1;
+#ifdef UG_PARALLEL
+	numProcs = pcl::NumProcs();
+#endif
+	int fileNumProcs = Deserialize<int>(in);
+	UG_COND_THROW(fileNumProcs != numProcs, "Checkpoint::read: File '"
+				  << filename << "' was written by " << fileNumProcs << " processes,"
+				  " but running on " << numProcs << ".");
+	int dim = Deserialize<int>(in);
+	UG_COND_THROW(dim != TDomain::dim, "Checkpoint::read: File '" << filename
+				  << "' contains a domain of dimension " << dim << ".");
+
+	mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STARTS, -1));
+#ifdef UG_PARALLEL
+	DistributedGridManager& distGridMgr = *mg.distributed_grid_manager();
+	distGridMgr.enable_interface_management(false);
+#endif
+
+	DeserializeMultiGridElements(mg, in, &m_vVrt, &m_vEdge, &m_vFace, &m_vVol);
+
+//	positions and subset handlers
+	std::vector<std::string> vSHName;
+	Deserialize(in, vSHName);
+
+	GridDataSerializationHandler handler;
+	handler.add(GeomObjAttachmentSerializer<Vertex, position_attachment_type>::
+				create(mg, spDomain->position_attachment()));
+	handler.add(SubsetHandlerSerializer::create(*spDomain->subset_handler()));
+	for(size_t i = 0; i < vSHName.size(); ++i){
+		spDomain->create_additional_subset_handler(vSHName[i]);
+		handler.add(SubsetHandlerSerializer::create(
+					*spDomain->additional_subset_handler(vSHName[i])));
+	}
+
+	handler.read_infos(in);
+	handler.deserialize(in, m_vVrt.begin(), m_vVrt.end());
+	handler.deserialize(in, m_vEdge.begin(), m_vEdge.end());
+	handler.deserialize(in, m_vFace.begin(), m_vFace.end());
+	handler.deserialize(in, m_vVol.begin(), m_vVol.end());
+
+	MGSubsetHandler& sh = *spDomain->subset_handler();
+	int numSubsets = Deserialize<int>(in);
+	if(numSubsets > 0)
+		sh.subset_required(numSubsets - 1);
+	for(int si = 0; si < numSubsets; ++si)
+		sh.subset_info(si).set_property("dim", Deserialize<int>(in));
+
+//	parallel layouts
+#ifdef UG_PARALLEL
+	DeserializeGridLayouts(in, distGridMgr.grid_layout_map(),
+						   m_vVrt, m_vEdge, m_vFace, m_vVol);
+	distGridMgr.enable_interface_management(true);
+	distGridMgr.grid_layouts_changed(false);
+#else
+	GridLayoutMap glm;
+	DeserializeGridLayouts(in, glm, m_vVrt, m_vEdge, m_vFace, m_vVol);
+#endif
+
+	mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STOPS, -1));
+
+//	remember the positions of the grid functions, they are read in load
+	size_t numFunctions = Deserialize<size_t>(in);
+	for(size_t i = 0; i < numFunctions; ++i)
+	{
+		std::string name = Deserialize<std::string>(in);
+		m_mFunctionPos[name] = in.read_pos();
+
+	//	skip the values
+		Deserialize<uint>(in);
+		Deserialize<size_t>(in);
+		for(int d = 0; d <= 3; ++d){
+			int numElem = Deserialize<int>(in);
+			for(int j = 0; j < numElem; ++j){
+				Deserialize<int>(in);
+				size_t numDoF = Deserialize<size_t>(in);
+				in.set_read_pos(in.read_pos() + numDoF * sizeof(double));
+			}
+		}
+	}
+
+	UG_COND_THROW(Deserialize<int>(in) != CHECKPOINT_MAGIC_END,
+				  "Checkpoint::read: Magic number mismatch at the end of '"
+				  << filename << "'.");
+
+	m_spReadDomain = spDomain;
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+load(SmartPtr<function_type> spGridFct, const char* name)
+{
+	PROFILE_FUNC_GROUP("output");
+	UG_COND_THROW(spGridFct.invalid(), "Checkpoint::load: Invalid grid function.");
+	UG_COND_THROW(m_spReadDomain.invalid(), "Checkpoint::load: No checkpoint"
+				  " has been read.");
+
+	function_type& u = *spGridFct;
+	UG_COND_THROW(u.domain().get() != m_spReadDomain.get(), "Checkpoint::load:"
+				  " Grid function '" << name << "' is not defined on the domain"
+				  " of the checkpoint.");
+
+	std::map<std::string, size_t>::iterator iter = m_mFunctionPos.find(name);
+	UG_COND_THROW(iter == m_mFunctionPos.end(), "Checkpoint::load: No grid"
+				  " function with name '" << name << "' in checkpoint.");
+
+	BinaryBuffer& in = m_readBuffer;
+	in.set_read_pos(iter->second);
+
+	uint storageMask = Deserialize<uint>(in);
+	size_t numFct = Deserialize<size_t>(in);
+	UG_COND_THROW(numFct != u.num_fct(), "Checkpoint::load: Grid function '"
+				  << name << "' has " << numFct << " functions in checkpoint, but"
+				  " " << u.num_fct() << " are requested.");
+
+	u.set(0.0);
+	read_values<Vertex>(in, u, m_vVrt);
+	read_values<Edge>(in, u, m_vEdge);
+	read_values<Face>(in, u, m_vFace);
+	read_values<Volume>(in, u, m_vVol);
+
+#ifdef UG_PARALLEL
+	u.set_storage_type(storageMask);
+#else
+	(void)storageMask;
+#endif
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+write_file(BinaryBuffer& buffer, const char* filename)
+{
+#ifdef UG_PARALLEL
+	if(AsyncOutputEnabled()){
+		std::vector<char> header;
+		size_t myOffset = pcl::PrepareCombinedParallelFile(filename, buffer.write_pos(), header);
+		FileBlockWriteJob* job = new FileBlockWriteJob(filename, false);
+		if(!header.empty())
+			job->add_block(header, 0);
+		job->add_block(buffer.buffer(), buffer.write_pos(), myOffset);
+		PushAsyncOutputJob(job);
+	}
+	else
+		pcl::WriteCombinedParallelFile(buffer, filename);
+#else
+//	same layout as the combined parallel file of the restart bridge
+	int numProcs = 1;
+	int myNextOffset = 2*sizeof(int) + buffer.write_pos();
+	std::vector<char> header(2*sizeof(int));
+	memcpy(&header[0], &numProcs, sizeof(int));
+	memcpy(&header[sizeof(int)], &myNextOffset, sizeof(int));
+
+	FileBlockWriteJob* job = new FileBlockWriteJob(filename, true);
+	job->add_block(header, 0);
+	job->add_block(buffer.buffer(), buffer.write_pos(), 2*sizeof(int));
+	if(AsyncOutputEnabled())
+		PushAsyncOutputJob(job);
+	else{
+		try{job->run();}
+		UG_CATCH_THROW("Checkpoint::write: Could not write '" << filename << "'.");
+		delete job;
+	}
+#endif
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+read_file(BinaryBuffer& buffer, const char* filename)
+{
+//	the file may still be written by the output thread
+	FlushAsyncOutput();
+
+#ifdef UG_PARALLEL
+	pcl::ReadCombinedParallelFile(buffer, filename);
+#else
+	FILE* f = fopen(filename, "rb");
+	UG_COND_THROW(f == NULL, "Checkpoint::read: Could not open '" << filename << "'.");
+
+	int numProcs = 0, myNextOffset = 0;
+	bool ok = fread(&numProcs, sizeof(int), 1, f) == 1
+			  && fread(&myNextOffset, sizeof(int), 1, f) == 1;
+	if(!ok || numProcs != 1){
+		fclose(f);
+		UG_THROW("Checkpoint::read: File '" << filename << "' was written by "
+				 << numProcs << " processes, but running on 1.");
+	}
+
+	size_t mySize = myNextOffset - 2*sizeof(int);
+	std::vector<char> data(mySize);
+	ok = mySize == 0 || fread(&data[0], sizeof(char), mySize, f) == mySize;
+	fclose(f);
+	UG_COND_THROW(!ok, "Checkpoint::read: Could not read '" << filename << "'.");
+
+	buffer.clear();
+	buffer.reserve(mySize);
+	if(mySize > 0)
+		buffer.write(&data[0], mySize);
+#endif
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__IO__CHECKPOINT_IMPL__ */
@@ -35,6 +35,14 @@
 #include "common/util/os_info.h"  // for GetPathSeparator
 
 #include <sstream>
+#include <fstream>
+#include <iomanip>
+
+#include "common/util/async_output.h"
+
+#ifdef UG_PARALLEL
+#include "pcl/parallel_file.h"
+#endif
 
 namespace ug{
 
@@ -158,7 +166,10 @@ write_empty_grid_piece(VTKFileWriter& File, bool binary)
 	File << "\n        </DataArray>\n";
 	File << "        <DataArray type=\"Int32\" Name=\"offsets\" format="
 		 <<	(binary ? "\"binary\"" : "\"ascii\"") << ">\n";
-	File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
+	if(binary)
+		File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
+	else
+		File << n;
 	File << "\n        </DataArray>\n";
 	File << "        <DataArray type=\"Int8\" Name=\"types\" format="
 		 <<	(binary ? "\"binary\"" : "\"ascii\"") << ">\n";
@@ -171,6 +182,125 @@ write_empty_grid_piece(VTKFileWriter& File, bool binary)
 	File << "    </Piece>\n";
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Buffered Output
+////////////////////////////////////////////////////////////////////////////////
+
+/// placeholder for the offset of a DataArray in the appended data (fixed width)
+static const char* s_vtkOffsetPlaceholder = "@@@@@@@@@@@@@@@@@@@@";
+static const size_t s_vtkOffsetWidth = 20;
+
+template <int TDim>
+std::string VTKOutput<TDim>::
+data_format(VTKFileWriter& File) const
+{
+	if(File.raw_appended())
+		return std::string("\"appended\" offset=\"") + s_vtkOffsetPlaceholder + "\"";
+	return m_bBinary ? "\"binary\"" : "\"ascii\"";
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+write_buffered_file(const std::string& name, const std::string& header,
+                    VTKFileWriter& File, bool bSingleFile)
+{
+	PROFILE_FUNC();
+
+	std::string piece = File.buffer_content();
+	const std::vector<char>& vData = File.appended_data();
+	const std::vector<size_t>& vBlockOffset = File.appended_block_offsets();
+	const bool bAppended = File.raw_appended();
+
+	bool bParallel = false;
+#ifdef UG_PARALLEL
+	bParallel = bSingleFile && pcl::NumProcs() > 1;
+#endif
+
+//	offset of the appended data of this process
+	size_t base = 0;
+#ifdef UG_PARALLEL
+	if(bParallel && bAppended)
+		base = pcl::ParallelFileOffset(vData.size());
+#endif
+
+//	replace the offset placeholders by the offsets of the data arrays. The
+//	placeholders have fixed width, so that the size of the piece is unchanged
+	size_t numReplaced = 0;
+	for(size_t pos = piece.find(s_vtkOffsetPlaceholder); pos != std::string::npos;
+		pos = piece.find(s_vtkOffsetPlaceholder, pos + s_vtkOffsetWidth))
+	{
+		if(numReplaced >= vBlockOffset.size())
+			UG_THROW("VTK::write_buffered_file: More DataArrays than appended data blocks.");
+
+		std::stringstream ss;
+		ss << std::setw(s_vtkOffsetWidth) << std::setfill('0')
+		   << base + vBlockOffset[numReplaced++];
+		piece.replace(pos, s_vtkOffsetWidth, ss.str());
+	}
+	if(numReplaced != vBlockOffset.size())
+		UG_THROW("VTK::write_buffered_file: Number of DataArrays ("<<numReplaced<<
+		         ") does not match number of appended data blocks ("
+		         <<vBlockOffset.size()<<").");
+
+//	glue parts written once, enclosing the sections of all processes
+	std::vector<std::string> vGlue;
+	vGlue.push_back(header);
+	if(bAppended){
+		vGlue.push_back("  </UnstructuredGrid>\n  <AppendedData encoding=\"raw\">\n   _");
+		vGlue.push_back("\n  </AppendedData>\n</VTKFile>\n");
+	}
+	else
+		vGlue.push_back("  </UnstructuredGrid>\n</VTKFile>\n");
+
+	std::vector<std::pair<const char*, size_t> > vSection;
+	vSection.push_back(std::make_pair(piece.c_str(), piece.size()));
+	if(bAppended)
+		vSection.push_back(std::make_pair(vData.empty() ? NULL : &vData[0], vData.size()));
+
+#ifdef UG_PARALLEL
+	if(bParallel)
+	{
+	//	all processes write collectively using MPI-IO
+		if(!AsyncOutputEnabled()){
+			pcl::WriteSectionedParallelFile(name, vGlue, vSection);
+			return;
+		}
+
+	//	the first process creates the file once no pending output of any
+	//	process writes to it anymore
+		const bool bFirst = (pcl::ProcRank() == 0);
+		pcl::CreateEmptyParallelFile(name);
+
+		std::vector<size_t> vGlueSize, vSectionSize, vGlueOffset, vSectionOffset;
+		for(size_t i = 0; i < vGlue.size(); ++i) vGlueSize.push_back(vGlue[i].size());
+		for(size_t i = 0; i < vSection.size(); ++i) vSectionSize.push_back(vSection[i].second);
+		pcl::SectionedParallelFileLayout(vGlueSize, vSectionSize, vGlueOffset, vSectionOffset);
+
+		FileBlockWriteJob* job = new FileBlockWriteJob(name, false);
+		for(size_t i = 0; i < vGlue.size(); ++i){
+			if(bFirst) job->add_block(vGlue[i], vGlueOffset[i]);
+			if(i < vSection.size())
+				job->add_block(vSection[i].first, vSection[i].second, vSectionOffset[i]);
+		}
+		PushAsyncOutputJob(job);
+		return;
+	}
+#endif
+
+//	only this process writes to the file (possibly asynchronously)
+	FileBlockWriteJob* job = new FileBlockWriteJob(name, true);
+	size_t offset = 0;
+	for(size_t i = 0; i < vGlue.size(); ++i){
+		job->add_block(vGlue[i], offset);
+		offset += vGlue[i].size();
+		if(i < vSection.size()){
+			job->add_block(vSection[i].first, vSection[i].second, offset);
+			offset += vSection[i].second;
+		}
+	}
+	PushAsyncOutputJob(job);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // FileNames
 ////////////////////////////////////////////////////////////////////////////////
@@ -245,6 +375,27 @@ pvtu_filename(std::string& nameOut, std::string nameIn,
 }
 
 
+template <int TDim>
+void VTKOutput<TDim>::
+single_vtu_filename(std::string& nameOut, std::string nameIn,
+                    int si, int maxSi, int step)
+{
+// remove extension of file if necessary
+	baseName(nameOut, nameIn);
+
+// 	subset index
+	if(si >= 0)
+		AppendCounterToString(nameOut, "_s", si, maxSi);
+
+// 	time index
+	if(step >= 0)
+		AppendCounterToString(nameOut, "_t", (int) step);
+
+// 	add file extension
+	nameOut.append(".vtu");
+}
+
+
 template <int TDim>
 void VTKOutput<TDim>::
 pvd_filename(std::string& nameOut, std::string nameIn)
@@ -274,7 +425,8 @@ pvd_time_filename(std::string& nameOut, std::string nameIn, int step)
 
 template <int TDim>
 void VTKOutput<TDim>::
-write_subset_pvd(int numSubset, const std::string& filename, int step, number time)
+write_subset_pvd(int numSubset, const std::string& filename, int step, number time,
+                 bool singleFile)
 {
 //	file pointer
 	FILE* file;
@@ -317,7 +469,8 @@ write_subset_pvd(int numSubset, const std::string& filename, int step, number ti
 		for(int si = 0; si < numSubset; ++si)
 		{
 			vtu_filename(name, filename, rank, si, numSubset-1, step);
-			if(numProcs > 1) pvtu_filename(name, filename, si, numSubset-1, step);
+			if(singleFile) single_vtu_filename(name, filename, si, numSubset-1, step);
+			else if(numProcs > 1) pvtu_filename(name, filename, si, numSubset-1, step);
 
 			name = FilenameWithoutPath(name);
 			fprintf(file, "  <DataSet timestep=\"%.17g\" part=\"%d\" file=\"%s\"/>\n",
@@ -330,7 +483,7 @@ write_subset_pvd(int numSubset, const std::string& filename, int step, number ti
 		fclose(file);
 	}
 
-	if (isOutputProc && numProcs > 1)
+	if (isOutputProc && numProcs > 1 && !singleFile)
 	{
 		std::string procName(filename);
 		procName.append("_processwise");
@@ -614,6 +767,12 @@ set_write_proc_ranks(bool b) {
 	m_bWriteProcRanks = b;
 }
 
+template <int TDim>
+void VTKOutput<TDim>::
+set_single_file(bool b) {
+	m_bSingleFile = b;
+}
+
 template <int TDim>
 void VTKOutput<TDim>::
 set_user_defined_comment(const char* comment){
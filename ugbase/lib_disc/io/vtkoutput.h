@@ -968,10 +968,38 @@ protected:
 		void write_pvtu(TFunction& u, const std::string&  filename,
 		                int si, int step, number time);
 
+	///	writes the subset using an in-memory staging buffer
+	/**
+	 * The piece of the grid is first written to memory. In binary mode, the
+	 * data is stored unencoded in the <AppendedData> section.
+	 *
+	 * If single file output is enabled, each process writes its part of the
+	 * grid as a separate <Piece> of one common *.vtu file. The file is written
+	 * collectively using MPI-IO. Otherwise, each process writes its own *.vtu
+	 * file. If asynchronous output is enabled (SetAsyncOutput), the file is
+	 * written by the output thread.
+	 */
+		template <typename TFunction>
+		void print_subset_buffered(const char* filename, TFunction& u,
+		                           int si, int step, number time);
+
+	///	writes the xml header, the piece and the appended data (of all processes)
+		static void write_buffered_file(const std::string& name,
+		                                const std::string& header,
+		                                VTKFileWriter& File, bool bSingleFile);
+
+	///	returns the format attribute of a DataArray
+		std::string data_format(VTKFileWriter& File) const;
+
 	public:
 	///	writes a grouping *.pvd file, grouping all data from different subsets
 		static void write_subset_pvd(int numSubset, const std::string&  filename,
-		                             int step = -1, number time = 0.0);
+		                             int step = -1, number time = 0.0,
+		                             bool singleFile = false);
+
+	///	creates the needed vtu file name, if all processes write to one file
+		static void single_vtu_filename(std::string& nameOut, std::string nameIn,
+		                                int si, int maxSi, int step);
 
 	///	creates the needed vtu file name
 		static void vtu_filename(std::string& nameOut, std::string nameIn,
@@ -990,7 +1018,7 @@ protected:
 
 	public:
 	///	default constructor
-		VTKOutput()	: m_bSelectAll(true), m_bBinary(true), m_bWriteGrid(true), m_bWriteSubsetIndices(false), m_bWriteProcRanks(false) {} //TODO: maybe true?
+		VTKOutput()	: m_bSelectAll(true), m_bBinary(true), m_bWriteGrid(true), m_bWriteSubsetIndices(false), m_bWriteProcRanks(false), m_bSingleFile(false) {} //TODO: maybe true?
 
 	/// should values be printed in binary (base64 encoded way ) or plain ascii
 		void set_binary(bool b);
@@ -1001,6 +1029,9 @@ protected:
 
 		void set_write_proc_ranks(bool b);
 
+	/// if true, all processes write to one *.vtu file (no *.pvtu grouping)
+		void set_single_file(bool b);
+
 	protected:
 	///	returns true if name for vtk-component is already used
 		bool vtk_name_used(const char* name) const;
@@ -1057,6 +1088,9 @@ protected:
 
 		bool m_bWriteSubsetIndices;
 		bool m_bWriteProcRanks;
+
+	///	write all processes to one file
+		bool m_bSingleFile;
 };
 
 } // namespace ug
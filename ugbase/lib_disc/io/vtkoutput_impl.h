@@ -43,6 +43,7 @@
 #include "common/util/endian_detection.h"
 #include "common/profiler/profiler.h"
 #include "common/util/provider.h"
+#include "common/util/async_output.h"
 #include "lib_disc/common/function_group.h"
 #include "lib_disc/common/groups_util.h"
 #include "lib_disc/common/multi_index.h"
@@ -174,7 +175,7 @@ print(const char* filename, TFunction& u, int step, number time, bool makeConsis
 
 		//	write grouping pvd file
 		try{
-			write_subset_pvd(u.num_subsets(), filename, step, time);
+			write_subset_pvd(u.num_subsets(), filename, step, time, m_bSingleFile);
 		}
 		UG_CATCH_THROW("VTK::print: Can not write pvd file.");
 	}
@@ -197,6 +198,16 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 			UG_THROW("VTK::print_subset: Cannot change storage type to consistent.");
 #endif
 
+//	all processes write to one file or the file is written asynchronously
+	if(m_bSingleFile || AsyncOutputEnabled())
+	{
+		try{
+			print_subset_buffered(filename, u, si, step, time);
+		}
+		UG_CATCH_THROW("VTK::print_subset: Can not write vtu - file.");
+		return;
+	}
+
 //	get the grid associated to the solution
 	Grid& grid = *u.domain()->grid();
 
@@ -316,6 +327,127 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 }
 
 
+template <int TDim>
+template <typename TFunction>
+void VTKOutput<TDim>::
+print_subset_buffered(const char* filename, TFunction& u, int si, int step, number time)
+{
+	PROFILE_FUNC();
+
+//	get the grid associated to the solution
+	Grid& grid = *u.domain()->grid();
+
+// 	attach help indices
+	typedef ug::Attachment<int> AVrtIndex;
+	AVrtIndex aVrtIndex;
+	Grid::VertexAttachmentAccessor<AVrtIndex> aaVrtIndex;
+	grid.attach_to_vertices(aVrtIndex);
+	aaVrtIndex.access(grid, aVrtIndex);
+
+//	get name for the (common) *.vtu file
+	std::string name;
+	if(m_bSingleFile)
+		single_vtu_filename(name, filename, si, u.num_subsets()-1, step);
+	else
+	{
+		int rank = 0;
+	#ifdef UG_PARALLEL
+		rank = pcl::ProcRank();
+	#endif
+		vtu_filename(name, filename, rank, si, u.num_subsets()-1, step);
+	}
+
+//	bool if time point should be written to *.vtu file
+//	for separate files in parallel, it is written to the *.pvtu
+	bool bTimeDep = (step >= 0);
+#ifdef UG_PARALLEL
+	if(!m_bSingleFile && pcl::NumProcs() > 1) bTimeDep = false;
+#endif
+
+//	header, equal on all processes
+	VTKFileWriter Header;
+	Header.open_buffer();
+	Header << VTKFileWriter::normal;
+	Header << "<?xml version=\"1.0\"?>\n";
+
+	write_comment(Header);
+
+	Header << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"";
+	if(IsLittleEndian()) Header << "LittleEndian";
+	else Header << "BigEndian";
+	Header << "\">\n";
+
+//	writing time point
+	if(bTimeDep)
+		Header << "  <Time timestep=\""<<time<<"\"/>\n";
+
+	Header << "  <UnstructuredGrid>\n";
+
+//	the piece of this process is written to memory, binary data is collected
+//	in the appended data block
+	VTKFileWriter File;
+	File.open_buffer();
+	File.set_raw_appended(m_bBinary);
+
+// 	get dimension of grid-piece
+	int dim = -1;
+	if(si >= 0) dim = DimensionOfSubset(*u.domain()->subset_handler(), si);
+	else dim = DimensionOfSubsets(*u.domain()->subset_handler());
+
+//	write piece of grid
+	if(dim >= 0)
+	{
+		try{
+			write_grid_solution_piece(File, aaVrtIndex, grid, u, time, si, dim);
+		}
+		UG_CATCH_THROW("VTK::print_subset_buffered: Can not write Subset: "<<si);
+	}
+	else
+	{
+	//	if dim < 0, some is wrong with grid, except no element is in the grid
+		if( ((si < 0) && grid.num<Vertex>() != 0) ||
+			((si >=0) && u.domain()->subset_handler()->template num<Vertex>(si) != 0))
+		{
+			UG_THROW("VTK::print_subset_buffered: Dimension of grid/subset not"
+					" detected correctly although grid objects present.");
+		}
+
+		write_empty_grid_piece(File, false);
+	}
+	File << VTKFileWriter::normal;
+
+// 	detach help indices
+	grid.detach_from_vertices(aVrtIndex);
+
+//	write header, pieces and appended data (of all processes)
+	write_buffered_file(name, Header.buffer_content(), File, m_bSingleFile);
+
+#ifdef UG_PARALLEL
+//	write grouping *.pvtu file in parallel case
+	if(!m_bSingleFile)
+	{
+		try{
+			write_pvtu(u, filename, si, step, time);
+		}
+		UG_CATCH_THROW("VTK::print_subset_buffered: Can not write pvtu - file.");
+	}
+#endif
+
+//	remember time step
+	if(step >= 0)
+	{
+	//	get vector of time points for the name
+		std::vector<number>& vTimestep = m_mTimestep[filename];
+
+	//	resize the vector
+		vTimestep.resize(step+1);
+
+	//	write time point
+		vTimestep[step] = time;
+	}
+}
+
+
 template <int TDim>
 template <typename TFunction>
 void VTKOutput<TDim>::
@@ -844,7 +976,7 @@ write_points(VTKFileWriter& File,
 	File << VTKFileWriter::normal;
 	File << "      <Points>\n";
 	File << "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" format="
-		 <<	(m_bBinary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 	int n = 3*sizeof(float) * numVert;
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << n;
@@ -901,7 +1033,7 @@ write_points(VTKFileWriter& File,
 	File << VTKFileWriter::normal;
 	File << "      <Points>\n";
 	File << "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" format="
-		 <<	(m_bBinary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 	int n = 3*sizeof(float) * numVert;
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << n;
@@ -1127,7 +1259,7 @@ write_cell_connectivity(VTKFileWriter& File,
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that connections will be written
 	File << "        <DataArray type=\"Int32\" Name=\"connectivity\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 	int n = sizeof(int) * numConn;
 
 	if(m_bBinary)
@@ -1169,7 +1301,7 @@ write_cell_connectivity(VTKFileWriter& File,
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that connections will be written
 	File << "        <DataArray type=\"Int32\" Name=\"connectivity\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 	int n = sizeof(int) * numConn;
 
 	if(m_bBinary)
@@ -1270,7 +1402,7 @@ write_cell_offsets(VTKFileWriter& File, const T& iterContainer, int si, int dim,
 	File << VTKFileWriter::normal;
 //	write opening tag indicating that offsets are going to be written
 	File << "        <DataArray type=\"Int32\" Name=\"offsets\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 	int n = sizeof(int) * numElem;
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << n;
@@ -1311,7 +1443,7 @@ write_cell_offsets(VTKFileWriter& File, const T& iterContainer, SubsetGroup& ssG
 	File << VTKFileWriter::normal;
 //	write opening tag indicating that offsets are going to be written
 	File << "        <DataArray type=\"Int32\" Name=\"offsets\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 	int n = sizeof(int) * numElem;
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << n;
@@ -1423,7 +1555,7 @@ write_cell_types(VTKFileWriter& File, const T& iterContainer, int si, int dim,
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that types will be written
 	File << "        <DataArray type=\"Int8\" Name=\"types\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << numElem;
 
@@ -1463,7 +1595,7 @@ write_cell_types(VTKFileWriter& File, const T& iterContainer, SubsetGroup& ssGrp
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that types will be written
 	File << "        <DataArray type=\"Int8\" Name=\"types\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << numElem;
 
@@ -1542,7 +1674,7 @@ write_cell_subsets(VTKFileWriter& File, const T& iterContainer, int si, int dim,
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that types will be written
 	File << "        <DataArray type=\"Int8\" Name=\"regions\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << numElem;
 
@@ -1582,7 +1714,7 @@ write_cell_subsets(VTKFileWriter& File, const T& iterContainer, SubsetGroup& ssG
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that types will be written
 	File << "        <DataArray type=\"Int8\" Name=\"regions\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << numElem;
 
@@ -1663,7 +1795,7 @@ write_cell_proc_ranks(VTKFileWriter& File, const T& iterContainer, int si, int d
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that types will be written
 	File << "        <DataArray type=\"Int8\" Name=\"proc_ranks\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << numElem;
 
@@ -1703,7 +1835,7 @@ write_cell_proc_ranks(VTKFileWriter& File, const T& iterContainer, SubsetGroup&
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that types will be written
 	File << "        <DataArray type=\"Int8\" Name=\"proc_ranks\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << numElem;
 
@@ -1853,7 +1985,7 @@ write_nodal_data(VTKFileWriter& File, TFunction& u, number time,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<numCmp<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 
 	int n = sizeof(float) * numVert * numCmp;
 	if(m_bBinary)
@@ -1908,7 +2040,7 @@ write_nodal_data(VTKFileWriter& File, TFunction& u, number time,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<numCmp<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 
 	int n = sizeof(float) * numVert * numCmp;
 	if(m_bBinary)
@@ -2028,7 +2160,7 @@ write_nodal_values(VTKFileWriter& File, TFunction& u,
 //	write opening tag
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<(vFct.size() == 1 ? 1 : 3)<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 
 	int n = sizeof(float) * numVert * (vFct.size() == 1 ? 1 : 3);
 	if(m_bBinary)
@@ -2075,7 +2207,7 @@ write_nodal_values(VTKFileWriter& File, TFunction& u,
 //	write opening tag
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<(vFct.size() == 1 ? 1 : 3)<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 
 	int n = sizeof(float) * numVert * (vFct.size() == 1 ? 1 : 3);
 	if(m_bBinary)
@@ -2427,7 +2559,7 @@ write_cell_data(VTKFileWriter& File, TFunction& u, number time,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<numCmp<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 
 	int n = sizeof(float) * numElem * numCmp;
 	if(m_bBinary)
@@ -2471,7 +2603,7 @@ write_cell_data(VTKFileWriter& File, TFunction& u, number time,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<numCmp<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 
 	int n = sizeof(float) * numElem * numCmp;
 	if(m_bBinary)
@@ -2610,7 +2742,7 @@ write_cell_values(VTKFileWriter& File, TFunction& u,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<(vFct.size() == 1 ? 1 : 3)<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 
 	int n = sizeof(float) * numElem * (vFct.size() == 1 ? 1 : 3);
 	if(m_bBinary)
@@ -2650,7 +2782,7 @@ write_cell_values(VTKFileWriter& File, TFunction& u,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<(vFct.size() == 1 ? 1 : 3)<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_format(File) << ">\n";
 
 	int n = sizeof(float) * numElem * (vFct.size() == 1 ? 1 : 3);
 	if(m_bBinary)
@@ -3131,7 +3263,8 @@ write_time_pvd(const char* filename, TFunction& u)
 			for(int step = 0; step < (int)vTimestep.size(); ++step)
 			{
 				vtu_filename(name, filename, 0, -1, 0, step);
-				if(numProcs > 1) pvtu_filename(name, filename, -1, 0, step);
+				if(m_bSingleFile) single_vtu_filename(name, filename, -1, 0, step);
+				else if(numProcs > 1) pvtu_filename(name, filename, -1, 0, step);
 
 				name = FilenameWithoutPath(name);
 				fprintf(file, "  <DataSet timestep=\"%.17g\" part=\"%d\" file=\"%s\"/>\n",
@@ -3144,7 +3277,8 @@ write_time_pvd(const char* filename, TFunction& u)
 				for(int si = 0; si < u.num_subsets(); ++si)
 				{
 					vtu_filename(name, filename, 0, si, u.num_subsets()-1, step);
-					if(numProcs > 1) pvtu_filename(name, filename, si, u.num_subsets()-1, step);
+					if(m_bSingleFile) single_vtu_filename(name, filename, si, u.num_subsets()-1, step);
+					else if(numProcs > 1) pvtu_filename(name, filename, si, u.num_subsets()-1, step);
 
 					name = FilenameWithoutPath(name);
 					fprintf(file, "  <DataSet timestep=\"%.17g\" part=\"%d\" file=\"%s\"/>\n",
@@ -3290,7 +3424,8 @@ write_time_pvd_subset(const char* filename, TFunction& u, int si)
 		for(int step = 0; step < (int)vTimestep.size(); ++step)
 		{
 			vtu_filename(name, filename, 0, si, u.num_subsets()-1, step);
-			if(numProcs > 1) pvtu_filename(name, filename, si, u.num_subsets()-1, step);
+			if(m_bSingleFile) single_vtu_filename(name, filename, si, u.num_subsets()-1, step);
+			else if(numProcs > 1) pvtu_filename(name, filename, si, u.num_subsets()-1, step);
 
 			name = FilenameWithoutPath(name);
 			fprintf(file, "  <DataSet timestep=\"%g\" part=\"%d\" file=\"%s\"/>\n",
@@ -104,7 +104,7 @@ void
 AssembledLinearOperator<TAlgebra>::apply(vector_type& d, const vector_type& c)
 {
 #ifdef UG_PARALLEL
-	if(!c.has_storage_type(PST_CONSISTENT))
+	if(!c.has_storage_type(PST_CONSISTENT) && !this->makes_domain_consistent())
 		UG_THROW("Inadequate storage format of Vector c.");
 #endif
 
@@ -127,7 +127,7 @@ AssembledLinearOperator<TAlgebra>::apply_sub(vector_type& d, const vector_type&
 #ifdef UG_PARALLEL
 	if(!d.has_storage_type(PST_ADDITIVE))
 		UG_THROW("Inadequate storage format of Vector d.");
-	if(!c.has_storage_type(PST_CONSISTENT))
+	if(!c.has_storage_type(PST_CONSISTENT) && !this->makes_domain_consistent())
 		UG_THROW("Inadequate storage format of Vector c.");
 #endif
 
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE__MATRIX_FREE_JACOBI__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE__MATRIX_FREE_JACOBI__
+
+#include "lib_algebra/operator/interface/linear_iterator.h"
+#include "matrix_free_operator.h"
+
+namespace ug{
+
+///	Jacobi iteration for the MatrixFreeOperator
+/**
+ * This iteration computes the correction c = d / diag(A), where the diagonal
+ * is provided by the MatrixFreeOperator without assembling the matrix.
+ * The defect update in apply_update_defect applies the operator matrix-free.
+ * Use set_damp to set a damping (e.g. 2/3 when used as smoother).
+ *
+ * \tparam	TDomain		domain type
+ * \tparam	TAlgebra	algebra type
+ */
+template <typename TDomain, typename TAlgebra>
+class MatrixFreeJacobi : public ILinearIterator<typename TAlgebra::vector_type>
+{
+	public:
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	matrix-free operator type
+		typedef MatrixFreeOperator<TDomain, TAlgebra> operator_type;
+
+	///	Base type
+		typedef ILinearIterator<vector_type> base_type;
+
+	protected:
+		using base_type::damping;
+
+	public:
+	///	constructor
+		MatrixFreeJacobi() {}
+
+	///	constructor setting damping
+		MatrixFreeJacobi(number damp) {this->set_damp(damp);}
+
+	///	copy constructor
+		MatrixFreeJacobi(const MatrixFreeJacobi<TDomain, TAlgebra>& parent)
+			: base_type(parent), m_spOperator(parent.m_spOperator) {}
+
+	///	returns the name
+		virtual const char* name() const {return "MatrixFreeJacobi";}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const {return true;}
+
+	///	initialize for operator J(u) and linearization point u
+		virtual bool init(SmartPtr<ILinearOperator<vector_type> > J, const vector_type& u)
+		{
+			return init(J);
+		}
+
+	///	initialize for linear operator L
+		virtual bool init(SmartPtr<ILinearOperator<vector_type> > L)
+		{
+			m_spOperator = L.template cast_dynamic<operator_type>();
+			if(m_spOperator.invalid())
+				UG_THROW(name() << "::init: Operator must be a MatrixFreeOperator.");
+
+			if(!m_spOperator->initialized()) m_spOperator->init();
+			return true;
+		}
+
+	///	compute new correction c = B*d
+		virtual bool apply(vector_type& c, const vector_type& d)
+		{
+			if(m_spOperator.invalid())
+				UG_THROW(name() << "::apply: Iterator not initialized.");
+
+			#ifdef UG_PARALLEL
+			if(!d.has_storage_type(PST_ADDITIVE))
+				UG_THROW(name() << "::apply: Wrong parallel "
+				               "storage format. Defect must be additive.");
+			#endif
+
+			const vector_type& diag = m_spOperator->diagonal();
+			THROW_IF_NOT_EQUAL_3(c.size(), d.size(), diag.size());
+
+		//	additive defect and consistent diagonal give an additive correction
+			for(size_t i = 0; i < c.size(); ++i)
+				c[i] = d[i] / diag[i];
+
+			#ifdef UG_PARALLEL
+			c.set_storage_type(PST_ADDITIVE);
+			#endif
+
+			const number kappa = damping()->damping(c, d, m_spOperator);
+			if(kappa != 1.0) c *= kappa;
+
+			#ifdef UG_PARALLEL
+			if(!c.change_storage_type(PST_CONSISTENT))
+				UG_THROW(name() << "::apply: Cannot change "
+						"parallel storage type of correction to consistent.");
+			#endif
+
+			return true;
+		}
+
+	///	compute new correction c = B*d and update defect d := d - A*c
+		virtual bool apply_update_defect(vector_type& c, vector_type& d)
+		{
+			if(!apply(c, d)) return false;
+			m_spOperator->apply_sub(d, c);
+			return true;
+		}
+
+	///	clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new MatrixFreeJacobi<TDomain, TAlgebra>(*this));
+		}
+
+	protected:
+	///	underlying operator
+		SmartPtr<operator_type> m_spOperator;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE__MATRIX_FREE_JACOBI__ */
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE__MATRIX_FREE_OPERATOR__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE__MATRIX_FREE_OPERATOR__
+
+#include <vector>
+#include <string>
+
+#include "common/common.h"
+#include "common/static_assert.h"
+#include "lib_algebra/operator/interface/linear_operator.h"
+#include "lib_disc/function_spaces/approximation_space.h"
+
+namespace ug{
+
+///	matrix-free operator for P1/Q1 convection-diffusion-reaction problems
+/**
+ * This operator applies the stiffness matrix of the scalar problem
+ *
+ * 		- div(D grad u) + v * grad u + r u = f
+ *
+ * with constant coefficients D, v and r, discretized by conforming P1
+ * (edges, triangles, tetrahedra) or Q1 (quadrilaterals, hexahedra) Lagrange
+ * elements, without assembling it. In init() the geometry of every element
+ * is evaluated once and cached in a compact form: the shape function
+ * gradients and the volume for simplices, and for the (multi-)linear
+ * elements the coefficient-weighted metric terms in the 2^dim Gauss points.
+ * The application is then an element-by-element gather/compute/scatter.
+ *
+ * The elements are stored in batches of BATCH elements of the same shape,
+ * with the cached data laid out as "structure of arrays", so that the inner
+ * loops run over the elements of a batch and can be vectorized by the
+ * compiler. The elements are colored (no two elements of one color share a
+ * DoF), so that the batches of one color can be processed by several threads
+ * (see SetNumThreads) without write conflicts.
+ *
+ * Rows of the Dirichlet DoFs (see add_dirichlet_boundary) are replaced by
+ * the identity, as done by the assembled Jacobian of the DirichletBoundary.
+ * The diagonal of the operator is available without assembling the matrix
+ * and can be used by point smoothers (see MatrixFreeJacobi).
+ *
+ * In parallel, the operator maps consistent vectors to additive vectors,
+ * as the assembled ParallelMatrix does.
+ *
+ * \tparam	TDomain		domain type
+ * \tparam	TAlgebra	algebra type (scalar, i.e. blockSize 1)
+ */
+template <typename TDomain, typename TAlgebra>
+class MatrixFreeOperator
+	: public virtual ILinearOperator<typename TAlgebra::vector_type>
+{
+	public:
+	///	Domain type
+		typedef TDomain domain_type;
+
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	world dimension
+		static const int dim = TDomain::dim;
+
+	///	number of elements processed together
+		static const int BATCH = 4;
+
+	public:
+	///	constructor
+		MatrixFreeOperator(SmartPtr<ApproximationSpace<TDomain> > spApproxSpace,
+		                   const char* fct);
+
+	///	sets the grid level the operator works on (default: surface)
+		void set_level(const GridLevel& gl) {m_gridLevel = gl; m_bInit = false;}
+
+	///	sets the diffusion coefficient
+		void set_diffusion(number D) {m_diffusion = D; m_bInit = false;}
+
+	///	sets the velocity field
+		void set_velocity(const std::vector<number>& vVel);
+
+	///	sets the reaction coefficient
+		void set_reaction(number r) {m_reaction = r; m_bInit = false;}
+
+	///	adds subsets where Dirichlet values are prescribed
+		void add_dirichlet_boundary(const char* subsets);
+
+	///	returns if the operator has been initialized
+		bool initialized() const {return m_bInit;}
+
+	///	returns the DoF distribution the operator works on
+		ConstSmartPtr<DoFDistribution> dof_distribution() const {return m_spDD;}
+
+	///	returns the diagonal of the operator (consistent)
+		const vector_type& diagonal() const {return m_diag;}
+
+	///	returns the number of elements
+		size_t num_elements() const;
+
+	///	returns the number of element colors
+		size_t num_colors() const;
+
+	public:
+	///	caches the element geometry and computes the diagonal
+		virtual void init();
+
+	///	caches the element geometry (the operator is linear, u is ignored)
+		virtual void init(const vector_type& u) {init();}
+
+	///	computes f = A*u
+		virtual void apply(vector_type& f, const vector_type& u);
+
+	///	computes f -= A*u
+		virtual void apply_sub(vector_type& f, const vector_type& u);
+
+	protected:
+	///	cached data of all elements of one shape
+		struct ElemBatches
+		{
+			ElemBatches() : numCo(0), numData(0), numElem(0), bColored(true) {}
+
+		///	returns the number of batches
+			size_t num_batches() const
+				{return numCo == 0 ? 0 : vInd.size() / (numCo * BATCH);}
+
+		///	corners (DoFs) per element
+			size_t numCo;
+
+		///	cached numbers per element
+			size_t numData;
+
+		///	DoF indices, stored as [batch][corner][lane]
+			std::vector<size_t> vInd;
+
+		///	cached data, stored as [batch][data][lane]
+			std::vector<number> vData;
+
+		///	first batch of each color (plus end of last color)
+			std::vector<size_t> vColorBatch;
+
+		///	number of elements (without padding)
+			size_t numElem;
+
+		///	flag if the elements could be colored (else processed serially)
+			bool bColored;
+		};
+
+	///	computes f += s*A*u
+		void apply_add(vector_type& f, const vector_type& u, number s);
+
+	///	collects the elements of one shape and builds the batches
+		template <int TNumCo>
+		void collect_elements(ElemBatches& batches, ReferenceObjectID roid,
+		                      bool bSimplex);
+
+	///	computes the cached data of an element
+	/// \{
+		void simplex_data(number* vData, const MathVector<dim>* vCo) const;
+		void q1_data(number* vData, const MathVector<dim>* vCo) const;
+	/// \}
+
+	///	applies the element operators of all batches in [bBegin, bEnd)
+	/// \{
+		template <int TNumCo>
+		void apply_simplex(const ElemBatches& batches, size_t bBegin, size_t bEnd,
+		                   number* f, const number* u, number s) const;
+		template <int TNumCo>
+		void apply_q1(const ElemBatches& batches, size_t bBegin, size_t bEnd,
+		              number* f, const number* u, number s) const;
+	/// \}
+
+	///	applies all batches of the elements of one shape
+		template <int TNumCo>
+		void apply_batches(const ElemBatches& batches, bool bSimplex,
+		                   number* f, const number* u, number s) const;
+
+	///	adds the diagonal of the element operators to the diagonal
+		template <int TNumCo>
+		void add_diagonal(const ElemBatches& batches, bool bSimplex);
+
+	///	initializes the reference shape functions of the Q1 element
+		void init_reference_q1();
+
+	protected:
+	///	approximation space
+		SmartPtr<ApproximationSpace<TDomain> > m_spApproxSpace;
+
+	///	function name and id
+		std::string m_fctName;
+		size_t m_fct;
+
+	///	grid level
+		GridLevel m_gridLevel;
+
+	///	DoF distribution used in init
+		ConstSmartPtr<DoFDistribution> m_spDD;
+
+	///	coefficients
+		number m_diffusion;
+		MathVector<dim> m_velocity;
+		number m_reaction;
+
+	///	Dirichlet subsets
+		std::vector<std::string> m_vDirichletSubsets;
+
+	///	Dirichlet DoFs and value of the diagonal entry in the row (1, 0 on slaves)
+		std::vector<size_t> m_vDirichletInd;
+		std::vector<number> m_vDirichletDiag;
+
+	///	batches of simplices and multi-linear elements
+		ElemBatches m_simplices;
+		ElemBatches m_q1Elems;
+
+	///	shape functions and reference gradients of Q1 element, [qp][corner]
+		static const int numQ1 = 1 << dim;
+		number m_vQ1Shape[numQ1][numQ1];
+		number m_vQ1Grad[numQ1][numQ1][dim];
+
+	///	diagonal of operator
+		vector_type m_diag;
+
+	///	init flag
+		bool m_bInit;
+};
+
+} // end namespace ug
+
+#include "matrix_free_operator_impl.h"
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE__MATRIX_FREE_OPERATOR__ */
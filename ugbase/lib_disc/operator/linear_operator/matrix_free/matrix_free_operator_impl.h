@@ -0,0 +1,709 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE__MATRIX_FREE_OPERATOR_IMPL__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE__MATRIX_FREE_OPERATOR_IMPL__
+
+#include <cmath>
+
+#include "matrix_free_operator.h"
+#include "common/util/thread_util.h"
+#include "common/math/math_vector_matrix/math_matrix_functions.h"
+#include "common/profiler/profiler.h"
+
+#ifdef UG_PARALLEL
+#include "lib_algebra/parallelization/parallel_index_layout.h"
+#endif
+
+namespace ug{
+
+////////////////////////////////////////////////////////////////////////////////
+//	setup
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TDomain, typename TAlgebra>
+MatrixFreeOperator<TDomain, TAlgebra>::
+MatrixFreeOperator(SmartPtr<ApproximationSpace<TDomain> > spApproxSpace,
+                   const char* fct)
+	: m_spApproxSpace(spApproxSpace), m_fctName(fct), m_fct(0),
+	  m_diffusion(1.0), m_reaction(0.0), m_bInit(false)
+{
+	UG_STATIC_ASSERT(TAlgebra::blockSize == 1, only_scalar_algebra_supported);
+
+	if(m_spApproxSpace.invalid())
+		UG_THROW("MatrixFreeOperator: Approximation space missing.");
+
+	VecSet(m_velocity, 0.0);
+	init_reference_q1();
+}
+
+template <typename TDomain, typename TAlgebra>
+void MatrixFreeOperator<TDomain, TAlgebra>::
+set_velocity(const std::vector<number>& vVel)
+{
+	if(vVel.size() != (size_t)dim)
+		UG_THROW("MatrixFreeOperator::set_velocity: Velocity must have "
+				<< dim << " components, but " << vVel.size() << " given.");
+
+	for(int d = 0; d < dim; ++d) m_velocity[d] = vVel[d];
+	m_bInit = false;
+}
+
+template <typename TDomain, typename TAlgebra>
+void MatrixFreeOperator<TDomain, TAlgebra>::
+add_dirichlet_boundary(const char* subsets)
+{
+	m_vDirichletSubsets.push_back(subsets);
+	m_bInit = false;
+}
+
+template <typename TDomain, typename TAlgebra>
+size_t MatrixFreeOperator<TDomain, TAlgebra>::
+num_elements() const
+{
+	return m_simplices.numElem + m_q1Elems.numElem;
+}
+
+template <typename TDomain, typename TAlgebra>
+size_t MatrixFreeOperator<TDomain, TAlgebra>::
+num_colors() const
+{
+	const size_t n = std::max(m_simplices.vColorBatch.size(),
+	                          m_q1Elems.vColorBatch.size());
+	return (n > 0) ? n - 1 : 0;
+}
+
+template <typename TDomain, typename TAlgebra>
+void MatrixFreeOperator<TDomain, TAlgebra>::
+init_reference_q1()
+{
+//	corners of the reference element, numbered as in the reference elements
+	static const int vRefCo[8][3] = {{0,0,0}, {1,0,0}, {1,1,0}, {0,1,0},
+	                                 {0,0,1}, {1,0,1}, {1,1,1}, {0,1,1}};
+
+//	tensor product of the 2-point Gauss rule on [0,1]
+	const number vGauss[2] = {0.5 - 0.5/std::sqrt(3.0), 0.5 + 0.5/std::sqrt(3.0)};
+
+	for(int q = 0; q < numQ1; ++q)
+	{
+		number vQP[dim];
+		for(int d = 0; d < dim; ++d) vQP[d] = vGauss[(q >> d) & 1];
+
+		for(int c = 0; c < numQ1; ++c)
+		{
+			number vLin[dim], vLinDeriv[dim];
+			for(int d = 0; d < dim; ++d)
+			{
+				vLin[d] = vRefCo[c][d] ? vQP[d] : 1.0 - vQP[d];
+				vLinDeriv[d] = vRefCo[c][d] ? 1.0 : -1.0;
+			}
+
+			m_vQ1Shape[q][c] = 1.0;
+			for(int d = 0; d < dim; ++d) m_vQ1Shape[q][c] *= vLin[d];
+
+			for(int k = 0; k < dim; ++k)
+			{
+				m_vQ1Grad[q][c][k] = vLinDeriv[k];
+				for(int d = 0; d < dim; ++d)
+					if(d != k) m_vQ1Grad[q][c][k] *= vLin[d];
+			}
+		}
+	}
+}
+
+template <typename TDomain, typename TAlgebra>
+void MatrixFreeOperator<TDomain, TAlgebra>::
+simplex_data(number* vData, const MathVector<dim>* vCo) const
+{
+//	jacobian of the affine mapping x = x_0 + J * xi
+	MathMatrix<dim,dim> J, JInv;
+	for(int k = 0; k < dim; ++k)
+		for(int i = 0; i < dim; ++i)
+			J(i,k) = vCo[k+1][i] - vCo[0][i];
+
+	const number det = Inverse(JInv, J);
+
+//	gradients of the shape functions: grad phi_{k+1} = J^{-T} e_k
+	for(int d = 0; d < dim; ++d) vData[d] = 0.0;
+	for(int k = 0; k < dim; ++k)
+		for(int d = 0; d < dim; ++d)
+		{
+			vData[(k+1)*dim + d] = JInv(k,d);
+			vData[d] -= JInv(k,d);
+		}
+
+//	volume
+	number vol = std::fabs(det);
+	for(int k = 2; k <= dim; ++k) vol /= k;
+	vData[(dim+1)*dim] = vol;
+}
+
+template <typename TDomain, typename TAlgebra>
+void MatrixFreeOperator<TDomain, TAlgebra>::
+q1_data(number* vData, const MathVector<dim>* vCo) const
+{
+	const size_t numQPData = dim*dim + dim + 1;
+
+	for(int q = 0; q < numQ1; ++q)
+	{
+		MathMatrix<dim,dim> J, JInv;
+		for(int i = 0; i < dim; ++i)
+			for(int k = 0; k < dim; ++k)
+			{
+				J(i,k) = 0.0;
+				for(int c = 0; c < numQ1; ++c)
+					J(i,k) += vCo[c][i] * m_vQ1Grad[q][c][k];
+			}
+
+		const number wDet = std::fabs(Inverse(JInv, J)) / numQ1;
+
+	//	D * J^{-1} J^{-T}, J^{-1} v and r, weighted with the integration weight
+		number* qpData = vData + q*numQPData;
+		for(int d = 0; d < dim; ++d)
+			for(int e = 0; e < dim; ++e)
+			{
+				number sum = 0.0;
+				for(int i = 0; i < dim; ++i) sum += JInv(d,i) * JInv(e,i);
+				qpData[d*dim + e] = m_diffusion * wDet * sum;
+			}
+
+		for(int d = 0; d < dim; ++d)
+		{
+			number sum = 0.0;
+			for(int i = 0; i < dim; ++i) sum += JInv(d,i) * m_velocity[i];
+			qpData[dim*dim + d] = wDet * sum;
+		}
+
+		qpData[dim*dim + dim] = m_reaction * wDet;
+	}
+}
+
+template <typename TDomain, typename TAlgebra>
+template <int TNumCo>
+void MatrixFreeOperator<TDomain, TAlgebra>::
+collect_elements(ElemBatches& batches, ReferenceObjectID roid, bool bSimplex)
+{
+	typedef typename domain_traits<dim>::grid_base_object TElem;
+	typedef typename DoFDistribution::traits<TElem>::const_iterator iterator;
+
+	const typename TDomain::position_accessor_type& aaPos
+						= m_spApproxSpace->domain()->position_accessor();
+
+	batches = ElemBatches();
+	batches.numCo = TNumCo;
+	batches.numData = bSimplex ? TNumCo*dim + 1 : numQ1*(dim*dim + dim + 1);
+	const size_t numData = batches.numData;
+
+//	collect indices and cached data element by element
+	std::vector<size_t> vElemInd;
+	std::vector<number> vElemData;
+	std::vector<DoFIndex> ind;
+	MathVector<dim> vCo[TNumCo];
+
+	const iterator iterEnd = m_spDD->template end<TElem>();
+	for(iterator iter = m_spDD->template begin<TElem>(); iter != iterEnd; ++iter)
+	{
+		TElem* elem = *iter;
+		if(elem->reference_object_id() != roid) continue;
+
+	//	skip elements where the function is not defined
+		if(m_spDD->dof_indices(elem, m_fct, ind) != (size_t)TNumCo) continue;
+
+		for(int c = 0; c < TNumCo; ++c)
+		{
+			vElemInd.push_back(ind[c][0]);
+			vCo[c] = aaPos[elem->vertex(c)];
+		}
+
+		vElemData.resize(vElemData.size() + numData);
+		if(bSimplex) simplex_data(&vElemData[vElemData.size() - numData], vCo);
+		else q1_data(&vElemData[vElemData.size() - numData], vCo);
+	}
+
+	const size_t numElem = vElemInd.size() / TNumCo;
+	batches.numElem = numElem;
+	if(numElem == 0) {batches.vColorBatch.push_back(0); return;}
+
+//	greedy coloring, bit c of vColorMask[i] is set if an element of color c
+//	uses index i
+	const uint64 allColors = ~(uint64)0;
+	std::vector<uint64> vColorMask(m_spDD->num_indices(), 0);
+	std::vector<size_t> vColor(numElem, 0);
+	size_t numColors = 1;
+	for(size_t e = 0; e < numElem; ++e)
+	{
+		uint64 used = 0;
+		for(int c = 0; c < TNumCo; ++c)
+			used |= vColorMask[vElemInd[e*TNumCo + c]];
+
+	//	too many colors: process all elements in one serial sweep
+		if(used == allColors){
+			batches.bColored = false;
+			vColor.assign(numElem, 0);
+			numColors = 1;
+			break;
+		}
+
+		size_t col = 0;
+		while(used & ((uint64)1 << col)) ++col;
+
+		for(int c = 0; c < TNumCo; ++c)
+			vColorMask[vElemInd[e*TNumCo + c]] |= ((uint64)1 << col);
+
+		vColor[e] = col;
+		numColors = std::max(numColors, col + 1);
+	}
+
+//	sort elements by color
+	std::vector<size_t> vColorBegin(numColors + 1, 0);
+	for(size_t e = 0; e < numElem; ++e) ++vColorBegin[vColor[e] + 1];
+	for(size_t col = 0; col < numColors; ++col)
+		vColorBegin[col + 1] += vColorBegin[col];
+
+	std::vector<size_t> vOrder(numElem);
+	std::vector<size_t> vPos(vColorBegin.begin(), vColorBegin.end() - 1);
+	for(size_t e = 0; e < numElem; ++e) vOrder[vPos[vColor[e]]++] = e;
+
+//	build batches of elements of the same color, padding lanes get the
+//	indices of the first lane and zero data (they do not contribute)
+	batches.vColorBatch.push_back(0);
+	for(size_t col = 0; col < numColors; ++col)
+	{
+		const size_t cBegin = vColorBegin[col], cEnd = vColorBegin[col + 1];
+		for(size_t first = cBegin; first < cEnd; first += BATCH)
+		{
+			const size_t indOffset = batches.vInd.size();
+			const size_t dataOffset = batches.vData.size();
+			batches.vInd.resize(indOffset + TNumCo*BATCH);
+			batches.vData.resize(dataOffset + numData*BATCH, 0.0);
+
+			for(int l = 0; l < BATCH; ++l)
+			{
+				const bool bPad = (first + l >= cEnd);
+				const size_t e = vOrder[bPad ? first : first + l];
+
+				for(int c = 0; c < TNumCo; ++c)
+					batches.vInd[indOffset + c*BATCH + l] = vElemInd[e*TNumCo + c];
+
+				if(bPad) continue;
+				for(size_t k = 0; k < numData; ++k)
+					batches.vData[dataOffset + k*BATCH + l] = vElemData[e*numData + k];
+			}
+		}
+		batches.vColorBatch.push_back(batches.num_batches());
+	}
+}
+
+template <typename TDomain, typename TAlgebra>
+void MatrixFreeOperator<TDomain, TAlgebra>::
+init()
+{
+	PROFILE_FUNC_GROUP("discretization");
+
+	m_spDD = m_spApproxSpace->dof_distribution(m_gridLevel);
+	m_fct = m_spDD->fct_id_by_name(m_fctName.c_str());
+
+	const LFEID& lfeID = m_spDD->local_finite_element_id(m_fct);
+	if(lfeID.type() != LFEID::LAGRANGE || lfeID.order() != 1)
+		UG_THROW("MatrixFreeOperator: Only Lagrange P1/Q1 functions supported, "
+				"but function '" << m_fctName << "' is of type " << lfeID);
+
+//	check the element types
+	typedef typename domain_traits<dim>::grid_base_object TElem;
+	typedef typename DoFDistribution::traits<TElem>::const_iterator iterator;
+	const ReferenceObjectID simplexROID = (dim == 1) ? ROID_EDGE
+	                              : (dim == 2) ? ROID_TRIANGLE : ROID_TETRAHEDRON;
+	const ReferenceObjectID q1ROID = (dim == 2) ? ROID_QUADRILATERAL
+	                              : (dim == 3) ? ROID_HEXAHEDRON : ROID_EDGE;
+
+	const iterator iterEnd = m_spDD->template end<TElem>();
+	for(iterator iter = m_spDD->template begin<TElem>(); iter != iterEnd; ++iter)
+	{
+		const ReferenceObjectID roid = (*iter)->reference_object_id();
+		if(roid != simplexROID && roid != q1ROID)
+			UG_THROW("MatrixFreeOperator: Element type " << roid << " not supported.");
+	}
+
+//	cache element data
+	collect_elements<dim+1>(m_simplices, simplexROID, true);
+	if(dim > 1) collect_elements<numQ1>(m_q1Elems, q1ROID, false);
+	else m_q1Elems = ElemBatches();
+
+//	Dirichlet DoFs, in parallel only the masters keep the identity row, so
+//	that the additive row sums up to the identity
+	const size_t numIndex = m_spDD->num_indices();
+	std::vector<bool> vSlave(numIndex, false);
+#ifdef UG_PARALLEL
+	MarkAllFromLayout(vSlave, m_spDD->layouts()->slave());
+#endif
+
+	std::vector<bool> vDirichlet(numIndex, false);
+	std::vector<DoFIndex> ind;
+	for(size_t i = 0; i < m_vDirichletSubsets.size(); ++i)
+	{
+		SubsetGroup ssGrp = m_spDD->subset_grp_by_name(m_vDirichletSubsets[i].c_str());
+		for(size_t s = 0; s < ssGrp.size(); ++s)
+		{
+			const int si = ssGrp[s];
+			typename DoFDistribution::traits<Vertex>::const_iterator iter, end;
+			iter = m_spDD->template begin<Vertex>(si);
+			end = m_spDD->template end<Vertex>(si);
+			for(; iter != end; ++iter)
+			{
+				m_spDD->dof_indices(*iter, m_fct, ind);
+				for(size_t j = 0; j < ind.size(); ++j)
+					vDirichlet[ind[j][0]] = true;
+			}
+		}
+	}
+
+	m_vDirichletInd.clear();
+	m_vDirichletDiag.clear();
+	for(size_t i = 0; i < numIndex; ++i)
+	{
+		if(!vDirichlet[i]) continue;
+		m_vDirichletInd.push_back(i);
+		m_vDirichletDiag.push_back(vSlave[i] ? 0.0 : 1.0);
+	}
+
+//	diagonal
+	m_diag.resize(numIndex);
+#ifdef UG_PARALLEL
+	m_diag.set_layouts(m_spDD->layouts());
+#endif
+	m_diag.set(0.0);
+	add_diagonal<dim+1>(m_simplices, true);
+	add_diagonal<numQ1>(m_q1Elems, false);
+	for(size_t i = 0; i < m_vDirichletInd.size(); ++i)
+		m_diag[m_vDirichletInd[i]] = m_vDirichletDiag[i];
+
+#ifdef UG_PARALLEL
+	m_diag.set_storage_type(PST_ADDITIVE);
+	m_diag.change_storage_type(PST_CONSISTENT);
+#endif
+
+	m_bInit = true;
+}
+
+template <typename TDomain, typename TAlgebra>
+template <int TNumCo>
+void MatrixFreeOperator<TDomain, TAlgebra>::
+add_diagonal(const ElemBatches& batches, bool bSimplex)
+{
+	const size_t numData = batches.numData;
+	const number cConv = 1.0 / (dim+1);
+	const number cMass = 2.0 * m_reaction / ((dim+1)*(dim+2));
+	const size_t numQPData = dim*dim + dim + 1;
+
+	for(size_t b = 0; b < batches.num_batches(); ++b)
+	{
+		const size_t* ind = &batches.vInd[b*TNumCo*BATCH];
+		const number* data = &batches.vData[b*numData*BATCH];
+
+		for(int l = 0; l < BATCH; ++l)
+			for(int c = 0; c < TNumCo; ++c)
+			{
+				number diag = 0.0;
+				if(bSimplex)
+				{
+					const number vol = data[TNumCo*dim*BATCH + l];
+					number gg = 0.0, vg = 0.0;
+					for(int d = 0; d < dim; ++d)
+					{
+						const number g = data[(c*dim + d)*BATCH + l];
+						gg += g * g;
+						vg += m_velocity[d] * g;
+					}
+					diag = vol * (m_diffusion * gg + cConv * vg + cMass);
+				}
+				else
+				{
+					for(int q = 0; q < numQ1; ++q)
+					{
+						const number* qpData = data + q*numQPData*BATCH;
+						const number* vGrad = m_vQ1Grad[q][c];
+						const number shape = m_vQ1Shape[q][c];
+						for(int d = 0; d < dim; ++d)
+						{
+							for(int e = 0; e < dim; ++e)
+								diag += vGrad[d] * qpData[(d*dim + e)*BATCH + l] * vGrad[e];
+							diag += shape * qpData[(dim*dim + d)*BATCH + l] * vGrad[d];
+						}
+						diag += shape * shape * qpData[(dim*dim + dim)*BATCH + l];
+					}
+				}
+				m_diag[ind[c*BATCH + l]] += diag;
+			}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//	application
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TDomain, typename TAlgebra>
+template <int TNumCo>
+void MatrixFreeOperator<TDomain, TAlgebra>::
+apply_simplex(const ElemBatches& batches, size_t bBegin, size_t bEnd,
+              number* f, const number* u, number s) const
+{
+	const size_t numData = batches.numData;
+	const number D = m_diffusion;
+	const number cConv = 1.0 / (dim+1);
+	const number cMass = m_reaction / ((dim+1)*(dim+2));
+
+	for(size_t b = bBegin; b < bEnd; ++b)
+	{
+		const size_t* ind = &batches.vInd[b*TNumCo*BATCH];
+		const number* G = &batches.vData[b*numData*BATCH];
+		const number* vol = G + TNumCo*dim*BATCH;
+
+	//	gather
+		number uLoc[TNumCo][BATCH];
+		for(int c = 0; c < TNumCo; ++c)
+			for(int l = 0; l < BATCH; ++l)
+				uLoc[c][l] = u[ind[c*BATCH + l]];
+
+	//	gradient, convective derivative and mean value
+		number grad[dim][BATCH], conv[BATCH], mass[BATCH];
+		for(int l = 0; l < BATCH; ++l) {conv[l] = 0.0; mass[l] = 0.0;}
+		for(int d = 0; d < dim; ++d)
+		{
+			for(int l = 0; l < BATCH; ++l) grad[d][l] = 0.0;
+			for(int c = 0; c < TNumCo; ++c)
+				for(int l = 0; l < BATCH; ++l)
+					grad[d][l] += uLoc[c][l] * G[(c*dim + d)*BATCH + l];
+			for(int l = 0; l < BATCH; ++l)
+				conv[l] += m_velocity[d] * grad[d][l];
+		}
+		for(int c = 0; c < TNumCo; ++c)
+			for(int l = 0; l < BATCH; ++l)
+				mass[l] += uLoc[c][l];
+
+		for(int l = 0; l < BATCH; ++l)
+		{
+			conv[l] *= cConv * vol[l];
+			mass[l] *= cMass * vol[l];
+		}
+		for(int d = 0; d < dim; ++d)
+			for(int l = 0; l < BATCH; ++l)
+				grad[d][l] *= D * vol[l];
+
+	//	element residual and scatter
+		for(int c = 0; c < TNumCo; ++c)
+		{
+			number y[BATCH];
+			for(int l = 0; l < BATCH; ++l)
+				y[l] = conv[l] + mass[l] + cMass * vol[l] * uLoc[c][l];
+			for(int d = 0; d < dim; ++d)
+				for(int l = 0; l < BATCH; ++l)
+					y[l] += grad[d][l] * G[(c*dim + d)*BATCH + l];
+
+			for(int l = 0; l < BATCH; ++l)
+				f[ind[c*BATCH + l]] += s * y[l];
+		}
+	}
+}
+
+template <typename TDomain, typename TAlgebra>
+template <int TNumCo>
+void MatrixFreeOperator<TDomain, TAlgebra>::
+apply_q1(const ElemBatches& batches, size_t bBegin, size_t bEnd,
+         number* f, const number* u, number s) const
+{
+	const size_t numData = batches.numData;
+	const size_t numQPData = dim*dim + dim + 1;
+
+	for(size_t b = bBegin; b < bEnd; ++b)
+	{
+		const size_t* ind = &batches.vInd[b*TNumCo*BATCH];
+		const number* data = &batches.vData[b*numData*BATCH];
+
+	//	gather
+		number uLoc[TNumCo][BATCH], y[TNumCo][BATCH];
+		for(int c = 0; c < TNumCo; ++c)
+			for(int l = 0; l < BATCH; ++l)
+			{
+				uLoc[c][l] = u[ind[c*BATCH + l]];
+				y[c][l] = 0.0;
+			}
+
+		for(int q = 0; q < numQ1; ++q)
+		{
+			const number* qpData = data + q*numQPData*BATCH;
+
+		//	reference gradient and value in the integration point
+			number grad[dim][BATCH], val[BATCH];
+			for(int l = 0; l < BATCH; ++l) val[l] = 0.0;
+			for(int d = 0; d < dim; ++d)
+				for(int l = 0; l < BATCH; ++l) grad[d][l] = 0.0;
+
+			for(int c = 0; c < TNumCo; ++c)
+			{
+				for(int d = 0; d < dim; ++d)
+					for(int l = 0; l < BATCH; ++l)
+						grad[d][l] += m_vQ1Grad[q][c][d] * uLoc[c][l];
+				for(int l = 0; l < BATCH; ++l)
+					val[l] += m_vQ1Shape[q][c] * uLoc[c][l];
+			}
+
+		//	flux and source in the integration point
+			number flux[dim][BATCH], src[BATCH];
+			for(int l = 0; l < BATCH; ++l)
+				src[l] = qpData[(dim*dim + dim)*BATCH + l] * val[l];
+			for(int d = 0; d < dim; ++d)
+			{
+				for(int l = 0; l < BATCH; ++l) flux[d][l] = 0.0;
+				for(int e = 0; e < dim; ++e)
+					for(int l = 0; l < BATCH; ++l)
+						flux[d][l] += qpData[(d*dim + e)*BATCH + l] * grad[e][l];
+				for(int l = 0; l < BATCH; ++l)
+					src[l] += qpData[(dim*dim + d)*BATCH + l] * grad[d][l];
+			}
+
+		//	test with shape functions
+			for(int c = 0; c < TNumCo; ++c)
+			{
+				for(int d = 0; d < dim; ++d)
+					for(int l = 0; l < BATCH; ++l)
+						y[c][l] += m_vQ1Grad[q][c][d] * flux[d][l];
+				for(int l = 0; l < BATCH; ++l)
+					y[c][l] += m_vQ1Shape[q][c] * src[l];
+			}
+		}
+
+	//	scatter
+		for(int c = 0; c < TNumCo; ++c)
+			for(int l = 0; l < BATCH; ++l)
+				f[ind[c*BATCH + l]] += s * y[c][l];
+	}
+}
+
+template <typename TDomain, typename TAlgebra>
+template <int TNumCo>
+void MatrixFreeOperator<TDomain, TAlgebra>::
+apply_batches(const ElemBatches& batches, bool bSimplex,
+              number* f, const number* u, number s) const
+{
+//	colors one after the other, the batches of a color in parallel
+	for(size_t col = 0; col + 1 < batches.vColorBatch.size(); ++col)
+	{
+		const size_t bBegin = batches.vColorBatch[col];
+		const size_t bEnd = batches.vColorBatch[col + 1];
+
+		const int numThreads = batches.bColored
+			? NumThreadsForRange((bEnd - bBegin) * BATCH * batches.numData) : 1;
+		if(numThreads == 1){
+			if(bSimplex) apply_simplex<TNumCo>(batches, bBegin, bEnd, f, u, s);
+			else apply_q1<TNumCo>(batches, bBegin, bEnd, f, u, s);
+			continue;
+		}
+
+#ifdef UG_OPENMP
+		#pragma omp parallel num_threads(numThreads)
+		{
+			size_t from, to;
+			ThreadChunk(bEnd - bBegin, NumActiveThreads(), ThreadIndex(), from, to);
+			if(bSimplex) apply_simplex<TNumCo>(batches, bBegin + from, bBegin + to, f, u, s);
+			else apply_q1<TNumCo>(batches, bBegin + from, bBegin + to, f, u, s);
+		}
+#endif
+	}
+}
+
+template <typename TDomain, typename TAlgebra>
+void MatrixFreeOperator<TDomain, TAlgebra>::
+apply_add(vector_type& f, const vector_type& u, number s)
+{
+	PROFILE_FUNC_GROUP("algebra");
+
+	if(!m_bInit) init();
+
+	const size_t numIndex = m_spDD->num_indices();
+	if(u.size() != numIndex || f.size() != numIndex)
+		UG_THROW("MatrixFreeOperator: Vector sizes (" << u.size() << ", "
+				<< f.size() << ") do not match number of DoFs " << numIndex);
+	if(numIndex == 0) return;
+
+//	the rows of Dirichlet DoFs are replaced by the identity
+	std::vector<number> vDirichletF(m_vDirichletInd.size());
+	for(size_t i = 0; i < m_vDirichletInd.size(); ++i)
+		vDirichletF[i] = f[m_vDirichletInd[i]];
+
+	number* pF = &f[0];
+	const number* pU = &u[0];
+	apply_batches<dim+1>(m_simplices, true, pF, pU, s);
+	apply_batches<numQ1>(m_q1Elems, false, pF, pU, s);
+
+	for(size_t i = 0; i < m_vDirichletInd.size(); ++i)
+	{
+		const size_t index = m_vDirichletInd[i];
+		f[index] = vDirichletF[i] + s * m_vDirichletDiag[i] * u[index];
+	}
+}
+
+template <typename TDomain, typename TAlgebra>
+void MatrixFreeOperator<TDomain, TAlgebra>::
+apply(vector_type& f, const vector_type& u)
+{
+#ifdef UG_PARALLEL
+	if(!u.has_storage_type(PST_CONSISTENT))
+		UG_THROW("MatrixFreeOperator::apply: Inadequate storage format of Vector u, "
+				"must be consistent.");
+#endif
+
+	f.set(0.0);
+	apply_add(f, u, 1.0);
+
+#ifdef UG_PARALLEL
+	f.set_storage_type(PST_ADDITIVE);
+#endif
+}
+
+template <typename TDomain, typename TAlgebra>
+void MatrixFreeOperator<TDomain, TAlgebra>::
+apply_sub(vector_type& f, const vector_type& u)
+{
+#ifdef UG_PARALLEL
+	if(!u.has_storage_type(PST_CONSISTENT))
+		UG_THROW("MatrixFreeOperator::apply_sub: Inadequate storage format of Vector u, "
+				"must be consistent.");
+	if(!f.change_storage_type(PST_ADDITIVE))
+		UG_THROW("MatrixFreeOperator::apply_sub: Cannot change storage format "
+				"of Vector f to additive.");
+#endif
+
+	apply_add(f, u, -1.0);
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE__MATRIX_FREE_OPERATOR_IMPL__ */
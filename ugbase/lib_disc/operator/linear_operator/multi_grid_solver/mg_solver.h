@@ -165,6 +165,13 @@ class AssembledMultiGridCycle :
 	///	sets if communication and computation should be overlaped
 		void set_comm_comp_overlap(bool bOverlap) {m_bCommCompOverlap = bOverlap;}
 
+	///	sets if the level matrices are applied in reduced (single) precision
+	/**	The defect updates on the smoothing levels then use a float copy of
+	 * the level matrices, while all vectors stay in double. Use together
+	 * with the mixed precision mode of the smoothers (e.g.
+	 * GaussSeidel::enable_mixed_precision). Only for scalar algebra.*/
+		void set_mixed_precision(bool bMixed) {m_bMixedPrecision = bMixed;}
+
 	///	sets the number of pre-smoothing steps to be performed
 		void set_num_presmooth(int num) {m_numPreSmooth = num;}
 
@@ -356,6 +363,9 @@ class AssembledMultiGridCycle :
 	///	flag if overlapping communication and computation
 		bool m_bCommCompOverlap;
 
+	///	flag if level matrices are applied in reduced precision
+		bool m_bMixedPrecision;
+
 	///	approximation space revision of cached values
 		RevisionCounter m_ApproxSpaceRevision;
 
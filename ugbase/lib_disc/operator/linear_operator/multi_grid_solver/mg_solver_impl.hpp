@@ -84,6 +84,7 @@ AssembledMultiGridCycle() :
 	m_LocalFullRefLevel(0), m_GridLevelType(GridLevel::LEVEL),
 	m_bUseRAP(false), m_bSmoothOnSurfaceRim(false),
 	m_bCommCompOverlap(false),
+	m_bMixedPrecision(false),
 	m_spPreSmootherPrototype(new Jacobi<TAlgebra>()),
 	m_spPostSmootherPrototype(m_spPreSmootherPrototype),
 	m_spProjectionPrototype(SPNULL),
@@ -106,6 +107,7 @@ AssembledMultiGridCycle(SmartPtr<ApproximationSpace<TDomain> > approxSpace) :
 	m_LocalFullRefLevel(0), m_GridLevelType(GridLevel::LEVEL),
 	m_bUseRAP(false), m_bSmoothOnSurfaceRim(false),
 	m_bCommCompOverlap(false),
+	m_bMixedPrecision(false),
 	m_spPreSmootherPrototype(new Jacobi<TAlgebra>()),
 	m_spPostSmootherPrototype(m_spPreSmootherPrototype),
 	m_spProjectionPrototype(new StdInjection<TDomain,TAlgebra>(m_spApproxSpace)),
@@ -146,6 +148,7 @@ clone()
 	clone->set_presmoother(m_spPreSmootherPrototype);
 	clone->set_postsmoother(m_spPostSmootherPrototype);
 	clone->set_surface_level(m_surfaceLev);
+	clone->set_mixed_precision(m_bMixedPrecision);
 
 	for(size_t i = 0; i < m_vspProlongationPostProcess.size(); ++i)
 		clone->add_prolongation_post_process(m_vspProlongationPostProcess[i]);
@@ -1127,6 +1130,9 @@ init_smoother()
 	{
 		LevData& ld = *m_vLevData[lev];
 
+	//	defect updates on smoothing levels in reduced precision
+		ld.A->set_reduced_precision(m_bMixedPrecision);
+
 		UG_DLOG(LIB_DISC_MULTIGRID, 4, "  init_smoother: initializing pre-smoother on lev "<<lev<<"\n");
 		bool success;
 		GridLevel gw_gl; enter_debug_writer_section(gw_gl, "PreSmootherInit", lev);
@@ -115,7 +115,8 @@ class AssemblingTuner
 		m_bSingleAssIndex(false), m_SingleAssIndex(0),
 		m_bForceRegGrid(false), m_bModifySolutionImplemented(false),
 		m_ConstraintTypesEnabled(CT_ALL), m_ElemTypesEnabled(EDT_ALL),
-		m_bMatrixIsConst(false), m_bClearOnResize(true)
+		m_bMatrixIsConst(false), m_bClearOnResize(true),
+		m_bThreadedAssembling(true)
 		{
 			m_pMapper = &m_pMapperCommon;
 		}
@@ -132,6 +133,9 @@ class AssemblingTuner
 				m_pMapper = &m_pMapperCommon;
 		}
 
+	///	returns if the default local to global mapping is used
+		bool default_mapping_used() const {return m_pMapper == &m_pMapperCommon;}
+
 	/// LocalToGlobalMapper-function calls
 		void add_local_vec_to_global(vector_type& vec, const LocalVector& lvec,
 		                 ConstSmartPtr<DoFDistribution> dd) const
@@ -258,6 +262,18 @@ class AssemblingTuner
 	 */
 		bool matrix_is_const() const {return m_bMatrixIsConst;}
 
+	/**
+	 * enables or disables the thread-parallel element loop. It is only used
+	 * if more than one thread is set (SetNumThreads), the default mapping is
+	 * used and all element discretizations of a subset are thread-safe.
+	 *
+	 * @param bEnable	set false to force serial assembling
+	 */
+		void enable_threaded_assembling(bool bEnable) {m_bThreadedAssembling = bEnable;}
+
+	///	returns if the thread-parallel element loop may be used
+		bool threaded_assembling_enabled() const {return m_bThreadedAssembling;}
+
 	protected:
 	///	default LocalToGlobalMapper
 		LocalToGlobalMapper<TAlgebra> m_pMapperCommon;
@@ -293,6 +309,9 @@ class AssemblingTuner
 
 	/// disables clearing of vector/matrix on resize
 		bool m_bClearOnResize;
+
+	///	enables the thread-parallel element loop
+		bool m_bThreadedAssembling;
 };
 
 } // end namespace ug
@@ -34,6 +34,7 @@
 #define __H__UG__LIB_DISC__SPATIAL_DISC__DISC_UTIL__GEOM_PROVIDER__
 
 #include <map>
+#include <vector>
 #include "lib_disc/local_finite_element/local_finite_element_id.h"
 
 namespace ug{
@@ -65,7 +66,7 @@ class GeomProvider
 		GeomProvider() {m_mLFEIDandOrder.clear();}
 
 		/// destructor
-		~GeomProvider() {clear_geoms();}
+		~GeomProvider() {clear_geoms(); clear_thread_geoms();}
 
 		/// singleton provider
 		static GeomProvider<TGeom>& inst() {
@@ -124,6 +125,16 @@ class GeomProvider
 			m_mLFEIDandOrder.clear();
 		}
 
+		/// instances of the threads 1, 2, ... (see get_for_thread)
+		std::vector<TGeom*> m_vThreadGeom;
+
+		/// deletes the instances of the threads
+		void clear_thread_geoms(){
+			for(size_t i = 0; i < m_vThreadGeom.size(); ++i)
+				delete m_vThreadGeom[i];
+			m_vThreadGeom.clear();
+		}
+
 	public:
 		///	type of provided object
 		typedef TGeom Type;
@@ -146,6 +157,31 @@ class GeomProvider
 			return inst;
 		}
 
+		///	returns the instance used by a thread of a threaded element loop
+		/**
+		 * Element discretizations which may be assembled by several threads
+		 * (see IElemDiscBase::thread_safe) use one instance per thread.
+		 * Thread 0 uses the singleton returned by get(). The instances of the
+		 * other threads are created by create_thread_instances, which has to
+		 * be called before the threads are started.
+		 */
+		static inline TGeom& get_for_thread(int thread){
+			if(thread == 0) return get();
+			UG_ASSERT(thread - 1 < (int)inst().m_vThreadGeom.size(),
+					  "GeomProvider: No instance created for thread " << thread);
+			return *inst().m_vThreadGeom[thread - 1];
+		}
+
+		///	creates the instances for the threads used by get_for_thread
+		static void create_thread_instances(int numThreads){
+			if(!staticLocalData)
+				UG_THROW("GeomProvider: thread instances are only supported for"
+						 " geometries with static local data.");
+			std::vector<TGeom*>& vGeom = inst().m_vThreadGeom;
+			while((int)vGeom.size() < numThreads - 1)
+				vGeom.push_back(new TGeom());
+		}
+
 		///	clears all singletons
 		static inline void clear(){
 			inst().clear_geoms();
@@ -104,7 +104,8 @@ class DomainDiscretizationBase
 	///	default Constructor
 		DomainDiscretizationBase(SmartPtr<approx_space_type> pApproxSpace) :
 			m_bErrorCalculated(false),
-			m_spApproxSpace(pApproxSpace), m_spAssTuner(new AssemblingTuner<TAlgebra>)
+			m_spApproxSpace(pApproxSpace), m_spAssTuner(new AssemblingTuner<TAlgebra>),
+			m_RevCnt(this)
 		{};
 
 	/// virtual destructor
@@ -337,6 +338,7 @@ public:
 
 		//	add it
 			m_vDomainElemDisc.push_back(elem);
+			increase_revision();
 		}
 
 	/// removes a element discretization from the assembling process
@@ -355,6 +357,7 @@ public:
 				{
 					// remove constraint
 					m_vDomainElemDisc.erase(m_vDomainElemDisc.begin()+i);
+					increase_revision();
 					return;
 				}
 			}
@@ -430,6 +433,7 @@ public:
 
 		//	add constraint
 			m_vConstraint.push_back(pp);
+			increase_revision();
 		}
 
 	/// removes a constraint from the assembling process
@@ -448,6 +452,7 @@ public:
 				{
 					// remove constraint
 					m_vConstraint.erase(m_vConstraint.begin()+i);
+					increase_revision();
 					return;
 				}
 			}
@@ -483,6 +488,22 @@ public:
 		SmartPtr<approx_space_type> approximation_space ()				{return m_spApproxSpace;}
 		ConstSmartPtr<approx_space_type> approximation_space () const	{return m_spApproxSpace;}
 
+	///	returns the revision of the discretization
+	/**	The revision is increased if the approximation space changes (e.g. by
+	 * grid adaption), if discretization items are added or removed and on
+	 * every call of increase_revision.*/
+		virtual RevisionCounter revision() const
+		{
+			if(m_ApproxSpaceRevision != m_spApproxSpace->revision()){
+				m_ApproxSpaceRevision = m_spApproxSpace->revision();
+				++m_RevCnt;
+			}
+			return m_RevCnt;
+		}
+
+	///	increases the revision, e.g. after parameters of the elem discs have been changed
+		void increase_revision() {++m_RevCnt;}
+
 	protected:
 	///	set the approximation space in the elem discs and extract IElemDiscs
 		void update_elem_discs();
@@ -516,6 +537,10 @@ public:
 		
 	///	this object provides tools to adapt the assemble routine
 		SmartPtr<AssemblingTuner<TAlgebra> > m_spAssTuner;
+
+	///	revision of the discretization and of the approximation space it refers to
+		mutable RevisionCounter m_RevCnt;
+		mutable RevisionCounter m_ApproxSpaceRevision;
 	
 	private:
 	//---- Auxiliary function templates for the assembling ----//
@@ -34,6 +34,7 @@
 #define __H__UG__LIB_DISC__SPATIAL_DISC__DOMAIN_DISC_INTERFACE__
 
 #include "lib_disc/assemble_interface.h"
+#include "lib_disc/common/revision_counter.h"
 #include "lib_disc/time_disc/solution_time_series.h"
 #include "lib_disc/spatial_disc/constraints/constraint_interface.h"
 #include "lib_grid/refinement/refiner_interface.h"
@@ -204,6 +205,16 @@ class IDomainDiscretization : public IAssemble<TAlgebra>, public IDomainErrorInd
 		virtual void assemble_stiffness_matrix(matrix_type& A, const vector_type& u, const GridLevel& gl) = 0;
 		virtual void assemble_stiffness_matrix(matrix_type& A, const vector_type& u, ConstSmartPtr<DoFDistribution> dd) = 0;
 
+	///	returns the revision of the discretization
+	/**
+	 * The revision changes whenever assembled operators may change, e.g. if
+	 * the grid or the registered discretization items change. Objects caching
+	 * assembled matrices compare it to decide if their cache is still valid.
+	 * The default implementation returns an invalid revision, i.e. caches are
+	 * never considered valid.
+	 */
+		virtual RevisionCounter revision() const {return RevisionCounter();}
+
 
 	public:
 	/// prepares time step
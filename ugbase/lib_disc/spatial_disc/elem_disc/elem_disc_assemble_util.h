@@ -39,6 +39,7 @@
 
 // other ug4 modules
 #include "common/common.h"
+#include "common/util/thread_util.h"
 
 // intern headers
 #include "../../reference_element/reference_element.h"
@@ -124,6 +125,12 @@ public:
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	//	use the thread-parallel element loop if possible
+		JacAElemOp op(A, u);
+		if(AssembleThreaded<TElem>(op, STIFF, vElemDisc, spDomain, dd, iterBegin, iterEnd,
+		                           si, bNonRegularGrid, &A, spAssTuner))
+			return;
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -338,6 +345,12 @@ public:
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	//	use the thread-parallel element loop if possible
+		JacAElemOp op(J, u);
+		if(AssembleThreaded<TElem>(op, STIFF | RHS, vElemDisc, spDomain, dd, iterBegin, iterEnd,
+		                           si, bNonRegularGrid, &J, spAssTuner))
+			return;
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -589,6 +602,12 @@ public:
 	//	check if at least one element exists, else return
 		if(iterBegin == iterEnd) return;
 
+	//	use the thread-parallel element loop if possible
+		DefectElemOp op(d, u);
+		if(AssembleThreaded<TElem>(op, STIFF | RHS, vElemDisc, spDomain, dd, iterBegin, iterEnd,
+		                           si, bNonRegularGrid, NULL, spAssTuner))
+			return;
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -914,6 +933,12 @@ public:
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	//	use the thread-parallel element loop if possible
+		LinearElemOp op(A, rhs);
+		if(AssembleThreaded<TElem>(op, STIFF | RHS, vElemDisc, spDomain, dd, iterBegin, iterEnd,
+		                           si, bNonRegularGrid, &A, spAssTuner))
+			return;
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -2060,6 +2085,305 @@ public:
 		UG_CATCH_THROW("AssembleErrorEstimator: Cannot create Data Evaluator.");
 	}
 
+
+////////////////////////////////////////////////////////////////////////////////
+// Thread-parallel element loop
+////////////////////////////////////////////////////////////////////////////////
+
+protected:
+	///	local algebra used by one thread of the thread-parallel element loop
+	struct ElemLoopData
+	{
+		LocalIndices ind;
+		LocalVector locU, locD, tmpLocD;
+		LocalMatrix locA;
+	};
+
+	///	element operation: adds the local stiffness part of the jacobian
+	struct JacAElemOp
+	{
+		JacAElemOp(matrix_type& A_, const vector_type& u_) : A(A_), u(u_) {}
+
+		void operator()(DataEvaluator<domain_type>& Eval, GridObject* elem,
+		                ReferenceObjectID id,
+		                const MathVector<domain_type::dim> vCornerCoords[],
+		                ElemLoopData& loc) const
+		{
+			loc.locU.resize(loc.ind); loc.locA.resize(loc.ind);
+			GetLocalVector(loc.locU, u);
+
+			Eval.prepare_elem(loc.locU, elem, id, vCornerCoords, loc.ind, true);
+
+			loc.locA = 0.0;
+			Eval.add_jac_A_elem(loc.locA, loc.locU, elem, vCornerCoords);
+
+			AddLocalMatrixToGlobal(A, loc.locA);
+		}
+
+		matrix_type& A;
+		const vector_type& u;
+	};
+
+	///	element operation: adds the local (stationary) defect
+	struct DefectElemOp
+	{
+		DefectElemOp(vector_type& d_, const vector_type& u_) : d(d_), u(u_) {}
+
+		void operator()(DataEvaluator<domain_type>& Eval, GridObject* elem,
+		                ReferenceObjectID id,
+		                const MathVector<domain_type::dim> vCornerCoords[],
+		                ElemLoopData& loc) const
+		{
+			loc.locU.resize(loc.ind); loc.locD.resize(loc.ind);
+			loc.tmpLocD.resize(loc.ind);
+			GetLocalVector(loc.locU, u);
+
+		//	note: the threaded loop is only used with the default mapping,
+		//	whose modify_LocalSol does not change the solution
+			Eval.prepare_elem(loc.locU, elem, id, vCornerCoords, loc.ind);
+
+			loc.locD = 0.0;
+			Eval.add_def_A_elem(loc.locD, loc.locU, elem, vCornerCoords);
+
+			loc.tmpLocD = 0.0;
+			Eval.add_rhs_elem(loc.tmpLocD, elem, vCornerCoords);
+			loc.locD.scale_append(-1, loc.tmpLocD);
+
+			AddLocalVector(d, loc.locD);
+		}
+
+		vector_type& d;
+		const vector_type& u;
+	};
+
+	///	element operation: adds the local matrix and rhs of a (stationary) linear problem
+	struct LinearElemOp
+	{
+		LinearElemOp(matrix_type& A_, vector_type& rhs_) : A(A_), rhs(rhs_) {}
+
+		void operator()(DataEvaluator<domain_type>& Eval, GridObject* elem,
+		                ReferenceObjectID id,
+		                const MathVector<domain_type::dim> vCornerCoords[],
+		                ElemLoopData& loc) const
+		{
+			loc.locD.resize(loc.ind); loc.locA.resize(loc.ind);
+
+			Eval.prepare_elem(loc.locD, elem, id, vCornerCoords, loc.ind, true);
+
+			loc.locA = 0.0;
+			loc.locD = 0.0;
+			Eval.add_jac_A_elem(loc.locA, loc.locD, elem, vCornerCoords);
+			Eval.add_rhs_elem(loc.locD, elem, vCornerCoords);
+
+			AddLocalMatrixToGlobal(A, loc.locA);
+			AddLocalVector(rhs, loc.locD);
+		}
+
+		matrix_type& A;
+		vector_type& rhs;
+	};
+
+	/**
+	 * Colors the used elements, such that no two elements of one color share
+	 * a DoF index. Elements of the same color may therefore be assembled
+	 * concurrently without write conflicts. If a matrix is passed, the
+	 * sparsity pattern of all elements is created, too, so that the
+	 * concurrent assembling only adds to existing matrix entries.
+	 *
+	 * \param[out]		vvElem			elements sorted by color
+	 * \param[in]		dd				DoF Distribution
+	 * \param[in]		iterBegin		element iterator
+	 * \param[in]		iterEnd			element iterator
+	 * \param[in]		bUseHanging		flag if hanging DoFs are used
+	 * \param[in,out]	pA				matrix to create the pattern for (or NULL)
+	 * \param[in]		spAssTuner		assemble adapter
+	 * \returns			false if more than 64 colors would be needed
+	 */
+	template <typename TElem, typename TIterator>
+	static bool
+	ColorElements(std::vector<std::vector<TElem*> >& vvElem,
+	              ConstSmartPtr<DoFDistribution> dd,
+	              TIterator iterBegin,
+	              TIterator iterEnd,
+	              bool bUseHanging,
+	              matrix_type* pA,
+	              ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+		const uint64 allColors = ~(uint64)0;
+
+	//	bit c of vColorMask[i] is set, if an element of color c uses index i
+		std::vector<uint64> vColorMask(dd->num_indices(), 0);
+
+		LocalIndices ind; LocalMatrix locA;
+		for(TIterator iter = iterBegin; iter != iterEnd; ++iter)
+		{
+			TElem* elem = *iter;
+			if(!spAssTuner->element_used(elem)) continue;
+
+			dd->indices(elem, ind, bUseHanging);
+
+		//	collect the colors of all elements sharing an index
+			uint64 used = 0;
+			for(size_t fct = 0; fct < ind.num_fct(); ++fct)
+				for(size_t dof = 0; dof < ind.num_dof(fct); ++dof)
+					used |= vColorMask[ind.index(fct, dof)];
+
+			if(used == allColors) return false;
+
+		//	take the smallest free color
+			size_t c = 0;
+			while(used & ((uint64)1 << c)) ++c;
+
+			for(size_t fct = 0; fct < ind.num_fct(); ++fct)
+				for(size_t dof = 0; dof < ind.num_dof(fct); ++dof)
+					vColorMask[ind.index(fct, dof)] |= ((uint64)1 << c);
+
+			if(c >= vvElem.size()) vvElem.resize(c + 1);
+			vvElem[c].push_back(elem);
+
+		//	create sparsity pattern
+			if(pA != NULL){
+				locA.resize(ind);
+				locA = 0.0;
+				AddLocalMatrixToGlobal(*pA, locA);
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * Assembles the elements of one subset using several threads. The elements
+	 * are colored (see ColorElements) and the elements of one color are
+	 * distributed among the threads. Each thread uses its own DataEvaluator
+	 * and local algebra and adds its contributions to the global algebra
+	 * without locking.
+	 *
+	 * The thread-parallel loop is only used if more than one thread is set
+	 * (SetNumThreads), if it is enabled in the assemble adapter, the default
+	 * local-to-global mapping is used and all element discretizations are
+	 * thread-safe (see IElemDiscBase::thread_safe). Otherwise nothing is
+	 * assembled and false is returned, so that the caller can fall back
+	 * to the serial loop.
+	 *
+	 * \param[in]		op				element operation
+	 * \param[in]		discPart		disc parts needed by the operation
+	 * \param[in]		vElemDisc		element discretizations
+	 * \param[in]		spDomain		domain
+	 * \param[in]		dd				DoF Distribution
+	 * \param[in]		iterBegin		element iterator
+	 * \param[in]		iterEnd			element iterator
+	 * \param[in]		si				subset index
+	 * \param[in]		bNonRegularGrid flag to indicate if non regular grid is used
+	 * \param[in,out]	pA				matrix written by the operation (or NULL)
+	 * \param[in]		spAssTuner		assemble adapter
+	 * \returns			true if the elements have been assembled
+	 */
+	template <typename TElem, typename TIterator, typename TElemOp>
+	static bool
+	AssembleThreaded(const TElemOp& op, int discPart,
+	                 const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+	                 ConstSmartPtr<domain_type> spDomain,
+	                 ConstSmartPtr<DoFDistribution> dd,
+	                 TIterator iterBegin,
+	                 TIterator iterEnd,
+	                 int si, bool bNonRegularGrid,
+	                 matrix_type* pA,
+	                 ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+#ifdef UG_OPENMP
+		const int numThreads = NumThreads();
+		if(numThreads <= 1 || NumActiveThreads() > 1) return false;
+		if(!spAssTuner->threaded_assembling_enabled()
+			|| !spAssTuner->default_mapping_used()
+			|| spAssTuner->single_index_assembling_enabled())
+			return false;
+
+		for(size_t i = 0; i < vElemDisc.size(); ++i)
+			if(!vElemDisc[i]->thread_safe()) return false;
+
+	//	reference object id
+		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+
+	//	one data evaluator per thread. The element loops are prepared serially,
+	//	since this modifies the (shared) element discretizations
+		std::vector<SmartPtr<DataEvaluator<domain_type> > > vEval(numThreads);
+		try
+		{
+			for(int t = 0; t < numThreads; ++t){
+				vEval[t] = make_sp(new DataEvaluator<domain_type>(discPart,
+							vElemDisc, dd->function_pattern(), bNonRegularGrid));
+				vEval[t]->prepare_elem_loop(id, si);
+			}
+		}
+		UG_CATCH_THROW("AssembleThreaded: Cannot create Data Evaluators.");
+
+		std::vector<std::vector<TElem*> > vvElem;
+		bool bThreaded = vEval[0]->thread_safe();
+		if(bThreaded)
+			bThreaded = ColorElements(vvElem, dd, iterBegin, iterEnd,
+			                          vEval[0]->use_hanging(), pA, spAssTuner);
+
+		std::vector<UGError> vError;
+		if(bThreaded)
+		{
+			#pragma omp parallel num_threads(numThreads)
+			{
+				DataEvaluator<domain_type>& Eval = *vEval[ThreadIndex()];
+				ElemLoopData loc;
+				MathVector<domain_type::dim> vCornerCoords[TElem::NUM_VERTICES];
+
+				for(size_t c = 0; c < vvElem.size(); ++c)
+				{
+					const std::vector<TElem*>& vElem = vvElem[c];
+
+				//	elements of one color do not share indices. The implicit
+				//	barrier at the end of the loop separates the colors.
+					#pragma omp for schedule(static)
+					for(long i = 0; i < (long)vElem.size(); ++i)
+					{
+						TElem* elem = vElem[i];
+						try
+						{
+							FillCornerCoordinates(vCornerCoords, *elem, *spDomain);
+							dd->indices(elem, loc.ind, Eval.use_hanging());
+							op(Eval, elem, id, vCornerCoords, loc);
+						}
+						catch(UGError& err)
+						{
+							#pragma omp critical (AssembleThreaded_error)
+							vError.push_back(err);
+						}
+						catch(const std::exception& ex)
+						{
+							#pragma omp critical (AssembleThreaded_error)
+							vError.push_back(UGError("AssembleThreaded: Cannot assemble element.",
+							                         ex, __FILE__, __LINE__));
+						}
+					}
+				}
+			}
+		}
+
+	//	finish element loops
+		try
+		{
+			for(int t = 0; t < numThreads; ++t)
+				vEval[t]->finish_elem_loop();
+		}
+		UG_CATCH_THROW("AssembleThreaded: Cannot finish element loop.");
+
+		if(!vError.empty()){
+			vError[0].push_msg("AssembleThreaded: Cannot assemble element.", __FILE__, __LINE__);
+			throw vError[0];
+		}
+
+		return bThreaded;
+#else
+		return false;
+#endif
+	}
+
 }; // class StdGlobAssembler
 
 } // end namespace ug
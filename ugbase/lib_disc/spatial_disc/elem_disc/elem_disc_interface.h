@@ -750,6 +750,22 @@ class IElemDiscBase
 	 * element assemblings but is needed for finite volumes
 	 */
 		virtual bool use_hanging() const {return false;}
+
+	///	returns if the element-wise assembling functions may be called concurrently
+	/**
+	 * An element discretization is thread-safe, if its element-wise functions
+	 * (prep_elem, add_jac_A_elem, add_def_A_elem, add_rhs_elem, ...) only write
+	 * to the passed local algebra and do not modify members of the
+	 * discretization or of its imports. If all element discretizations of a
+	 * subset are thread-safe, the elements may be assembled by several threads.
+	 * Note that prep_elem_loop and fsh_elem_loop are then called once per thread,
+	 * but serially before and after the threaded loop. Per-element state, e.g.
+	 * the finite volume geometry, must be held once per thread (see
+	 * GeomProvider::get_for_thread). The default is
+	 * false, i.e. serial assembling. Discretizations which fulfill these
+	 * requirements override this method.
+	 */
+		virtual bool thread_safe() const {return false;}
 };
 
 
@@ -33,6 +33,7 @@
 #include "neumann_boundary_fv1.h"
 #include "lib_disc/spatial_disc/disc_util/fv1_geom.h"
 #include "lib_disc/spatial_disc/disc_util/geom_provider.h"
+#include "common/util/thread_util.h"
 
 namespace ug{
 
@@ -86,6 +87,21 @@ add(SmartPtr<CplUserData<MathVector<dim>, dim> > user, const char* BndSubsets, c
 	this->add_inner_subsets(InnerSubsets);
 }
 
+template<typename TDomain>
+bool NeumannBoundaryFV1<TDomain>::thread_safe() const
+{
+//	non-constant number data is evaluated through the (shared) imports. The
+//	other data is evaluated directly by the element functions, which is only
+//	known to be free of shared state for constant data.
+	for(size_t i = 0; i < m_vNumberData.size(); ++i)
+		if(!m_vNumberData[i].import.constant()) return false;
+	for(size_t i = 0; i < m_vBNDNumberData.size(); ++i)
+		if(!m_vBNDNumberData[i].functor->constant()) return false;
+	for(size_t i = 0; i < m_vVectorData.size(); ++i)
+		if(!m_vVectorData[i].functor->constant()) return false;
+	return true;
+}
+
 template<typename TDomain>
 void NeumannBoundaryFV1<TDomain>::update_subset_groups()
 {
@@ -109,31 +125,36 @@ prep_elem_loop(const ReferenceObjectID roid, const int si)
 	update_subset_groups();
 	m_si = si;
 
-//	register subsetIndex at Geometry
-	static TFVGeom& geo = GeomProvider<TFVGeom >::get();
+//	register subsetIndex at the geometries of all threads
+	const int numThreads = NumThreads();
+	GeomProvider<TFVGeom>::create_thread_instances(numThreads);
+	for(int t = 0; t < numThreads; ++t)
+	{
+		TFVGeom& geo = GeomProvider<TFVGeom>::get_for_thread(t);
 
-//	request subset indices as boundary subset. This will force the
-//	creation of boundary subsets when calling geo.update
+	//	request subset indices as boundary subset. This will force the
+	//	creation of boundary subsets when calling geo.update
 
-	for(size_t i = 0; i < m_vNumberData.size(); ++i){
-		if(!m_vNumberData[i].InnerSSGrp.contains(m_si)) continue;
-		for(size_t s = 0; s < m_vNumberData[i].BndSSGrp.size(); ++s){
-			const int si = m_vNumberData[i].BndSSGrp[s];
-			geo.add_boundary_subset(si);
+		for(size_t i = 0; i < m_vNumberData.size(); ++i){
+			if(!m_vNumberData[i].InnerSSGrp.contains(m_si)) continue;
+			for(size_t s = 0; s < m_vNumberData[i].BndSSGrp.size(); ++s){
+				const int si = m_vNumberData[i].BndSSGrp[s];
+				geo.add_boundary_subset(si);
+			}
 		}
-	}
-	for(size_t i = 0; i < m_vBNDNumberData.size(); ++i){
-		if(!m_vBNDNumberData[i].InnerSSGrp.contains(m_si)) continue;
-		for(size_t s = 0; s < m_vBNDNumberData[i].BndSSGrp.size(); ++s){
-			const int si = m_vBNDNumberData[i].BndSSGrp[s];
-			geo.add_boundary_subset(si);
+		for(size_t i = 0; i < m_vBNDNumberData.size(); ++i){
+			if(!m_vBNDNumberData[i].InnerSSGrp.contains(m_si)) continue;
+			for(size_t s = 0; s < m_vBNDNumberData[i].BndSSGrp.size(); ++s){
+				const int si = m_vBNDNumberData[i].BndSSGrp[s];
+				geo.add_boundary_subset(si);
+			}
 		}
-	}
-	for(size_t i = 0; i < m_vVectorData.size(); ++i){
-		if(!m_vVectorData[i].InnerSSGrp.contains(m_si)) continue;
-		for(size_t s = 0; s < m_vVectorData[i].BndSSGrp.size(); ++s){
-			const int si = m_vVectorData[i].BndSSGrp[s];
-			geo.add_boundary_subset(si);
+		for(size_t i = 0; i < m_vVectorData.size(); ++i){
+			if(!m_vVectorData[i].InnerSSGrp.contains(m_si)) continue;
+			for(size_t s = 0; s < m_vVectorData[i].BndSSGrp.size(); ++s){
+				const int si = m_vVectorData[i].BndSSGrp[s];
+				geo.add_boundary_subset(si);
+			}
 		}
 	}
 
@@ -146,6 +167,8 @@ prep_elem_loop(const ReferenceObjectID roid, const int si)
 	for(size_t data = 0; data < m_vNumberData.size(); ++data)
 	{
 		if(!m_vNumberData[data].InnerSSGrp.contains(m_si)) continue;
+	//	constant data is evaluated directly in add_rhs_elem
+		if(m_vNumberData[data].import.constant()) continue;
 		m_vNumberData[data].import.set_fct(id,
 		                                   &m_vNumberData[data],
 		                                   &NumberData::template lin_def<TElem, TFVGeom>);
@@ -161,7 +184,7 @@ void NeumannBoundaryFV1<TDomain>::
 prep_elem(const LocalVector& u, GridObject* elem, const ReferenceObjectID roid, const MathVector<dim> vCornerCoords[])
 {
 //  update Geometry for this element
-	static TFVGeom& geo = GeomProvider<TFVGeom >::get();
+	TFVGeom& geo = GeomProvider<TFVGeom>::get_for_thread(ThreadIndex());
 	try{
 		geo.update(elem, vCornerCoords, &(this->subset_handler()));
 	}
@@ -169,7 +192,8 @@ prep_elem(const LocalVector& u, GridObject* elem, const ReferenceObjectID roid,
 						"Cannot update Finite Volume Geometry.");
 
 	for(size_t i = 0; i < m_vNumberData.size(); ++i)
-		if(m_vNumberData[i].InnerSSGrp.contains(m_si))
+		if(m_vNumberData[i].InnerSSGrp.contains(m_si)
+			&& !m_vNumberData[i].import.constant())
 			m_vNumberData[i].template extract_bip<TElem, TFVGeom>(geo);
 }
 
@@ -178,12 +202,20 @@ template<typename TElem, typename TFVGeom>
 void NeumannBoundaryFV1<TDomain>::
 add_rhs_elem(LocalVector& d, GridObject* elem, const MathVector<dim> vCornerCoords[])
 {
-	const static TFVGeom& geo = GeomProvider<TFVGeom >::get();
+	const TFVGeom& geo = GeomProvider<TFVGeom>::get_for_thread(ThreadIndex());
 	typedef typename TFVGeom::BF BF;
 
 //	Number Data
 	for(size_t data = 0; data < m_vNumberData.size(); ++data){
 		if(!m_vNumberData[data].InnerSSGrp.contains(m_si)) continue;
+
+	//	constant data is not evaluated through the import
+		const bool bConst = m_vNumberData[data].import.constant();
+		number constVal = 0.0;
+		if(bConst)
+			(*m_vNumberData[data].import.user_data())(constVal, MathVector<dim>(0.0),
+			                                           this->time(), m_si);
+
 		size_t ip = 0;
 		for(size_t s = 0; s < m_vNumberData[data].BndSSGrp.size(); ++s){
 			const int si = m_vNumberData[data].BndSSGrp[s];
@@ -191,7 +223,7 @@ add_rhs_elem(LocalVector& d, GridObject* elem, const MathVector<dim> vCornerCoor
 
 			for(size_t i = 0; i < vBF.size(); ++i, ++ip){
 				const int co = vBF[i].node_id();
-				d(_C_, co) -= m_vNumberData[data].import[ip]
+				d(_C_, co) -= (bConst ? constVal : m_vNumberData[data].import[ip])
 				                                    * vBF[i].volume();
 			}
 		}
@@ -238,37 +270,41 @@ template<typename TElem, typename TGeom>
 void NeumannBoundaryFV1<TDomain>::
 fsh_elem_loop()
 {
-//	remove subsetIndex from Geometry
-	static TGeom& geo = GeomProvider<TGeom >::get();
-
+//	remove subsetIndex from the geometries of all threads
+	const int numThreads = NumThreads();
+	GeomProvider<TGeom>::create_thread_instances(numThreads);
+	for(int t = 0; t < numThreads; ++t)
+	{
+		TGeom& geo = GeomProvider<TGeom>::get_for_thread(t);
 
-//	unrequest subset indices as boundary subset. This will force the
-//	creation of boundary subsets when calling geo.update
+	//	unrequest subset indices as boundary subset. This will force the
+	//	creation of boundary subsets when calling geo.update
 
-	for(size_t i = 0; i < m_vNumberData.size(); ++i){
-		if(!m_vNumberData[i].InnerSSGrp.contains(m_si)) continue;
-		for(size_t s = 0; s < m_vNumberData[i].BndSSGrp.size(); ++s){
-			const int si = m_vNumberData[i].BndSSGrp[s];
-			geo.remove_boundary_subset(si);
-			geo.reset_curr_elem();
+		for(size_t i = 0; i < m_vNumberData.size(); ++i){
+			if(!m_vNumberData[i].InnerSSGrp.contains(m_si)) continue;
+			for(size_t s = 0; s < m_vNumberData[i].BndSSGrp.size(); ++s){
+				const int si = m_vNumberData[i].BndSSGrp[s];
+				geo.remove_boundary_subset(si);
+				geo.reset_curr_elem();
+			}
 		}
-	}
 
-	for(size_t i = 0; i < m_vBNDNumberData.size(); ++i){
-		if(!m_vBNDNumberData[i].InnerSSGrp.contains(m_si)) continue;
-		for(size_t s = 0; s < m_vBNDNumberData[i].BndSSGrp.size(); ++s){
-			const int si = m_vBNDNumberData[i].BndSSGrp[s];
-			geo.remove_boundary_subset(si);
-			geo.reset_curr_elem();
+		for(size_t i = 0; i < m_vBNDNumberData.size(); ++i){
+			if(!m_vBNDNumberData[i].InnerSSGrp.contains(m_si)) continue;
+			for(size_t s = 0; s < m_vBNDNumberData[i].BndSSGrp.size(); ++s){
+				const int si = m_vBNDNumberData[i].BndSSGrp[s];
+				geo.remove_boundary_subset(si);
+				geo.reset_curr_elem();
+			}
 		}
-	}
 
-	for(size_t i = 0; i < m_vVectorData.size(); ++i){
-		if(!m_vVectorData[i].InnerSSGrp.contains(m_si)) continue;
-		for(size_t s = 0; s < m_vVectorData[i].BndSSGrp.size(); ++s){
-			const int si = m_vVectorData[i].BndSSGrp[s];
-			geo.remove_boundary_subset(si);
-			geo.reset_curr_elem();
+		for(size_t i = 0; i < m_vVectorData.size(); ++i){
+			if(!m_vVectorData[i].InnerSSGrp.contains(m_si)) continue;
+			for(size_t s = 0; s < m_vVectorData[i].BndSSGrp.size(); ++s){
+				const int si = m_vVectorData[i].BndSSGrp[s];
+				geo.remove_boundary_subset(si);
+				geo.reset_curr_elem();
+			}
 		}
 	}
 }
@@ -142,6 +142,11 @@ class NeumannBoundaryFV1
 	///	type of trial space for each function used
 		virtual void prepare_setting(const std::vector<LFEID>& vLfeID, bool bNonRegularGrid);
 
+	///	returns true if only constant data is used
+	/**	The finite volume geometry is held once per thread, the values of
+	 * constant data are evaluated directly (see IElemDiscBase::thread_safe).*/
+		virtual bool thread_safe() const;
+
 	protected:
 	///	assembling functions for fv1
 	///	\{
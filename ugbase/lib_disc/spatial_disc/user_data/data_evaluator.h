@@ -76,6 +76,14 @@ class DataEvaluatorBase
 	///	returns if one of the element discs needs hanging dofs
 		bool use_hanging() const {return m_bUseHanging;}
 
+	///	returns if several evaluators may process the same elem discs concurrently
+	/**
+	 * This is the case if all elem discs are thread-safe and no user data must
+	 * be evaluated per element (i.e. only constant data is connected to the
+	 * imports). Must be called after the element loop has been prepared.
+	 */
+		bool thread_safe() const;
+
 		
 
 	///	prepares the element loop for all IElemDiscs for the computation of the error estimator
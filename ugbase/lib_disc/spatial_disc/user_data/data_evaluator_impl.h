@@ -277,6 +277,21 @@ void DataEvaluatorBase<TDomain, TElemDisc>::extract_imports_and_userdata(int sub
 		m_vDependentData[i]->set_subset(subsetIndex);
 }
 
+template <typename TDomain, typename TElemDisc>
+bool DataEvaluatorBase<TDomain, TElemDisc>::thread_safe() const
+{
+	for(size_t i = 0; i < m_vElemDisc[PT_ALL].size(); ++i)
+		if(!m_vElemDisc[PT_ALL][i]->thread_safe()) return false;
+
+//	position dependent data, dependent data and linearized imports store
+//	their values in the (shared) data objects
+	if(!m_vPosData.empty() || !m_vDependentData.empty()) return false;
+	for(int part = 0; part < MAX_PART; ++part)
+		if(!m_vImport[PT_ALL][part].empty()) return false;
+
+	return true;
+}
+
 template <typename TDomain, typename TElemDisc>
 void DataEvaluatorBase<TDomain, TElemDisc>::clear_extracted_data_and_mappings()
 {
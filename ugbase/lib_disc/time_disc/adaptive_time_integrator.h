@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__TIME_DISC__ADAPTIVE_TIME_INTEGRATOR__
+#define __H__UG__LIB_DISC__TIME_DISC__ADAPTIVE_TIME_INTEGRATOR__
+
+// extern libraries
+#include <string>
+#include <vector>
+
+// other ug libraries
+#include "common/common.h"
+#include "lib_algebra/operator/interface/operator_inverse.h"
+
+// modul intern libraries
+#include "lib_disc/time_disc/theta_time_step.h"
+#include "lib_disc/time_disc/solution_time_series.h"
+
+namespace ug{
+
+/// \ingroup lib_disc_time_assemble
+/// @{
+
+/// time integrator with adaptive step size control
+/**
+ * This class integrates a time dependent problem from a start time to an end
+ * time, choosing the time step sizes such that the estimated local error per
+ * step stays below the tolerance
+ * \f[
+ * 	\| e \|_\infty \leq atol + rtol \cdot \| u \|_\infty.
+ * \f]
+ * Supported time discretizations are
+ * <ul>
+ * <li> SDIRK of order 2 - 4: the error is estimated by an embedded method of
+ * 		one order less, computed from the stage solutions only.
+ * <li> BDF of order 1 - 6 with variable step sizes: the error is estimated by
+ * 		the difference to the polynomial predictor, which is also used as
+ * 		starting value. The order is increased during the first steps.
+ * </ul>
+ * The step size is chosen by a PI controller. If the error is too large or
+ * the solver fails, the step is repeated with a smaller step size. The
+ * solver (usually a NewtonSolver operating on an AssembledOperator of the
+ * time discretization) must be initialized before and is reused for all
+ * steps and retries.
+ */
+template <typename TAlgebra>
+class AdaptiveTimeIntegrator
+{
+	public:
+	/// Type of algebra
+		typedef TAlgebra algebra_type;
+
+	/// Type of algebra vector
+		typedef typename algebra_type::vector_type vector_type;
+
+	///	Type of time discretization
+		typedef MultiStepTimeDiscretization<TAlgebra> time_disc_type;
+
+	///	Type of solver
+		typedef IOperatorInverse<vector_type> solver_type;
+
+	public:
+	///	constructor
+		AdaptiveTimeIntegrator(SmartPtr<time_disc_type> spTimeDisc,
+		                       SmartPtr<solver_type> spSolver);
+
+		virtual ~AdaptiveTimeIntegrator() {}
+
+	///	sets the relative and absolute tolerance for the local error
+		void set_tolerance(number rtol, number atol) {m_rtol = rtol; m_atol = atol;}
+
+	///	sets the minimal and maximal step size
+		void set_dt_bounds(number dtMin, number dtMax) {m_dtMin = dtMin; m_dtMax = dtMax;}
+
+	///	sets the initial step size (default: 1e-3 of the time interval)
+		void set_initial_dt(number dt) {m_dtInit = dt;}
+
+	///	sets the bounds for the step size change factor
+		void set_factor_bounds(number facMin, number facMax) {m_facMin = facMin; m_facMax = facMax;}
+
+	///	sets the safety factor of the step size controller
+		void set_safety_factor(number safety) {m_safety = safety;}
+
+	///	sets the maximal number of consecutive retries of a step
+		void set_max_retries(size_t maxRetries) {m_maxRetries = maxRetries;}
+
+	///	if enabled, finish_step of the time disc is called after each accepted step
+		void set_finish_time_step(bool bFinish) {m_bFinishTimeStep = bFinish;}
+
+	///	integrates from t0 to tEnd, u holds start value and result
+	/**
+	 * \returns true if the end time was reached, false if the step size
+	 * dropped below the minimal step size or too many retries occurred
+	 */
+		bool apply(vector_type& u, number t0, number tEnd);
+
+	///	returns the time reached by the last call of apply
+		number time() const {return m_time;}
+
+	///	returns the step size proposed for the next step
+		number dt() const {return m_dt;}
+
+	///	returns the number of accepted steps
+		size_t num_accepted_steps() const {return m_numAccepted;}
+
+	///	returns the number of steps rejected due to the error estimate
+		size_t num_rejected_steps() const {return m_numRejected;}
+
+	///	returns the number of steps rejected due to a failing solver
+		size_t num_solver_failures() const {return m_numSolverFailures;}
+
+	///	returns the number of calls of the solver
+		size_t num_solves() const {return m_numSolves;}
+
+	///	resets the statistics
+		void clear_statistics();
+
+	///	prints the statistics
+		void print_statistics() const;
+
+	///	returns information about configuration parameters
+		std::string config_string() const;
+
+	protected:
+	///	performs a SDIRK step, returns false if the solver failed
+		bool sdirk_step(SDIRK<TAlgebra>& sdirk, vector_type& u, number dt,
+		                number& err, number& errOrder);
+
+	///	performs a BDF step, returns false if the solver failed
+		bool bdf_step(BDF<TAlgebra>& bdf, vector_type& u, number dt,
+		              number& err, number& errOrder);
+
+	///	solves for the current stage, returns false if the solver failed
+		bool solve(vector_type& u);
+
+	///	returns the scaled norm of the error estimate
+		number error_norm(const vector_type& e, const vector_type& u) const;
+
+	protected:
+		SmartPtr<time_disc_type> m_spTimeDisc;		///< time discretization
+		SmartPtr<solver_type> m_spSolver;			///< (non-linear) solver
+
+		SmartPtr<VectorTimeSeries<vector_type> > m_spSolTimeSeries; ///< accepted solutions
+		size_t m_bdfOrder;							///< target order of BDF
+
+		number m_rtol;				///< relative tolerance
+		number m_atol;				///< absolute tolerance
+		number m_dtMin;				///< minimal step size
+		number m_dtMax;				///< maximal step size
+		number m_dtInit;			///< initial step size
+		number m_facMin;			///< minimal step size change
+		number m_facMax;			///< maximal step size change
+		number m_safety;			///< safety factor
+		size_t m_maxRetries;		///< maximal number of consecutive retries
+		bool m_bFinishTimeStep;		///< call finish_step after accepted steps
+
+		number m_time;				///< current time
+		number m_dt;				///< proposed step size
+
+		size_t m_numAccepted;		///< number of accepted steps
+		size_t m_numRejected;		///< number of rejected steps
+		size_t m_numSolverFailures;	///< number of failed solver calls
+		size_t m_numSolves;			///< number of solver calls
+};
+
+/// @}
+
+} // end namespace ug
+
+// include implementation
+#include "adaptive_time_integrator_impl.h"
+
+#endif /* __H__UG__LIB_DISC__TIME_DISC__ADAPTIVE_TIME_INTEGRATOR__ */
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__TIME_DISC__ADAPTIVE_TIME_INTEGRATOR_IMPL__
+#define __H__UG__LIB_DISC__TIME_DISC__ADAPTIVE_TIME_INTEGRATOR_IMPL__
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "adaptive_time_integrator.h"
+
+namespace ug{
+
+template <typename TAlgebra>
+AdaptiveTimeIntegrator<TAlgebra>::
+AdaptiveTimeIntegrator(SmartPtr<time_disc_type> spTimeDisc,
+                       SmartPtr<solver_type> spSolver)
+	: m_spTimeDisc(spTimeDisc), m_spSolver(spSolver), m_bdfOrder(1),
+	  m_rtol(1e-3), m_atol(1e-6),
+	  m_dtMin(1e-12), m_dtMax(1e100), m_dtInit(-1.0),
+	  m_facMin(0.2), m_facMax(5.0), m_safety(0.9),
+	  m_maxRetries(10), m_bFinishTimeStep(false),
+	  m_time(0.0), m_dt(0.0)
+{
+	if(m_spTimeDisc.invalid())
+		UG_THROW("AdaptiveTimeIntegrator: Time discretization missing.");
+	if(m_spSolver.invalid())
+		UG_THROW("AdaptiveTimeIntegrator: Solver missing.");
+
+	clear_statistics();
+}
+
+template <typename TAlgebra>
+void AdaptiveTimeIntegrator<TAlgebra>::clear_statistics()
+{
+	m_numAccepted = 0;
+	m_numRejected = 0;
+	m_numSolverFailures = 0;
+	m_numSolves = 0;
+}
+
+template <typename TAlgebra>
+bool AdaptiveTimeIntegrator<TAlgebra>::
+apply(vector_type& u, number t0, number tEnd)
+{
+	PROFILE_BEGIN_GROUP(AdaptiveTimeIntegrator_apply, "discretization AdaptiveTimeIntegrator");
+
+//	get the scheme
+	SDIRK<TAlgebra>* pSDIRK = dynamic_cast<SDIRK<TAlgebra>*>(m_spTimeDisc.get());
+	BDF<TAlgebra>* pBDF = dynamic_cast<BDF<TAlgebra>*>(m_spTimeDisc.get());
+	if(pSDIRK != NULL)
+	{
+		if(!pSDIRK->has_embedded_error())
+			UG_THROW("AdaptiveTimeIntegrator: SDIRK of order "<<pSDIRK->order()
+					<<" has no embedded error estimator, use order 2 - 4.");
+	}
+	else if(pBDF != NULL)
+	{
+		m_bdfOrder = pBDF->order();
+		if(m_bdfOrder == 0)
+			UG_THROW("AdaptiveTimeIntegrator: BDF order must be at least 1.");
+	}
+	else
+		UG_THROW("AdaptiveTimeIntegrator: Only SDIRK and BDF are supported.");
+
+	if(!(tEnd > t0))
+		UG_THROW("AdaptiveTimeIntegrator: End time "<<tEnd<<" must be greater"
+				" than start time "<<t0<<".");
+
+//	start value
+	m_spSolTimeSeries = make_sp(new VectorTimeSeries<vector_type>);
+	m_spSolTimeSeries->push(u.clone(), t0);
+
+	m_time = t0;
+	m_dt = (m_dtInit > 0) ? m_dtInit : 1e-3 * (tEnd - t0);
+	m_dt = std::min(std::max(m_dt, m_dtMin), m_dtMax);
+
+	const number tEps = 1e-10 * (tEnd - t0);
+	number errPrev = 1.0;
+	size_t numRetries = 0;
+
+	while(m_time < tEnd - tEps)
+	{
+	//	do not step beyond the end time
+		const number dt = (m_time + m_dt > tEnd - tEps) ? tEnd - m_time : m_dt;
+
+		number err = 0.0, errOrder = 1.0;
+		const bool bSolved = (pSDIRK != NULL)
+							? sdirk_step(*pSDIRK, u, dt, err, errOrder)
+							: bdf_step(*pBDF, u, dt, err, errOrder);
+
+		if(bSolved && err <= 1.0)
+		{
+		//	accept step
+			m_time = m_spTimeDisc->future_time();
+			m_spSolTimeSeries->push(u.clone(), m_time);
+			const size_t numKeep = (pBDF != NULL) ? m_bdfOrder + 1 : 1;
+			while(m_spSolTimeSeries->size() > numKeep)
+				m_spSolTimeSeries->remove_oldest();
+
+			if(m_bFinishTimeStep)
+			{
+				try{
+					m_spTimeDisc->finish_step(m_spSolTimeSeries);
+				}UG_CATCH_THROW("AdaptiveTimeIntegrator: Cannot finish time step.");
+			}
+
+		//	PI controller
+			const number errCur = std::max(err, (number)1e-10);
+			number fac = m_safety * std::pow(errCur, -0.7 / errOrder)
+								  * std::pow(errPrev, 0.4 / errOrder);
+			fac = std::min(std::max(fac, m_facMin), m_facMax);
+			m_dt = std::min(dt * fac, m_dtMax);
+			errPrev = errCur;
+
+			++m_numAccepted;
+			numRetries = 0;
+		}
+		else
+		{
+		//	reject step and restore the last accepted solution
+			VecAssign(u, *m_spSolTimeSeries->latest());
+
+			number fac = 0.5;
+			if(bSolved)
+			{
+				++m_numRejected;
+				fac = std::max(m_safety * std::pow(err, -1.0 / errOrder), m_facMin);
+			}
+			else
+				++m_numSolverFailures;
+
+			if(++numRetries > m_maxRetries || dt * fac < m_dtMin)
+			{
+				UG_LOG("AdaptiveTimeIntegrator: Step at time "<<m_time<<" with"
+						" step size "<<dt<<" failed "<<numRetries<<" times,"
+						" aborting.\n");
+				m_dt = dt * fac;
+				return false;
+			}
+			m_dt = dt * fac;
+		}
+	}
+
+	return true;
+}
+
+template <typename TAlgebra>
+bool AdaptiveTimeIntegrator<TAlgebra>::
+sdirk_step(SDIRK<TAlgebra>& sdirk, vector_type& u, number dt,
+           number& err, number& errOrder)
+{
+//	the stages only need the preceding stage solution
+	SmartPtr<VectorTimeSeries<vector_type> > spStageSol
+		= make_sp(new VectorTimeSeries<vector_type>);
+	spStageSol->push(m_spSolTimeSeries->latest(), m_time);
+
+	std::vector<SmartPtr<vector_type> > vStageSol(1, m_spSolTimeSeries->latest());
+	for(size_t stage = 1; stage <= sdirk.num_stages(); ++stage)
+	{
+		sdirk.set_stage(stage);
+		try{
+			sdirk.prepare_step(spStageSol, dt);
+		}UG_CATCH_THROW("AdaptiveTimeIntegrator: Cannot prepare stage "<<stage<<".");
+
+		if(!solve(u)) return false;
+
+		SmartPtr<vector_type> spStage = u.clone();
+		spStageSol->push(spStage, sdirk.future_time());
+		vStageSol.push_back(spStage);
+	}
+
+//	estimate error by embedded method
+	SmartPtr<vector_type> spErr = u.clone_without_values();
+	sdirk.embedded_error(*spErr, vStageSol);
+
+	err = error_norm(*spErr, u);
+	errOrder = sdirk.order();
+	return true;
+}
+
+template <typename TAlgebra>
+bool AdaptiveTimeIntegrator<TAlgebra>::
+bdf_step(BDF<TAlgebra>& bdf, vector_type& u, number dt,
+         number& err, number& errOrder)
+{
+//	the predictor needs order + 1 solutions, increase the order during start
+	const size_t numSol = m_spSolTimeSeries->size();
+	const size_t order = std::max((size_t)1, std::min(m_bdfOrder, numSol - 1));
+	const size_t numPred = std::min(order + 1, numSol);
+
+	bdf.set_order(order);
+	try{
+		bdf.prepare_step(m_spSolTimeSeries, dt);
+	}UG_CATCH_THROW("AdaptiveTimeIntegrator: Cannot prepare time step.");
+	const number tNew = bdf.future_time();
+
+//	predictor: extrapolation of the previous solutions to the new time
+	SmartPtr<vector_type> spPred = u.clone_without_values();
+	for(size_t i = 0; i < numPred; ++i)
+	{
+		number w = 1.0;
+		for(size_t j = 0; j < numPred; ++j)
+			if(j != i)
+				w *= (tNew - m_spSolTimeSeries->time(j))
+					/ (m_spSolTimeSeries->time(i) - m_spSolTimeSeries->time(j));
+
+		if(i == 0) VecScaleAssign(*spPred, w, *m_spSolTimeSeries->solution(0));
+		else VecScaleAdd(*spPred, 1.0, *spPred, w, *m_spSolTimeSeries->solution(i));
+	}
+
+//	solve starting from the predictor
+	VecAssign(u, *spPred);
+	if(!solve(u)) return false;
+
+//	estimate error by the difference to the predictor
+	const number scale = dt / (tNew - m_spSolTimeSeries->time(numPred-1));
+	VecScaleAdd(*spPred, scale, u, -scale, *spPred);
+
+	err = error_norm(*spPred, u);
+	errOrder = numPred;
+	return true;
+}
+
+template <typename TAlgebra>
+bool AdaptiveTimeIntegrator<TAlgebra>::solve(vector_type& u)
+{
+	++m_numSolves;
+	if(!m_spSolver->prepare(u)) return false;
+	return m_spSolver->apply(u);
+}
+
+template <typename TAlgebra>
+number AdaptiveTimeIntegrator<TAlgebra>::
+error_norm(const vector_type& e, const vector_type& u) const
+{
+	return e.maxnorm() / (m_atol + m_rtol * u.maxnorm());
+}
+
+template <typename TAlgebra>
+void AdaptiveTimeIntegrator<TAlgebra>::print_statistics() const
+{
+	UG_LOG("AdaptiveTimeIntegrator: " << m_numAccepted << " accepted steps, "
+			<< m_numRejected << " rejected steps, " << m_numSolverFailures
+			<< " solver failures, " << m_numSolves << " solver calls.\n");
+}
+
+template <typename TAlgebra>
+std::string AdaptiveTimeIntegrator<TAlgebra>::config_string() const
+{
+	std::stringstream ss;
+	ss << "AdaptiveTimeIntegrator( rtol = " << m_rtol << ", atol = " << m_atol
+	   << ", dt in [" << m_dtMin << ", " << m_dtMax << "], factor in ["
+	   << m_facMin << ", " << m_facMax << "], safety = " << m_safety << ")\n"
+	   << " Solver: " << ConfigShift(m_spSolver->config_string());
+	return ss.str();
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__TIME_DISC__ADAPTIVE_TIME_INTEGRATOR_IMPL__ */
@@ -42,6 +42,8 @@
 
 // modul intern libraries
 #include "lib_disc/time_disc/time_disc_interface.h"
+#include "lib_disc/common/revision_counter.h"
+#include "lib_algebra/algebra_common/sparsematrix_util.h"
 #include "lib_disc/local_finite_element/common/lagrange1d.h"
 
 namespace ug{
@@ -71,7 +73,9 @@ class MultiStepTimeDiscretization
 	/// constructor
 		MultiStepTimeDiscretization(SmartPtr<IDomainDiscretization<algebra_type> > spDD)
 			: ITimeDiscretization<TAlgebra>(spDD),
-			  m_pPrevSol(NULL)
+			  m_pPrevSol(NULL),
+			  m_bCachedSplitting(false), m_bMatrixReused(false),
+			  m_pCachedSystem(NULL), m_cachedScaleStiff(0.0)
 		{}
 
 		virtual ~MultiStepTimeDiscretization(){};
@@ -109,6 +113,31 @@ class MultiStepTimeDiscretization
 
 		void adjust_solution(vector_type& u, const GridLevel& gl);
 
+	///	enables the cached operator splitting for linear problems (disabled by default)
+	/**
+	 * If enabled, assemble_linear assembles the mass matrix M and the
+	 * stiffness matrix K once and forms the system matrix as M + s_a K in
+	 * each time step, such that only the right-hand side is assembled
+	 * element-wise. If neither the step size nor the passed matrix change,
+	 * the system matrix is left untouched (see system_matrix_reused), so that
+	 * the solver may keep its preconditioner. The matrix must therefore not
+	 * be changed in between, except by assemble_jacobian or assemble_linear
+	 * of this time discretization.
+	 *
+	 * This is only valid for linear problems with time independent
+	 * coefficients. The matrices are reassembled if the revision of the
+	 * domain discretization changes (e.g. after grid adaption).
+	 */
+		void enable_cached_splitting(bool enable)
+		{
+			m_bCachedSplitting = enable;
+			m_CacheRevision.invalidate();
+			m_pCachedSystem = NULL;
+		}
+
+	///	returns if the last call of assemble_linear left the system matrix unchanged
+		bool system_matrix_reused() const {return m_bMatrixReused;}
+
 	///////////////////////////////////////////////////////////////////
 	/// Error estimator												///
 
@@ -141,6 +170,20 @@ class MultiStepTimeDiscretization
 		SmartPtr<VectorTimeSeries<vector_type> > m_pPrevSol;	///< Previous solutions
 		number m_dt; 								///< Time Step size
 		number m_futureTime;						///< Future Time
+
+	protected:
+	///	assembles the linear system from the cached mass and stiffness matrix
+		void assemble_linear_cached(matrix_type& A, vector_type& b, const GridLevel& gl);
+
+		bool m_bCachedSplitting;				///< use cached mass/stiffness matrix
+		bool m_bMatrixReused;					///< system matrix unchanged in last assemble_linear
+		matrix_type m_M;						///< cached mass matrix
+		matrix_type m_K;						///< cached stiffness matrix
+		RevisionCounter m_CacheRevision;		///< revision of domain disc for cached matrices
+		GridLevel m_CacheGridLevel;				///< grid level of cached matrices
+		const matrix_type* m_pCachedSystem;		///< system matrix assembled last
+		RevisionCounter m_SystemRevision;		///< revision of domain disc for m_pCachedSystem
+		number m_cachedScaleStiff;				///< stiffness scaling of m_pCachedSystem
 };
 
 /// theta time stepping scheme
@@ -329,6 +372,9 @@ class BDF
 	///	sets the theta value
 		void set_order(size_t order) {m_order = order; this->m_prevSteps = order;}
 
+	///	returns the order
+		size_t order() const {return m_order;}
+
 	///	returns the number of stages
 		virtual size_t num_stages() const {return 1;}
 
@@ -430,7 +476,7 @@ class SDIRK
 	/// theta = 1.0 -> Implicit Euler, 0.0 -> Explicit Euler
 		SDIRK(SmartPtr<IDomainDiscretization<TAlgebra> > spDD, int order)
 			: MultiStepTimeDiscretization<TAlgebra>(spDD),
-			  m_order(order)
+			  m_stage(1), m_order(order)
 		{
 			set_order(m_order);
 			this->m_prevSteps = 1;
@@ -444,6 +490,9 @@ class SDIRK
 			m_order = order;
 		}
 
+	///	returns the order
+		int order() const {return m_order;}
+
 	///	returns number of stages
 		virtual size_t num_stages() const {
 			switch(m_order){
@@ -458,6 +507,21 @@ class SDIRK
 	///	sets the stage
 		virtual void set_stage(size_t stage);
 
+	///	returns if the scheme has an embedded method of order - 1
+		bool has_embedded_error() const {return m_order >= 2;}
+
+	///	computes the difference to the embedded solution of order - 1
+	/**
+	 * The stage increments are recovered from the stage solutions, such that
+	 * the difference between the solution and the embedded lower order
+	 * solution can be computed without further assembling.
+	 *
+	 * \param[out]	err			error estimate
+	 * \param[in]	vStageSol	start value (index 0) and solutions of all stages
+	 */
+		void embedded_error(vector_type& err,
+		                    const std::vector<SmartPtr<vector_type> >& vStageSol);
+
 	public:
 		virtual void prepare_step(SmartPtr<VectorTimeSeries<vector_type> > prevSol,
 								  number dt);
@@ -136,6 +136,10 @@ assemble_jacobian(matrix_type& J, const vector_type& u, const GridLevel& gl)
 
 //	pop unknown solution to solution time series
 	m_pPrevSol->remove_latest();
+
+//	J may be the matrix holding the cached system
+	if(m_pCachedSystem == &J)
+		m_pCachedSystem = NULL;
 }
 
 template <typename TAlgebra>
@@ -190,6 +194,13 @@ assemble_linear(matrix_type& A, vector_type& b, const GridLevel& gl)
 				" Number of previous solutions must be at least "<<
 				m_prevSteps <<", but only "<< m_pPrevSol->size() << " passed.");
 
+//	use cached operator splitting (only valid for unscaled mass part)
+	m_bMatrixReused = false;
+	if(m_bCachedSplitting && m_vScaleMass[0] == 1.0)
+	{
+		assemble_linear_cached(A, b, gl);
+		return;
+	}
 
 //	push unknown solution to solution time series (not used, but formally needed)
 	m_pPrevSol->push(m_pPrevSol->latest(), m_futureTime);
@@ -201,6 +212,51 @@ assemble_linear(matrix_type& A, vector_type& b, const GridLevel& gl)
 
 //	pop unknown solution from solution time series
 	m_pPrevSol->remove_latest();
+	m_pCachedSystem = NULL;
+}
+
+template <typename TAlgebra>
+void MultiStepTimeDiscretization<TAlgebra>::
+assemble_linear_cached(matrix_type& A, vector_type& b, const GridLevel& gl)
+{
+	PROFILE_BEGIN_GROUP(MultiStepTimeDiscretization_assemble_linear_cached, "discretization MultiStepTimeDiscretization");
+
+//	reassemble mass and stiffness matrix if grid or discretization changed
+	const RevisionCounter rev = this->m_spDomDisc->revision();
+	if(m_CacheRevision != rev || m_CacheGridLevel != gl)
+	{
+		const vector_type& u = *m_pPrevSol->latest();
+		try{
+			this->m_spDomDisc->assemble_mass_matrix(m_M, u, gl);
+			this->m_spDomDisc->assemble_stiffness_matrix(m_K, u, gl);
+		}UG_CATCH_THROW("MultiStepTimeDiscretization: Cannot assemble mass/stiffness matrix.");
+
+		m_CacheRevision = rev;
+		m_CacheGridLevel = gl;
+		m_pCachedSystem = NULL;
+	}
+
+//	system matrix A = M + s_a * K, unless A still holds it for this step size
+	const number scaleStiff = m_vScaleStiff[0];
+	if(m_pCachedSystem == &A && m_SystemRevision == rev
+		&& m_cachedScaleStiff == scaleStiff)
+		m_bMatrixReused = true;
+	else
+	{
+	//	dirichlet rows are identity rows in both parts, they are taken from M
+		MatAddNonDirichlet<matrix_type>(A, 1.0, m_M, scaleStiff, m_K);
+
+#ifdef UG_PARALLEL
+		A.set_storage_type(m_M.get_storage_mask());
+		A.set_layouts(m_M.layouts());
+#endif
+		m_pCachedSystem = &A;
+		m_SystemRevision = rev;
+		m_cachedScaleStiff = scaleStiff;
+	}
+
+//	right-hand side (previous time steps, sources and dirichlet values)
+	assemble_rhs(b, gl);
 }
 
 template <typename TAlgebra>
@@ -433,8 +489,8 @@ number SDIRK<TAlgebra>::update_scaling(std::vector<number>& vSM,
 				vSM[2] = 0;
 				vSM[3] = -1;
 				vSA[0] = dt * alpha;
-				vSA[1] = dt * b1;
-				vSA[2] = dt * b2;
+				vSA[1] = dt * b2;
+				vSA[2] = dt * b1;
 				vSA[3] = 0;
 				return m_Time0 + dt;
 			default:
@@ -607,6 +663,76 @@ number SDIRK<TAlgebra>::update_scaling(std::vector<number>& vSM,
 
 }
 
+template <typename TAlgebra>
+void SDIRK<TAlgebra>::
+embedded_error(vector_type& err, const std::vector<SmartPtr<vector_type> >& vStageSol)
+{
+	const size_t numStages = num_stages();
+	if(vStageSol.size() != numStages + 1)
+		UG_THROW("SDIRK::embedded_error: Expected "<<numStages+1<<" solutions,"
+				" but "<<vStageSol.size()<<" passed.");
+
+//	weights of the embedded solution of order - 1
+	std::vector<number> vEmbWeight(numStages, 0.0);
+	switch(m_order)
+	{
+		case 2: // implicit Euler at first stage
+			vEmbWeight[0] = 1.;
+			break;
+		case 3: // order 2 using the first two stages
+		{
+			const number alpha = 0.4358665215;
+			const number tau = (1. + alpha)/2.;
+			vEmbWeight[1] = (0.5 - alpha) / (tau - alpha);
+			vEmbWeight[0] = 1. - vEmbWeight[1];
+			break;
+		}
+		case 4: // Hairer, Wanner, order 3
+			vEmbWeight[0] = 59./48.;
+			vEmbWeight[1] = -17./96.;
+			vEmbWeight[2] = 225./32.;
+			vEmbWeight[3] = -85./12.;
+			break;
+		default:
+			UG_THROW("SDIRK: No embedded method for order "<<m_order<<".");
+	}
+
+//	Butcher coefficients a_ij from the stage scalings (dt = 1); all schemes
+//	are stiffly accurate, i.e. the weights are the coefficients of the last stage
+	const size_t savedStage = m_stage;
+	const number savedTime0 = m_Time0;
+	std::vector<std::vector<number> > vA(numStages);
+	std::vector<number> vSM, vSA;
+	for(size_t i = 0; i < numStages; ++i)
+	{
+		m_stage = i+1;
+		update_scaling(vSM, vSA, 1.0);
+		vA[i].resize(i+1);
+		for(size_t j = 0; j <= i; ++j)
+			vA[i][j] = vSA[i-j];
+	}
+	m_stage = savedStage;
+	m_Time0 = savedTime0;
+
+//	stage increments Y_i = dt * f(u_i), where u_i - u_0 = sum_j a_ij Y_j
+	std::vector<SmartPtr<vector_type> > vY(numStages);
+	for(size_t i = 0; i < numStages; ++i)
+	{
+		vY[i] = vStageSol[i+1]->clone();
+		VecScaleAdd(*vY[i], 1.0, *vStageSol[i+1], -1.0, *vStageSol[0]);
+		for(size_t j = 0; j < i; ++j)
+			VecScaleAdd(*vY[i], 1.0, *vY[i], -vA[i][j], *vY[j]);
+		VecScaleAssign(*vY[i], 1.0 / vA[i][i], *vY[i]);
+	}
+
+//	err = sum_j (b_j - bhat_j) Y_j
+	const std::vector<number>& vWeight = vA[numStages-1];
+	VecScaleAdd(err, vWeight[0] - vEmbWeight[0], *vY[0],
+	                 vWeight[1] - vEmbWeight[1], *vY[1]);
+	for(size_t j = 2; j < numStages; ++j)
+		VecScaleAdd(err, 1.0, err, vWeight[j] - vEmbWeight[j], *vY[j]);
+}
+
 template <typename TAlgebra>
 void SDIRK<TAlgebra>::
 prepare_step(SmartPtr<VectorTimeSeries<vector_type> > prevSol,
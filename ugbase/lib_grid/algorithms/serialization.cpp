@@ -647,6 +647,31 @@ bool SerializeGridElements(Grid& grid, GridObjectCollection goc,
 	return true;
 }
 
+////////////////////////////////////////////////////////////////////////
+///	reserves memory for numElems new elements of the type given by a grid section id
+static void ReserveForGridSectionID(Grid& grid, int gsid, int numElems)
+{
+	switch(gsid){
+		case GSID_VERTEX:
+		case GSID_HANGING_VERTEX:
+			grid.reserve<Vertex>(grid.num<Vertex>() + numElems);
+			break;
+		case GSID_EDGE:
+			grid.reserve<Edge>(grid.num<Edge>() + numElems);
+			break;
+		case GSID_TRIANGLE:
+		case GSID_QUADRILATERAL:
+			grid.reserve<Face>(grid.num<Face>() + numElems);
+			break;
+		case GSID_TETRAHEDRON:
+		case GSID_HEXAHEDRON:
+		case GSID_PRISM:
+		case GSID_PYRAMID:
+			grid.reserve<Volume>(grid.num<Volume>() + numElems);
+			break;
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////
 //	DeserializeGridElements
 bool DeserializeGridElements(Grid& grid, BinaryBuffer& in,
@@ -691,11 +716,15 @@ bool DeserializeGridElements(Grid& grid, BinaryBuffer& in,
 			int numElems = 0;
 			in.read((char*)&numElems, sizeof(int));
 
+		//	resize the attachment containers only once per block
+			ReserveForGridSectionID(grid, goid, numElems);
+
 		//	depending on the goid we'll create new elements.
 			switch(goid)
 			{
 				case GSID_VERTEX:
 					{
+						vVrts.reserve(vVrts.size() + numElems);
 						for(int i = 0; i < numElems; ++i)
 							vVrts.push_back(*grid.create<RegularVertex>());
 					}break;
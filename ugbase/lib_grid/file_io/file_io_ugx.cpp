@@ -36,6 +36,7 @@
 #include <boost/archive/text_iarchive.hpp>
 #include "common/common.h"
 #include "common/util/file_util.h"
+#include "common/util/in_situ_number_stream.h"
 #include "file_io_ugx.h"
 #include "common/boost_serialization_routines.h"
 #include "common/parser/rapidxml/rapidxml_print.hpp"
@@ -1055,7 +1056,7 @@ read_subset_handler_elements(ISubsetHandler& shOut,
 	while(elemNode)
 	{
 	//	read the indices
-		stringstream ss(elemNode->value(), ios_base::in);
+		InSituNumberStream ss(elemNode->value(), elemNode->value_size());
 
 		size_t index;
 		while(!ss.eof()){
@@ -1161,7 +1162,7 @@ read_selector_elements(ISelector& selOut, const char* elemNodeName,
 	while(elemNode)
 	{
 	//	read the indices
-		stringstream ss(elemNode->value(), ios_base::in);
+		InSituNumberStream ss(elemNode->value(), elemNode->value_size());
 
 		size_t index;
 		int state;
@@ -1368,14 +1369,62 @@ new_document_parsed()
 	return true;
 }
 
+void GridReaderUGX::
+count_new_elements(rapidxml::xml_node<>* gridNode,
+				   size_t& numVrtsOut, size_t& numEdgesOut,
+				   size_t& numFacesOut, size_t& numVolsOut)
+{
+	numVrtsOut = numEdgesOut = numFacesOut = numVolsOut = 0;
+
+	for(rapidxml::xml_node<>* curNode = gridNode->first_node(); curNode;
+		curNode = curNode->next_sibling())
+	{
+		const char* name = curNode->name();
+		size_t* num = NULL;
+		size_t numIndices = 0;
+
+		if(strcmp(name, "vertices") == 0){
+			rapidxml::xml_attribute<>* attrib = curNode->first_attribute("coords");
+			if(attrib && atoi(attrib->value()) > 0){
+				num = &numVrtsOut; numIndices = atoi(attrib->value());
+			}
+		}
+		else if(strcmp(name, "edges") == 0 || strcmp(name, "constraining_edges") == 0){
+			num = &numEdgesOut; numIndices = 2;
+		}
+		else if(strcmp(name, "triangles") == 0 || strcmp(name, "constraining_triangles") == 0){
+			num = &numFacesOut; numIndices = 3;
+		}
+		else if(strcmp(name, "quadrilaterals") == 0
+				|| strcmp(name, "constraining_quadrilaterals") == 0){
+			num = &numFacesOut; numIndices = 4;
+		}
+		else if(strcmp(name, "tetrahedrons") == 0){
+			num = &numVolsOut; numIndices = 4;
+		}
+		else if(strcmp(name, "hexahedrons") == 0){
+			num = &numVolsOut; numIndices = 8;
+		}
+		else if(strcmp(name, "prisms") == 0 || strcmp(name, "octahedrons") == 0){
+			num = &numVolsOut; numIndices = 6;
+		}
+		else if(strcmp(name, "pyramids") == 0){
+			num = &numVolsOut; numIndices = 5;
+		}
+
+		if(num)
+			*num += InSituNumberStream(curNode->value(), curNode->value_size())
+						.num_tokens() / numIndices;
+	}
+}
+
 bool GridReaderUGX::
 create_edges(std::vector<Edge*>& edgesOut,
 			Grid& grid, rapidxml::xml_node<>* node,
 			std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(node->value(), node->value_size());
 
 //	read the edges
 	int i1, i2;
@@ -1409,9 +1458,8 @@ create_constraining_edges(std::vector<Edge*>& edgesOut,
 						  Grid& grid, rapidxml::xml_node<>* node,
 			 			  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(node->value(), node->value_size());
 
 //	read the edges
 	int i1, i2;
@@ -1445,9 +1493,8 @@ create_constrained_edges(std::vector<Edge*>& edgesOut,
 						  Grid& grid, rapidxml::xml_node<>* node,
 			 			  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(node->value(), node->value_size());
 
 //	read the edges
 	int i1, i2;
@@ -1491,9 +1538,8 @@ create_triangles(std::vector<Face*>& facesOut,
 				  Grid& grid, rapidxml::xml_node<>* node,
 				  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(node->value(), node->value_size());
 
 //	read the triangles
 	int i1, i2, i3;
@@ -1528,9 +1574,8 @@ create_constraining_triangles(std::vector<Face*>& facesOut,
 					  Grid& grid, rapidxml::xml_node<>* node,
 					  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(node->value(), node->value_size());
 
 //	read the triangles
 	int i1, i2, i3;
@@ -1566,9 +1611,8 @@ create_constrained_triangles(std::vector<Face*>& facesOut,
 					  Grid& grid, rapidxml::xml_node<>* node,
 					  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(node->value(), node->value_size());
 
 //	read the triangles
 	int i1, i2, i3;
@@ -1613,9 +1657,8 @@ create_quadrilaterals(std::vector<Face*>& facesOut,
 					   Grid& grid, rapidxml::xml_node<>* node,
 					   std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(node->value(), node->value_size());
 
 //	read the quadrilaterals
 	int i1, i2, i3, i4;
@@ -1652,9 +1695,8 @@ create_constraining_quadrilaterals(std::vector<Face*>& facesOut,
 					  Grid& grid, rapidxml::xml_node<>* node,
 					  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(node->value(), node->value_size());
 
 //	read the quadrilaterals
 	int i1, i2, i3, i4;
@@ -1693,9 +1735,8 @@ create_constrained_quadrilaterals(std::vector<Face*>& facesOut,
 					  Grid& grid, rapidxml::xml_node<>* node,
 					  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(node->value(), node->value_size());
 
 //	read the quadrilaterals
 	int i1, i2, i3, i4;
@@ -1744,9 +1785,8 @@ create_tetrahedrons(std::vector<Volume*>& volsOut,
 					 Grid& grid, rapidxml::xml_node<>* node,
 					 std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(node->value(), node->value_size());
 
 //	read the tetrahedrons
 	int i1, i2, i3, i4;
@@ -1783,9 +1823,8 @@ create_hexahedrons(std::vector<Volume*>& volsOut,
 					Grid& grid, rapidxml::xml_node<>* node,
 					std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(node->value(), node->value_size());
 
 //	read the hexahedrons
 	int i1, i2, i3, i4, i5, i6, i7, i8;
@@ -1826,9 +1865,8 @@ create_prisms(std::vector<Volume*>& volsOut,
 			  Grid& grid, rapidxml::xml_node<>* node,
 			  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(node->value(), node->value_size());
 
 //	read the hexahedrons
 	int i1, i2, i3, i4, i5, i6;
@@ -1867,9 +1905,8 @@ create_pyramids(std::vector<Volume*>& volsOut,
 				Grid& grid, rapidxml::xml_node<>* node,
 				std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(node->value(), node->value_size());
 
 //	read the hexahedrons
 	int i1, i2, i3, i4, i5;
@@ -1907,9 +1944,8 @@ create_octahedrons(std::vector<Volume*>& volsOut,
 					Grid& grid, rapidxml::xml_node<>* node,
 					std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(node->value(), node->value_size());
 
 //	read the octahedrons
 	int i1, i2, i3, i4, i5, i6;
@@ -2199,9 +2235,8 @@ UGXFileInfo::calculate_vertex_node_bbox(rapidxml::xml_node<>* vrtNode, AABox<vec
 	if (numSrcCoords > 3)
 		return false;
 
-//	create a buffer with which we can access the data
-	std::string str(vrtNode->value(), vrtNode->value_size());
-	std::stringstream ss(str, std::ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(vrtNode->value(), vrtNode->value_size());
 
 	AABox<vector3> box(vector3(0, 0, 0), vector3(0, 0, 0));
 	vector3 min(0, 0, 0);
@@ -295,7 +295,8 @@ class GridWriterUGX
 /**	Before any data can be retrieved using the get_* methods, a file
  *	has to be successfully loaded using load_file.
  *
- *	\todo: Improve performance by using in-situ stringstreams during element creation.
+ *	Numbers in vertex- and element-lists are parsed in place (see InSituNumberStream)
+ *	and memory for new elements is reserved in advance.
  */
 class GridReaderUGX
 {
@@ -394,6 +395,13 @@ class GridReaderUGX
 	 *	base-class implementation!*/
 		virtual bool new_document_parsed();
 
+	///	counts the vertices, edges, faces and volumes defined in a grid-node
+	/**	Only element lists with a fixed number of indices per element are
+	 * counted, i.e. constrained elements are ignored.*/
+		void count_new_elements(rapidxml::xml_node<>* gridNode,
+								size_t& numVrtsOut, size_t& numEdgesOut,
+								size_t& numFacesOut, size_t& numVolsOut);
+
 	///	creates vertices from a vertex-node.
 	/**	if aaPos has more coordinates per vertex than the vrtNode,
 	 *	0's will be appended. If it has less, unused coordinates will
@@ -35,6 +35,7 @@
 
 #include <sstream>
 #include <cstring>
+#include "common/util/in_situ_number_stream.h"
 #include "lib_grid/algorithms/debug_util.h"
 #include "lib_grid/global_attachments.h"
 
@@ -412,6 +413,15 @@ grid(Grid& gridOut, size_t index,
 	vector<Face*>& faces = m_entries[index].faces;
 	vector<Volume*>& volumes = m_entries[index].volumes;
 
+//	reserve memory for all new elements at once
+	size_t numNewVrts, numNewEdges, numNewFaces, numNewVols;
+	count_new_elements(gridNode, numNewVrts, numNewEdges, numNewFaces, numNewVols);
+	grid.reserve_new_elements(numNewVrts, numNewEdges, numNewFaces, numNewVols);
+	vertices.reserve(vertices.size() + numNewVrts);
+	edges.reserve(edges.size() + numNewEdges);
+	faces.reserve(faces.size() + numNewFaces);
+	volumes.reserve(volumes.size() + numNewVols);
+
 //	we'll record constraining objects for constrained-vertices and constrained-edges
 	std::vector<std::pair<int, int> > constrainingObjsVRT;
 	std::vector<std::pair<int, int> > constrainingObjsEDGE;
@@ -701,9 +711,8 @@ create_vertices(std::vector<Vertex*>& vrtsOut, Grid& grid,
 	if(numSrcCoords < 1 || numDestCoords < 1)
 		return false;
 
-//	create a buffer with which we can access the data
-	string str(vrtNode->value(), vrtNode->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(vrtNode->value(), vrtNode->value_size());
 
 //	if numDestCoords == numSrcCoords parsing will be faster
 	if(numSrcCoords == numDestCoords){
@@ -786,9 +795,8 @@ create_constrained_vertices(std::vector<Vertex*>& vrtsOut,
 	if(numSrcCoords < 1 || numDestCoords < 1)
 		return false;
 
-//	create a buffer with which we can access the data
-	string str(vrtNode->value(), vrtNode->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the data in place
+	InSituNumberStream ss(vrtNode->value(), vrtNode->value_size());
 
 //	we have to be careful with reading.
 //	if numDestCoords < numSrcCoords we'll ignore some coords,
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include "element_pool.h"
+#include "common/log.h"
+#include "common/util/demangle.h"
+#include "common/util/thread_util.h"
+
+using namespace std;
+
+namespace ug
+{
+
+///	memory of one slab in bytes (slabs hold at least 64 objects)
+static const size_t SLAB_BYTES = 1 << 18;
+
+static vector<ElementPoolBase*>& PoolList()
+{
+	static vector<ElementPoolBase*>* pools = new vector<ElementPoolBase*>;
+	return *pools;
+}
+
+ElementPoolBase::
+ElementPoolBase(const std::type_info& type, size_t objSize) :
+	m_type(type),
+	m_cur(NULL),
+	m_end(NULL),
+	m_free(NULL),
+	m_numObjects(0)
+{
+//	keep objects aligned for any member type
+	const size_t align = 2 * sizeof(void*);
+	m_objSize = ((max(objSize, sizeof(FreeEntry)) + align - 1) / align) * align;
+	m_slabSize = max<size_t>(64, SLAB_BYTES / m_objSize);
+
+#ifdef UG_OPENMP
+	#pragma omp critical (ug_element_pool)
+#endif
+	PoolList().push_back(this);
+}
+
+void* ElementPoolBase::allocate()
+{
+	if(NumActiveThreads() == 1)
+		return allocate_unsafe();
+
+	void* p;
+#ifdef UG_OPENMP
+	#pragma omp critical (ug_element_pool)
+#endif
+	p = allocate_unsafe();
+	return p;
+}
+
+void ElementPoolBase::deallocate(void* p)
+{
+	if(NumActiveThreads() == 1){
+		deallocate_unsafe(p);
+		return;
+	}
+
+#ifdef UG_OPENMP
+	#pragma omp critical (ug_element_pool)
+#endif
+	deallocate_unsafe(p);
+}
+
+void* ElementPoolBase::allocate_unsafe()
+{
+	++m_numObjects;
+
+//	recycle memory of deleted objects first
+	if(m_free){
+		FreeEntry* e = m_free;
+		m_free = e->next;
+		return e;
+	}
+
+	if(m_cur == m_end){
+		m_slabs.push_back(new char[m_slabSize * m_objSize]);
+		m_cur = m_slabs.back();
+		m_end = m_cur + m_slabSize * m_objSize;
+	}
+
+	void* p = m_cur;
+	m_cur += m_objSize;
+	return p;
+}
+
+void ElementPoolBase::deallocate_unsafe(void* p)
+{
+	--m_numObjects;
+
+//	if the last object was deleted, release all memory at once. The first slab
+//	is kept for the next objects.
+	if(m_numObjects == 0){
+		for(size_t i = 1; i < m_slabs.size(); ++i)
+			delete[] m_slabs[i];
+		m_slabs.resize(1);
+		m_cur = m_slabs[0];
+		m_end = m_cur + m_slabSize * m_objSize;
+		m_free = NULL;
+		return;
+	}
+
+	FreeEntry* e = reinterpret_cast<FreeEntry*>(p);
+	e->next = m_free;
+	m_free = e;
+}
+
+void ElementPoolBase::release_unused_slabs()
+{
+	if(m_slabs.empty())
+		return;
+
+//	slabs sorted by address, to find the slab of a recycled object
+	const size_t slabBytes = m_slabSize * m_objSize;
+	char* curSlab = m_end - slabBytes;
+	vector<char*> vSlabs(m_slabs);
+	sort(vSlabs.begin(), vSlabs.end());
+
+//	count the recycled objects per slab
+	vector<size_t> vNumFree(vSlabs.size(), 0);
+	for(FreeEntry* e = m_free; e; e = e->next){
+		char* p = reinterpret_cast<char*>(e);
+		++vNumFree[upper_bound(vSlabs.begin(), vSlabs.end(), p) - vSlabs.begin() - 1];
+	}
+
+//	a slab is unused, if all objects handed out from it were recycled. The
+//	slab of the next new objects is kept, but it is used from its start again.
+	vector<bool> vUnused(vSlabs.size(), false);
+	for(size_t i = 0; i < vSlabs.size(); ++i){
+		size_t numUsed = m_slabSize;
+		if(vSlabs[i] == curSlab)
+			numUsed = (m_cur - curSlab) / m_objSize;
+		vUnused[i] = (vNumFree[i] == numUsed);
+	}
+
+//	rebuild the list of recycled objects without the unused slabs
+	FreeEntry* newFree = NULL;
+	for(FreeEntry* e = m_free; e;){
+		FreeEntry* next = e->next;
+		char* p = reinterpret_cast<char*>(e);
+		if(!vUnused[upper_bound(vSlabs.begin(), vSlabs.end(), p) - vSlabs.begin() - 1]){
+			e->next = newFree;
+			newFree = e;
+		}
+		e = next;
+	}
+	m_free = newFree;
+
+//	release the unused slabs
+	m_slabs.clear();
+	for(size_t i = 0; i < vSlabs.size(); ++i){
+		if(vSlabs[i] == curSlab){
+			if(vUnused[i])
+				m_cur = curSlab;
+		}
+		else if(vUnused[i]){
+			delete[] vSlabs[i];
+			continue;
+		}
+		m_slabs.push_back(vSlabs[i]);
+	}
+
+//	the current slab has to stay the last one
+	vector<char*>::iterator iter = find(m_slabs.begin(), m_slabs.end(), curSlab);
+	iter_swap(iter, m_slabs.end() - 1);
+}
+
+std::string ElementPoolBase::name() const
+{
+	return demangle(m_type.name());
+}
+
+const std::vector<ElementPoolBase*>& ElementPoolBase::pools()
+{
+	return PoolList();
+}
+
+void PrintElementPoolStatistics()
+{
+	const vector<ElementPoolBase*>& pools = ElementPoolBase::pools();
+	stringstream ss;
+	size_t totalBytes = 0;
+	ss << "Element pools:\n";
+	ss << "  " << setw(30) << left << "type" << setw(12) << right << "objects"
+	   << setw(12) << "bytes/obj" << setw(16) << "memory (kB)" << "\n";
+	for(size_t i = 0; i < pools.size(); ++i){
+		const ElementPoolBase& p = *pools[i];
+		ss << "  " << setw(30) << left << p.name() << setw(12) << right
+		   << p.num_objects() << setw(12) << p.object_size()
+		   << setw(16) << p.num_bytes() / 1024 << "\n";
+		totalBytes += p.num_bytes();
+	}
+	ss << "  total memory: " << totalBytes / 1024 << " kB\n";
+	UG_LOG(ss.str());
+}
+
+void ReleaseUnusedElementPoolMemory()
+{
+	const vector<ElementPoolBase*>& pools = ElementPoolBase::pools();
+	for(size_t i = 0; i < pools.size(); ++i)
+		pools[i]->release_unused_slabs();
+}
+
+}//	end of namespace
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__element_pool__
+#define __H__UG__element_pool__
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace ug
+{
+
+///	Pooled memory for grid objects of one concrete type.
+/**	Grid objects are allocated from chunks (slabs) of contiguous memory instead
+ * of one heap allocation per object. Objects which are created one after
+ * another (e.g. the children of one refinement step) thus lie next to each
+ * other in memory. Memory of deleted objects is recycled for new objects of
+ * the same type. Once all objects of a type are deleted, all slabs but one are
+ * released at once.
+ *
+ * Note that memory is not released per grid or per level: deleted objects
+ * only return their memory to the free list of the pool, as long as other
+ * objects of the same type are alive, e.g. in another grid or on another
+ * level of a multigrid. Slabs without live objects can be released by
+ * release_unused_slabs (resp. ReleaseUnusedElementPoolMemory), e.g. after a
+ * large grid was cleared. Slabs shared with live objects are kept.
+ *
+ * There is one pool per concrete grid object type, shared by all grids, since
+ * grid objects are created in many places (Grid::create, create_empty_instance,
+ * refinement methods of the elements). Pools are used through the class
+ * specific operators new and delete, which are added to a grid object class by
+ * UG_GRID_OBJECT_POOL. The pools are not thread safe (like Grid itself),
+ * except that allocations from inside an OpenMP parallel region are
+ * serialized.
+ *
+ * \sa ElementPool, PrintElementPoolStatistics
+ */
+class ElementPoolBase
+{
+	public:
+		ElementPoolBase(const std::type_info& type, size_t objSize);
+
+		void* allocate();
+		void deallocate(void* p);
+
+	///	name of the pooled type
+		std::string name() const;
+
+	///	size of one object in bytes
+		size_t object_size() const		{return m_objSize;}
+
+	///	number of live objects
+		size_t num_objects() const		{return m_numObjects;}
+
+	///	memory held by the pool in bytes
+		size_t num_bytes() const		{return m_slabs.size() * m_slabSize * m_objSize;}
+
+	///	releases all slabs which contain no live objects
+	/**	Runs in O(n log m) for n recycled objects in m slabs. Must not be
+	 * called from inside a parallel region.*/
+		void release_unused_slabs();
+
+	///	list of all pools created so far
+		static const std::vector<ElementPoolBase*>& pools();
+
+	private:
+		void* allocate_unsafe();
+		void deallocate_unsafe(void* p);
+
+		struct FreeEntry {FreeEntry* next;};
+
+		const std::type_info&	m_type;
+		size_t					m_objSize;
+		size_t					m_slabSize;///< objects per slab
+		std::vector<char*>		m_slabs;
+		char*					m_cur;///< next unused object in the last slab
+		char*					m_end;
+		FreeEntry*				m_free;///< recycled objects
+		size_t					m_numObjects;
+};
+
+
+///	The pool of grid objects of type TElem.
+/**	Derived classes which do not have a pool of their own are allocated by the
+ * standard operator new, which is detected by the size of the object.*/
+template <class TElem>
+class ElementPool
+{
+	public:
+		static ElementPoolBase& inst()
+		{
+		//	the pool is never destroyed, since grids may outlive static objects
+			static ElementPoolBase* pool = new ElementPoolBase(typeid(TElem), sizeof(TElem));
+			return *pool;
+		}
+
+		static void* allocate(size_t size)
+		{
+			if(size != sizeof(TElem))
+				return ::operator new(size);
+			return inst().allocate();
+		}
+
+		static void deallocate(void* p, size_t size)
+		{
+			if(!p) return;
+			if(size != sizeof(TElem))
+				::operator delete(p);
+			else
+				inst().deallocate(p);
+		}
+};
+
+
+///	adds class specific operators new and delete which use ElementPool<TElem>
+#define UG_GRID_OBJECT_POOL(TElem)\
+		static void* operator new(size_t size)				{return ug::ElementPool<TElem>::allocate(size);}\
+		static void operator delete(void* p, size_t size)	{ug::ElementPool<TElem>::deallocate(p, size);}
+
+
+///	prints the number of objects and the memory of all element pools
+void PrintElementPoolStatistics();
+
+///	releases the slabs without live objects of all element pools
+void ReleaseUnusedElementPoolMemory();
+
+}//	end of namespace
+
+#endif
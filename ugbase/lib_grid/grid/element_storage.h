@@ -35,6 +35,7 @@
 
 #include "grid_base_objects.h"
 #include "common/util/section_container.h"
+#include "element_pool.h"
 
 namespace ug
 {
@@ -58,6 +58,7 @@ Grid::Grid() :
 	m_aEdgeContainer("Grid_EdgeContainer", false),
 	m_aFaceContainer("Grid_FaceContainer", false),
 	m_aVolumeContainer("Grid_VolumeContainer", false),
+	m_topologyFrozen(false),
 	m_bMarking(false),
 	m_aMark("Grid_Mark", false),
 	m_distGridMgr(NULL),
@@ -76,6 +77,7 @@ Grid::Grid(uint options) :
 	m_aEdgeContainer("Grid_EdgeContainer", false),
 	m_aFaceContainer("Grid_FaceContainer", false),
 	m_aVolumeContainer("Grid_VolumeContainer", false),
+	m_topologyFrozen(false),
 	m_bMarking(false),
 	m_aMark("Grid_Mark", false),
 	m_distGridMgr(NULL),
@@ -94,6 +96,7 @@ Grid::Grid(const Grid& grid) :
 	m_aEdgeContainer("Grid_EdgeContainer", false),
 	m_aFaceContainer("Grid_FaceContainer", false),
 	m_aVolumeContainer("Grid_VolumeContainer", false),
+	m_topologyFrozen(false),
 	m_bMarking(false),
 	m_aMark("Grid_Mark", false),
 	m_distGridMgr(NULL),
@@ -539,6 +542,9 @@ void Grid::flip_orientation(Edge* e)
 
 void Grid::flip_orientation(Face* f)
 {
+	if(m_topologyFrozen)
+		thaw_topology();
+
 //	inverts the order of vertices.
 	uint numVrts = (int)f->num_vertices();
 	vector<Vertex*> vVrts(numVrts);
@@ -567,6 +573,9 @@ void Grid::flip_orientation(Face* f)
 
 void Grid::flip_orientation(Volume* vol)
 {
+	if(m_topologyFrozen)
+		thaw_topology();
+
 //	flips the orientation of volumes
 //	get the descriptor for the flipped volume
 	VolumeDescriptor vd;
@@ -725,12 +734,92 @@ bool Grid::option_is_enabled(uint option) const
 
 void Grid::change_options(uint optsNew)
 {
+	if(m_topologyFrozen)
+		thaw_topology();
+
 	change_vertex_options(optsNew &	0x000000FF);
 	change_edge_options(optsNew & 	0x0000FF00);
 	change_face_options(optsNew & 	0x00FF0000);
 	change_volume_options(optsNew &	0xFF000000);
 	assert((m_options == optsNew) && "Grid::change_options failed");
 }
+
+////////////////////////////////////////////////////////////////////////
+//	frozen topology
+void Grid::freeze_topology()
+{
+	GRID_PROFILE_FUNC();
+
+	if(m_topologyFrozen)
+		return;
+
+	if(option_is_enabled(VRTOPT_STORE_ASSOCIATED_EDGES))
+		freeze_association(m_frozenEdgesVERTEX, m_aaEdgeContainerVERTEX, m_aEdgeContainer);
+	if(option_is_enabled(VRTOPT_STORE_ASSOCIATED_FACES))
+		freeze_association(m_frozenFacesVERTEX, m_aaFaceContainerVERTEX, m_aFaceContainer);
+	if(option_is_enabled(VRTOPT_STORE_ASSOCIATED_VOLUMES))
+		freeze_association(m_frozenVolumesVERTEX, m_aaVolumeContainerVERTEX, m_aVolumeContainer);
+	if(option_is_enabled(EDGEOPT_STORE_ASSOCIATED_FACES))
+		freeze_association(m_frozenFacesEDGE, m_aaFaceContainerEDGE, m_aFaceContainer);
+	if(option_is_enabled(EDGEOPT_STORE_ASSOCIATED_VOLUMES))
+		freeze_association(m_frozenVolumesEDGE, m_aaVolumeContainerEDGE, m_aVolumeContainer);
+	if(option_is_enabled(FACEOPT_STORE_ASSOCIATED_EDGES))
+		freeze_association(m_frozenEdgesFACE, m_aaEdgeContainerFACE, m_aEdgeContainer);
+	if(option_is_enabled(FACEOPT_STORE_ASSOCIATED_VOLUMES))
+		freeze_association(m_frozenVolumesFACE, m_aaVolumeContainerFACE, m_aVolumeContainer);
+	if(option_is_enabled(VOLOPT_STORE_ASSOCIATED_EDGES))
+		freeze_association(m_frozenEdgesVOLUME, m_aaEdgeContainerVOLUME, m_aEdgeContainer);
+	if(option_is_enabled(VOLOPT_STORE_ASSOCIATED_FACES))
+		freeze_association(m_frozenFacesVOLUME, m_aaFaceContainerVOLUME, m_aFaceContainer);
+
+	m_topologyFrozen = true;
+}
+
+void Grid::thaw_topology()
+{
+	GRID_PROFILE_FUNC();
+
+	if(!m_topologyFrozen)
+		return;
+
+//	reset the flag first, since the accessors are valid again afterwards.
+	m_topologyFrozen = false;
+
+	if(m_frozenEdgesVERTEX.frozen)
+		thaw_association(m_frozenEdgesVERTEX, m_aaEdgeContainerVERTEX, m_aEdgeContainer);
+	if(m_frozenFacesVERTEX.frozen)
+		thaw_association(m_frozenFacesVERTEX, m_aaFaceContainerVERTEX, m_aFaceContainer);
+	if(m_frozenVolumesVERTEX.frozen)
+		thaw_association(m_frozenVolumesVERTEX, m_aaVolumeContainerVERTEX, m_aVolumeContainer);
+	if(m_frozenFacesEDGE.frozen)
+		thaw_association(m_frozenFacesEDGE, m_aaFaceContainerEDGE, m_aFaceContainer);
+	if(m_frozenVolumesEDGE.frozen)
+		thaw_association(m_frozenVolumesEDGE, m_aaVolumeContainerEDGE, m_aVolumeContainer);
+	if(m_frozenEdgesFACE.frozen)
+		thaw_association(m_frozenEdgesFACE, m_aaEdgeContainerFACE, m_aEdgeContainer);
+	if(m_frozenVolumesFACE.frozen)
+		thaw_association(m_frozenVolumesFACE, m_aaVolumeContainerFACE, m_aVolumeContainer);
+	if(m_frozenEdgesVOLUME.frozen)
+		thaw_association(m_frozenEdgesVOLUME, m_aaEdgeContainerVOLUME, m_aEdgeContainer);
+	if(m_frozenFacesVOLUME.frozen)
+		thaw_association(m_frozenFacesVOLUME, m_aaFaceContainerVOLUME, m_aFaceContainer);
+}
+
+////////////////////////////////////////////////////////////////////////
+//	reserve_new_elements
+void Grid::reserve_new_elements(size_t numVrts, size_t numEdges,
+								size_t numFaces, size_t numVols)
+{
+	if(numVrts > 0)
+		reserve<Vertex>(num<Vertex>() + numVrts);
+	if(numEdges > 0)
+		reserve<Edge>(num<Edge>() + numEdges);
+	if(numFaces > 0)
+		reserve<Face>(num<Face>() + numFaces);
+	if(numVols > 0)
+		reserve<Volume>(num<Volume>() + numVols);
+}
+
 /*
 void Grid::register_observer(GridObserver* observer, uint observerType)
 {
@@ -886,6 +975,8 @@ Grid::AssociatedEdgeIterator Grid::associated_edges_begin(Vertex* vrt)
 		LOG("WARNING in associated_edges_begin(vrt): auto-enabling VRTOPT_STORE_ASSOCIATED_EDGES." << endl);
 		vertex_store_associated_edges(true);
 	}
+	if(m_frozenEdgesVERTEX.frozen)
+		return frozen_begin(m_frozenEdgesVERTEX, vrt);
 	return m_aaEdgeContainerVERTEX[vrt].begin();
 }
 
@@ -896,6 +987,8 @@ Grid::AssociatedEdgeIterator Grid::associated_edges_end(Vertex* vrt)
 		LOG("WARNING in associated_edges_end(vrt): auto-enabling VRTOPT_STORE_ASSOCIATED_EDGES." << endl);
 		vertex_store_associated_edges(true);
 	}
+	if(m_frozenEdgesVERTEX.frozen)
+		return frozen_end(m_frozenEdgesVERTEX, vrt);
 	return m_aaEdgeContainerVERTEX[vrt].end();
 }
 
@@ -906,6 +999,8 @@ Grid::AssociatedEdgeIterator Grid::associated_edges_begin(Face* face)
 		LOG("WARNING in associated_edges_begin(face): auto-enabling FACEOPT_STORE_ASSOCIATED_EDGES." << endl);
 		face_store_associated_edges(true);
 	}
+	if(m_frozenEdgesFACE.frozen)
+		return frozen_begin(m_frozenEdgesFACE, face);
 	return m_aaEdgeContainerFACE[face].begin();
 }
 
@@ -916,6 +1011,8 @@ Grid::AssociatedEdgeIterator Grid::associated_edges_end(Face* face)
 		LOG("WARNING in associated_edges_end(face): auto-enabling FACEOPT_STORE_ASSOCIATED_EDGES." << endl);
 		face_store_associated_edges(true);
 	}
+	if(m_frozenEdgesFACE.frozen)
+		return frozen_end(m_frozenEdgesFACE, face);
 	return m_aaEdgeContainerFACE[face].end();
 }
 
@@ -926,6 +1023,8 @@ Grid::AssociatedEdgeIterator Grid::associated_edges_begin(Volume* vol)
 		LOG("WARNING in associated_edges_begin(vol): auto-enabling VOLOPT_STORE_ASSOCIATED_EDGES." << endl);
 		volume_store_associated_edges(true);
 	}
+	if(m_frozenEdgesVOLUME.frozen)
+		return frozen_begin(m_frozenEdgesVOLUME, vol);
 	return m_aaEdgeContainerVOLUME[vol].begin();
 }
 
@@ -936,6 +1035,8 @@ Grid::AssociatedEdgeIterator Grid::associated_edges_end(Volume* vol)
 		LOG("WARNING in associated_edges_end(vol): auto-enabling VOLOPT_STORE_ASSOCIATED_EDGES." << endl);
 		volume_store_associated_edges(true);
 	}
+	if(m_frozenEdgesVOLUME.frozen)
+		return frozen_end(m_frozenEdgesVOLUME, vol);
 	return m_aaEdgeContainerVOLUME[vol].end();
 }
 
@@ -948,6 +1049,8 @@ Grid::AssociatedFaceIterator Grid::associated_faces_begin(Vertex* vrt)
 		LOG("WARNING in associated_faces_begin(vrt): auto-enabling VRTOPT_STORE_ASSOCIATED_FACES." << endl);
 		vertex_store_associated_faces(true);
 	}
+	if(m_frozenFacesVERTEX.frozen)
+		return frozen_begin(m_frozenFacesVERTEX, vrt);
 	return m_aaFaceContainerVERTEX[vrt].begin();
 }
 
@@ -958,6 +1061,8 @@ Grid::AssociatedFaceIterator Grid::associated_faces_end(Vertex* vrt)
 		LOG("WARNING in associated_faces_end(vrt): auto-enabling VRTOPT_STORE_ASSOCIATED_FACES." << endl);
 		vertex_store_associated_faces(true);
 	}
+	if(m_frozenFacesVERTEX.frozen)
+		return frozen_end(m_frozenFacesVERTEX, vrt);
 	return m_aaFaceContainerVERTEX[vrt].end();
 }
 
@@ -968,6 +1073,8 @@ Grid::AssociatedFaceIterator Grid::associated_faces_begin(Edge* edge)
 		LOG("WARNING in associated_faces_begin(edge): auto-enabling EDGEOPT_STORE_ASSOCIATED_FACES." << endl);
 		edge_store_associated_faces(true);
 	}
+	if(m_frozenFacesEDGE.frozen)
+		return frozen_begin(m_frozenFacesEDGE, edge);
 	return m_aaFaceContainerEDGE[edge].begin();
 }
 
@@ -978,6 +1085,8 @@ Grid::AssociatedFaceIterator Grid::associated_faces_end(Edge* edge)
 		LOG("WARNING in associated_faces_end(edge): auto-enabling EDGEOPT_STORE_ASSOCIATED_FACES." << endl);
 		edge_store_associated_faces(true);
 	}
+	if(m_frozenFacesEDGE.frozen)
+		return frozen_end(m_frozenFacesEDGE, edge);
 	return m_aaFaceContainerEDGE[edge].end();
 }
 
@@ -988,6 +1097,8 @@ Grid::AssociatedFaceIterator Grid::associated_faces_begin(Volume* vol)
 		LOG("WARNING in associated_faces_begin(vol): auto-enabling VOLOPT_STORE_ASSOCIATED_FACES." << endl);
 		volume_store_associated_faces(true);
 	}
+	if(m_frozenFacesVOLUME.frozen)
+		return frozen_begin(m_frozenFacesVOLUME, vol);
 	return m_aaFaceContainerVOLUME[vol].begin();
 }
 
@@ -998,6 +1109,8 @@ Grid::AssociatedFaceIterator Grid::associated_faces_end(Volume* vol)
 		LOG("WARNING in associated_faces_end(vol): auto-enabling VOLOPT_STORE_ASSOCIATED_FACES." << endl);
 		volume_store_associated_faces(true);
 	}
+	if(m_frozenFacesVOLUME.frozen)
+		return frozen_end(m_frozenFacesVOLUME, vol);
 	return m_aaFaceContainerVOLUME[vol].end();
 }
 
@@ -1010,6 +1123,8 @@ Grid::AssociatedVolumeIterator Grid::associated_volumes_begin(Vertex* vrt)
 		LOG("WARNING in associated_volumes_begin(vrt): auto-enabling VRTOPT_STORE_ASSOCIATED_VOLUMES." << endl);
 		vertex_store_associated_volumes(true);
 	}
+	if(m_frozenVolumesVERTEX.frozen)
+		return frozen_begin(m_frozenVolumesVERTEX, vrt);
 	return m_aaVolumeContainerVERTEX[vrt].begin();
 }
 
@@ -1020,6 +1135,8 @@ Grid::AssociatedVolumeIterator Grid::associated_volumes_end(Vertex* vrt)
 		LOG("WARNING in associated_volumes_end(vrt): auto-enabling VRTOPT_STORE_ASSOCIATED_VOLUMES." << endl);
 		vertex_store_associated_volumes(true);
 	}
+	if(m_frozenVolumesVERTEX.frozen)
+		return frozen_end(m_frozenVolumesVERTEX, vrt);
 	return m_aaVolumeContainerVERTEX[vrt].end();
 }
 
@@ -1030,6 +1147,8 @@ Grid::AssociatedVolumeIterator Grid::associated_volumes_begin(Edge* edge)
 		LOG("WARNING in associated_volumes_begin(edge): auto-enabling EDGEOPT_STORE_ASSOCIATED_VOLUMES." << endl);
 		edge_store_associated_volumes(true);
 	}
+	if(m_frozenVolumesEDGE.frozen)
+		return frozen_begin(m_frozenVolumesEDGE, edge);
 	return m_aaVolumeContainerEDGE[edge].begin();
 }
 
@@ -1040,6 +1159,8 @@ Grid::AssociatedVolumeIterator Grid::associated_volumes_end(Edge* edge)
 		LOG("WARNING in associated_volumes_end(edge): auto-enabling EDGEOPT_STORE_ASSOCIATED_VOLUMES." << endl);
 		edge_store_associated_volumes(true);
 	}
+	if(m_frozenVolumesEDGE.frozen)
+		return frozen_end(m_frozenVolumesEDGE, edge);
 	return m_aaVolumeContainerEDGE[edge].end();
 }
 
@@ -1050,6 +1171,8 @@ Grid::AssociatedVolumeIterator Grid::associated_volumes_begin(Face* face)
 		LOG("WARNING in associated_volumes_begin(face): auto-enabling FACEOPT_STORE_ASSOCIATED_VOLUMES." << endl);
 		face_store_associated_volumes(true);
 	}
+	if(m_frozenVolumesFACE.frozen)
+		return frozen_begin(m_frozenVolumesFACE, face);
 	return m_aaVolumeContainerFACE[face].begin();
 }
 
@@ -1060,6 +1183,8 @@ Grid::AssociatedVolumeIterator Grid::associated_volumes_end(Face* face)
 		LOG("WARNING in associated_volumes_end(face): auto-enabling FACEOPT_STORE_ASSOCIATED_VOLUMES." << endl);
 		face_store_associated_volumes(true);
 	}
+	if(m_frozenVolumesFACE.frozen)
+		return frozen_end(m_frozenVolumesFACE, face);
 	return m_aaVolumeContainerFACE[face].end();
 }
 
@@ -1082,8 +1207,11 @@ Edge* Grid::get_edge(Face* f, int ind)
 //	check whether the face stores associated edges
 	if(option_is_enabled(FACEOPT_STORE_ASSOCIATED_EDGES))
 	{
-		if(option_is_enabled(FACEOPT_AUTOGENERATE_EDGES))
+		if(option_is_enabled(FACEOPT_AUTOGENERATE_EDGES)){
+			if(m_frozenEdgesFACE.frozen)
+				return *(frozen_begin(m_frozenEdgesFACE, f) + ind);
 			return m_aaEdgeContainerFACE[f][ind];
+		}
 		else{
 			EdgeDescriptor ed;
 			f->edge_desc(ind, ed);
@@ -1112,6 +1240,8 @@ Edge* Grid::get_edge(Volume* v, int ind)
 			|| option_is_enabled(VOLOPT_AUTOGENERATE_FACES
 								| FACEOPT_AUTOGENERATE_EDGES))
 		{
+			if(m_frozenEdgesVOLUME.frozen)
+				return *(frozen_begin(m_frozenEdgesVOLUME, v) + ind);
 			return m_aaEdgeContainerVOLUME[v][ind];
 		}
 		else{
@@ -1143,8 +1273,11 @@ Face* Grid::get_face(Volume* v, int ind)
 	if(option_is_enabled(VOLOPT_STORE_ASSOCIATED_FACES))
 	{
 	//	if autogenerate is enabeld, faces are sorted.
-		if(option_is_enabled(VOLOPT_AUTOGENERATE_FACES))
+		if(option_is_enabled(VOLOPT_AUTOGENERATE_FACES)){
+			if(m_frozenFacesVOLUME.frozen)
+				return *(frozen_begin(m_frozenFacesVOLUME, v) + ind);
 			return m_aaFaceContainerVOLUME[v][ind];
+		}
 		else{
 			FaceDescriptor fd;
 			v->face_desc(ind, fd);
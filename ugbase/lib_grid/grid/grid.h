@@ -294,6 +294,29 @@ class UG_API Grid
 		void disable_options(uint options);	///< see set_options for a description of valid parameters.
 		bool option_is_enabled(uint option) const;///< see set_options for a description of valid parameters.
 
+	////////////////////////////////////////////////
+	//	frozen topology
+	///	compresses the stored lists of associated elements into contiguous arrays.
+	/**	Each associated-element relation which is stored due to the current grid
+	 * options (e.g. VRTOPT_STORE_ASSOCIATED_EDGES) is copied to one compressed
+	 * array (CSR layout) and the per-element containers are released.
+	 * All queries (associated_edges_begin, get_associated, get_edge, ...) keep
+	 * working and read from the compressed arrays. This reduces the memory
+	 * footprint and improves locality during repeated traversals of a static grid.
+	 *
+	 * Any method which changes the topology or the options of the grid
+	 * (creation or erasure of elements, set_options, flip_orientation, ...)
+	 * automatically calls thaw_topology before it continues.
+	 * Calling freeze_topology on a frozen grid has no effect.*/
+		void freeze_topology();
+
+	///	restores the per-element lists of associated elements of a frozen grid.
+	/**	Calling thaw_topology on a grid which is not frozen has no effect.*/
+		void thaw_topology();
+
+	///	returns true if the lists of associated elements are currently frozen.
+		inline bool topology_frozen() const		{return m_topologyFrozen;}
+
 	////////////////////////////////////////////////
 	//	parallelism
 	///	tell the grid whether it will be used in a serial or in a parallel environment.
@@ -418,6 +441,12 @@ class UG_API Grid
 		template <class TGeomObj>
 		void reserve(size_t num);
 
+	///	reserves memory for the given numbers of new elements
+	/**	The attachment containers are resized only once, instead of repeatedly
+	 * during the creation of many elements.*/
+		void reserve_new_elements(size_t numVrts, size_t numEdges = 0,
+								  size_t numFaces = 0, size_t numVols = 0);
+
 	////////////////////////////////////////////////
 	//	element deletion
 		void erase(GridObject* geomObj);
@@ -957,6 +986,17 @@ class UG_API Grid
 
 		typedef Attachment<int>	AMark;
 
+	///	compressed storage of one associated-element relation of a frozen grid.
+	/**	The elements associated with an element whose attachment data index is i
+	 * are stored in elems[offsets[i]], ..., elems[offsets[i+1] - 1].*/
+		template <class TAssElem>
+		struct FrozenAssociation{
+			FrozenAssociation() : frozen(false)	{}
+			std::vector<TAssElem*>	elems;
+			std::vector<size_t>		offsets;
+			bool					frozen;
+		};
+
 	protected:
 	///	unregisters all observers. Call this method in destructors of derived classes.
 	/**	If the derived class is an observer itself and if you don't want it to be
@@ -1035,6 +1075,31 @@ class UG_API Grid
 	//	some methods that simplify auto-enabling of grid options
 		inline void autoenable_option(uint option, const char* caller, const char* optionName);
 
+	//	frozen topology
+		template <class TElem, class TAssElem>
+		void freeze_association(FrozenAssociation<TAssElem>& fa,
+						AttachmentAccessor<TElem, Attachment<std::vector<TAssElem*> > >& aaCon,
+						Attachment<std::vector<TAssElem*> >& aCon);
+
+		template <class TElem, class TAssElem>
+		void thaw_association(FrozenAssociation<TAssElem>& fa,
+						AttachmentAccessor<TElem, Attachment<std::vector<TAssElem*> > >& aaCon,
+						Attachment<std::vector<TAssElem*> >& aCon);
+
+		template <class TElem, class TAssElem>
+		inline typename std::vector<TAssElem*>::iterator
+		frozen_begin(FrozenAssociation<TAssElem>& fa, TElem* e);
+
+		template <class TElem, class TAssElem>
+		inline typename std::vector<TAssElem*>::iterator
+		frozen_end(FrozenAssociation<TAssElem>& fa, TElem* e);
+
+	///	writes the stored associated elements of e to elemsOut (frozen or not).
+		template <class TElem, class TAssElem>
+		inline void get_stored_associated(PointerConstArray<TAssElem*>& elemsOut, TElem* e,
+						AttachmentAccessor<TElem, Attachment<std::vector<TAssElem*> > >& aaCon,
+						FrozenAssociation<TAssElem>& fa);
+
 	//	neighbourhood access
 		template <class TGeomObj>
 		Edge* find_edge_in_associated_edges(TGeomObj* obj,
@@ -1185,6 +1250,18 @@ class UG_API Grid
 		AttachmentAccessor<Volume, AEdgeContainer>		m_aaEdgeContainerVOLUME;
 		AttachmentAccessor<Volume, AFaceContainer>		m_aaFaceContainerVOLUME;
 		AttachmentAccessor<Volume, AVolumeContainer>	m_aaVolumeContainerVOLUME;
+
+	//	compressed associated-element relations of a frozen grid
+		bool						m_topologyFrozen;
+		FrozenAssociation<Edge>		m_frozenEdgesVERTEX;
+		FrozenAssociation<Face>		m_frozenFacesVERTEX;
+		FrozenAssociation<Volume>	m_frozenVolumesVERTEX;
+		FrozenAssociation<Face>		m_frozenFacesEDGE;
+		FrozenAssociation<Volume>	m_frozenVolumesEDGE;
+		FrozenAssociation<Edge>		m_frozenEdgesFACE;
+		FrozenAssociation<Volume>	m_frozenVolumesFACE;
+		FrozenAssociation<Edge>		m_frozenEdgesVOLUME;
+		FrozenAssociation<Face>		m_frozenFacesVOLUME;
 		
 	//	marks
 		int m_currentMark;	// 0: marks inactive. -1: reset-marks (sets currentMark to 1)
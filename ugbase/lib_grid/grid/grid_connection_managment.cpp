@@ -98,6 +98,9 @@ void Grid::register_vertex(Vertex* v, GridObject* pParent)
 {
 	GCM_PROFILE_FUNC();
 
+	if(m_topologyFrozen)
+		thaw_topology();
+
 //	store the element and register it at the pipe.
 	m_vertexElementStorage.m_attachmentPipe.register_element(v);
 	m_vertexElementStorage.m_sectionContainer.insert(v, v->container_section());
@@ -113,6 +116,9 @@ void Grid::register_vertex(Vertex* v, GridObject* pParent)
 
 void Grid::register_and_replace_element(Vertex* v, Vertex* pReplaceMe)
 {
+	if(m_topologyFrozen)
+		thaw_topology();
+
 	m_vertexElementStorage.m_attachmentPipe.register_element(v);
 	m_vertexElementStorage.m_sectionContainer.insert(v, v->container_section());
 
@@ -218,6 +224,9 @@ void Grid::register_and_replace_element(Vertex* v, Vertex* pReplaceMe)
 
 void Grid::unregister_vertex(Vertex* v)
 {
+	if(m_topologyFrozen)
+		thaw_topology();
+
 //	notify observers that the vertex is being erased
 	NOTIFY_OBSERVERS_REVERSE(m_vertexObservers, vertex_to_be_erased(this, v));
 
@@ -480,6 +489,9 @@ void Grid::register_edge(Edge* e, GridObject* pParent,
 {
 	GCM_PROFILE_FUNC();
 
+	if(m_topologyFrozen)
+		thaw_topology();
+
 //	store the element and register it at the pipe.
 	m_edgeElementStorage.m_attachmentPipe.register_element(e);
 	m_edgeElementStorage.m_sectionContainer.insert(e, e->container_section());
@@ -607,6 +619,9 @@ void Grid::register_edge(Edge* e, GridObject* pParent,
 
 void Grid::register_and_replace_element(Edge* e, Edge* pReplaceMe)
 {
+	if(m_topologyFrozen)
+		thaw_topology();
+
 //	store the element and register it at the pipe.
 	m_edgeElementStorage.m_attachmentPipe.register_element(e);
 	m_edgeElementStorage.m_sectionContainer.insert(e, e->container_section());
@@ -677,6 +692,9 @@ void Grid::register_and_replace_element(Edge* e, Edge* pReplaceMe)
 
 void Grid::unregister_edge(Edge* e)
 {
+	if(m_topologyFrozen)
+		thaw_topology();
+
 //	notify observers that the edge is being erased
 	NOTIFY_OBSERVERS_REVERSE(m_edgeObservers, edge_to_be_erased(this, e));
 
@@ -923,6 +941,9 @@ void Grid::register_face(Face* f, GridObject* pParent, Volume* createdByVol)
 {
 	GCM_PROFILE_FUNC();
 
+	if(m_topologyFrozen)
+		thaw_topology();
+
 //	store the element and register it at the pipe.
 	m_faceElementStorage.m_attachmentPipe.register_element(f);
 	m_faceElementStorage.m_sectionContainer.insert(f, f->container_section());
@@ -1043,6 +1064,9 @@ void Grid::register_face(Face* f, GridObject* pParent, Volume* createdByVol)
 
 void Grid::register_and_replace_element(Face* f, Face* pReplaceMe)
 {
+	if(m_topologyFrozen)
+		thaw_topology();
+
 //	check that f and pReplaceMe have the same amount of vertices.
 	if(f->num_vertices() != pReplaceMe->num_vertices())
 	{
@@ -1127,6 +1151,9 @@ void Grid::register_and_replace_element(Face* f, Face* pReplaceMe)
 
 void Grid::unregister_face(Face* f)
 {
+	if(m_topologyFrozen)
+		thaw_topology();
+
 //	notify observers that the face is being erased
 	NOTIFY_OBSERVERS_REVERSE(m_faceObservers, face_to_be_erased(this, f));
 
@@ -1441,6 +1468,9 @@ void Grid::register_volume(Volume* v, GridObject* pParent)
 {
 	GCM_PROFILE_FUNC();
 
+	if(m_topologyFrozen)
+		thaw_topology();
+
 //	store the element and register it at the pipe.
 	m_volumeElementStorage.m_attachmentPipe.register_element(v);
 	m_volumeElementStorage.m_sectionContainer.insert(v, v->container_section());
@@ -1575,6 +1605,9 @@ void Grid::register_volume(Volume* v, GridObject* pParent)
 
 void Grid::register_and_replace_element(Volume* v, Volume* pReplaceMe)
 {
+	if(m_topologyFrozen)
+		thaw_topology();
+
 //	check that v and pReplaceMe have the same number of vertices.
 	if(v->num_vertices() != pReplaceMe->num_vertices())
 	{
@@ -1656,6 +1689,9 @@ void Grid::register_and_replace_element(Volume* v, Volume* pReplaceMe)
 
 void Grid::unregister_volume(Volume* v)
 {
+	if(m_topologyFrozen)
+		thaw_topology();
+
 //	notify observers that the face is being erased
 	NOTIFY_OBSERVERS_REVERSE(m_volumeObservers, volume_to_be_erased(this, v));
 
@@ -2085,6 +2121,9 @@ void Grid::volume_sort_associated_edge_container()
 //	replace_vertex
 bool Grid::replace_vertex(Vertex* vrtOld, Vertex* vrtNew)
 {
+	if(m_topologyFrozen)
+		thaw_topology();
+
 //	this bool should be a parameter. However one first would have
 //	to add connectivity updates for double-elements in this method,
 //	to handle the case when eraseDoubleElements is set to false.
@@ -2639,11 +2678,7 @@ void Grid::get_associated(SecureEdgeContainer& edges, Vertex* v)
 		vertex_store_associated_edges(true);
 	}
 
-	EdgeContainer& assEdges = m_aaEdgeContainerVERTEX[v];
-	if(assEdges.empty())
-		edges.clear();
-	else
-		edges.set_external_array(&assEdges.front(), assEdges.size());
+	get_stored_associated(edges, v, m_aaEdgeContainerVERTEX, m_frozenEdgesVERTEX);
 }
 
 void Grid::get_associated(SecureEdgeContainer& edges, Face* f)
@@ -2652,11 +2687,7 @@ void Grid::get_associated(SecureEdgeContainer& edges, Face* f)
 	if(option_is_enabled(FACEOPT_STORE_ASSOCIATED_EDGES))
 	{
 	//	we can output the associated array directly
-		EdgeContainer& assEdges = m_aaEdgeContainerFACE[f];
-		if(assEdges.empty())
-			edges.clear();
-		else
-			edges.set_external_array(&assEdges.front(), assEdges.size());
+		get_stored_associated(edges, f, m_aaEdgeContainerFACE, m_frozenEdgesFACE);
 	}
 	else{
 	//	clear the container
@@ -2682,11 +2713,7 @@ void Grid::get_associated(SecureEdgeContainer& edges, Volume* v)
 	if(option_is_enabled(VOLOPT_STORE_ASSOCIATED_EDGES))
 	{
 	//	we can output the associated array directly
-		EdgeContainer& assEdges = m_aaEdgeContainerVOLUME[v];
-		if(assEdges.empty())
-			edges.clear();
-		else
-			edges.set_external_array(&assEdges.front(), assEdges.size());
+		get_stored_associated(edges, v, m_aaEdgeContainerVOLUME, m_frozenEdgesVOLUME);
 	}
 	else{
 	//	clear the container
@@ -2725,11 +2752,7 @@ void Grid::get_associated(SecureFaceContainer& faces, Vertex* v)
 		vertex_store_associated_faces(true);
 	}
 
-	FaceContainer& assFaces = m_aaFaceContainerVERTEX[v];
-	if(assFaces.empty())
-		faces.clear();
-	else
-		faces.set_external_array(&assFaces.front(), assFaces.size());
+	get_stored_associated(faces, v, m_aaFaceContainerVERTEX, m_frozenFacesVERTEX);
 }
 
 void Grid::get_associated(SecureFaceContainer& faces, Edge* e)
@@ -2737,11 +2760,7 @@ void Grid::get_associated(SecureFaceContainer& faces, Edge* e)
 //	best option: EDGEOPT_STORE_ASSOCIATED_FACES
 	if(option_is_enabled(EDGEOPT_STORE_ASSOCIATED_FACES)){
 	//	we can output the associated array directly
-		FaceContainer& assFaces = m_aaFaceContainerEDGE[e];
-		if(assFaces.empty())
-			faces.clear();
-		else
-			faces.set_external_array(&assFaces.front(), assFaces.size());
+		get_stored_associated(faces, e, m_aaFaceContainerEDGE, m_frozenFacesEDGE);
 	}
 	else{
 	//	second best: iterate through all faces associated with the first end-point of e
@@ -2769,10 +2788,12 @@ void Grid::get_associated(SecureFaceContainer& faces, Edge* e)
 		}
 */
 
-		FaceContainer& assFaces = m_aaFaceContainerVERTEX[vrt];
-		for(size_t i = 0; i < assFaces.size(); ++i){
-			if(FaceContains(assFaces[i], e))
-				faces.push_back(assFaces[i]);
+		AssociatedFaceIterator iterEnd = associated_faces_end(vrt);
+		for(AssociatedFaceIterator iter = associated_faces_begin(vrt);
+			iter != iterEnd; ++iter)
+		{
+			if(FaceContains(*iter, e))
+				faces.push_back(*iter);
 		}
 	}
 }
@@ -2783,11 +2804,7 @@ void Grid::get_associated(SecureFaceContainer& faces, Volume* v)
 	if(option_is_enabled(VOLOPT_STORE_ASSOCIATED_FACES))
 	{
 	//	we can output the associated array directly
-		FaceContainer& assFaces = m_aaFaceContainerVOLUME[v];
-		if(assFaces.empty())
-			faces.clear();
-		else
-			faces.set_external_array(&assFaces.front(), assFaces.size());
+		get_stored_associated(faces, v, m_aaFaceContainerVOLUME, m_frozenFacesVOLUME);
 	}
 	else{
 	//	clear the container
@@ -2826,11 +2843,7 @@ void Grid::get_associated(SecureVolumeContainer& vols, Vertex* v)
 		vertex_store_associated_volumes(true);
 	}
 
-	VolumeContainer& assVols = m_aaVolumeContainerVERTEX[v];
-	if(assVols.empty())
-		vols.clear();
-	else
-		vols.set_external_array(&assVols.front(), assVols.size());
+	get_stored_associated(vols, v, m_aaVolumeContainerVERTEX, m_frozenVolumesVERTEX);
 }
 
 void Grid::get_associated(SecureVolumeContainer& vols, Edge* e)
@@ -2838,11 +2851,7 @@ void Grid::get_associated(SecureVolumeContainer& vols, Edge* e)
 //	best option: EDGEOPT_STORE_ASSOCIATED_VOLUMES
 	if(option_is_enabled(EDGEOPT_STORE_ASSOCIATED_VOLUMES)){
 	//	we can output the associated array directly
-		VolumeContainer& assVols = m_aaVolumeContainerEDGE[e];
-		if(assVols.empty())
-			vols.clear();
-		else
-			vols.set_external_array(&assVols.front(), assVols.size());
+		get_stored_associated(vols, e, m_aaVolumeContainerEDGE, m_frozenVolumesEDGE);
 	}
 	else{
 	//	second best: iterate through all volumes associated with the first end-point of e
@@ -2870,10 +2879,12 @@ void Grid::get_associated(SecureVolumeContainer& vols, Edge* e)
 		}
 */
 
-		VolumeContainer& assVols = m_aaVolumeContainerVERTEX[vrt];
-		for(size_t i = 0; i < assVols.size(); ++i){
-			if(VolumeContains(assVols[i], e))
-				vols.push_back(assVols[i]);
+		AssociatedVolumeIterator iterEnd = associated_volumes_end(vrt);
+		for(AssociatedVolumeIterator iter = associated_volumes_begin(vrt);
+			iter != iterEnd; ++iter)
+		{
+			if(VolumeContains(*iter, e))
+				vols.push_back(*iter);
 		}
 	}
 }
@@ -2883,11 +2894,7 @@ void Grid::get_associated(SecureVolumeContainer& vols, Face* f)
 //	best option: FACEOPT_STORE_ASSOCIATED_VOLUMES
 	if(option_is_enabled(FACEOPT_STORE_ASSOCIATED_VOLUMES)){
 	//	we can output the associated array directly
-		VolumeContainer& assVols = m_aaVolumeContainerFACE[f];
-		if(assVols.empty())
-			vols.clear();
-		else
-			vols.set_external_array(&assVols.front(), assVols.size());
+		get_stored_associated(vols, f, m_aaVolumeContainerFACE, m_frozenVolumesFACE);
 	}
 	else
 		get_associated_vols_raw(vols, f);
@@ -2914,9 +2921,11 @@ void Grid::get_associated_vols_raw(SecureVolumeContainer& vols, Face* f)
 //	check as few faces as possible
 	Vertex* vrt = f->vertex(0);
 
-	VolumeContainer& assVols = m_aaVolumeContainerVERTEX[vrt];
-	for(size_t i = 0; i < assVols.size(); ++i){
-		Volume* v = assVols[i];
+	AssociatedVolumeIterator iterEnd = associated_volumes_end(vrt);
+	for(AssociatedVolumeIterator iter = associated_volumes_begin(vrt);
+		iter != iterEnd; ++iter)
+	{
+		Volume* v = *iter;
 		if(VolumeContains(v, f->vertex(1))){
 			if(VolumeContains(v, f->vertex(2))){
 				if(VolumeContains(v, f))
@@ -2957,8 +2966,7 @@ void Grid::get_associated_sorted(SecureEdgeContainer& edges, Face* f)
 					   | FACEOPT_STORE_ASSOCIATED_EDGES))
 	{
 	//	we can output the associated array directly
-		EdgeContainer& assEdges = m_aaEdgeContainerFACE[f];
-		edges.set_external_array(&assEdges.front(), assEdges.size());
+		get_stored_associated(edges, f, m_aaEdgeContainerFACE, m_frozenEdgesFACE);
 	}
 	else{
 	//	clear the container
@@ -2988,8 +2996,7 @@ void Grid::get_associated_sorted(SecureEdgeContainer& edges, Volume* v)
 							| VOLOPT_STORE_ASSOCIATED_EDGES))
 	{
 	//	we can output the associated array directly
-		EdgeContainer& assEdges = m_aaEdgeContainerVOLUME[v];
-		edges.set_external_array(&assEdges.front(), assEdges.size());
+		get_stored_associated(edges, v, m_aaEdgeContainerVOLUME, m_frozenEdgesVOLUME);
 	}
 	else{
 	//	clear the container
@@ -3026,8 +3033,7 @@ void Grid::get_associated_sorted(SecureFaceContainer& faces, Volume* v)
 					   | VOLOPT_STORE_ASSOCIATED_FACES))
 	{
 	//	we can output the associated array directly
-		FaceContainer& assFaces = m_aaFaceContainerVOLUME[v];
-		faces.set_external_array(&assFaces.front(), assFaces.size());
+		get_stored_associated(faces, v, m_aaFaceContainerVOLUME, m_frozenFacesVOLUME);
 	}
 	else{
 	//	clear the container
@@ -601,6 +601,101 @@ Volume* Grid::find_volume_in_associated_volumes(TGeomObj* obj,
 }
 
 
+////////////////////////////////////////////////////////////////////////
+//	frozen topology
+template <class TElem, class TAssElem>
+void Grid::
+freeze_association(FrozenAssociation<TAssElem>& fa,
+				   AttachmentAccessor<TElem, Attachment<std::vector<TAssElem*> > >& aaCon,
+				   Attachment<std::vector<TAssElem*> >& aCon)
+{
+	typedef typename geometry_traits<TElem>::iterator	ElemIter;
+
+//	count the associated elements of each element. Unused data indices
+//	simply receive an empty range.
+	const size_t numEntries = attachment_container_size<TElem>();
+	fa.offsets.assign(numEntries + 1, 0);
+
+	for(ElemIter iter = begin<TElem>(); iter != end<TElem>(); ++iter)
+		fa.offsets[get_attachment_data_index(*iter) + 1] = aaCon[*iter].size();
+
+	for(size_t i = 0; i < numEntries; ++i)
+		fa.offsets[i + 1] += fa.offsets[i];
+
+//	copy the associated elements to the compressed array
+	fa.elems.resize(fa.offsets[numEntries]);
+	for(ElemIter iter = begin<TElem>(); iter != end<TElem>(); ++iter){
+		std::vector<TAssElem*>& con = aaCon[*iter];
+		std::copy(con.begin(), con.end(),
+				  fa.elems.begin() + fa.offsets[get_attachment_data_index(*iter)]);
+	}
+
+//	release the per-element containers
+	detach_from<TElem>(aCon);
+	fa.frozen = true;
+}
+
+template <class TElem, class TAssElem>
+void Grid::
+thaw_association(FrozenAssociation<TAssElem>& fa,
+				 AttachmentAccessor<TElem, Attachment<std::vector<TAssElem*> > >& aaCon,
+				 Attachment<std::vector<TAssElem*> >& aCon)
+{
+	typedef typename geometry_traits<TElem>::iterator	ElemIter;
+
+	attach_to<TElem>(aCon);
+	aaCon.access(*this, aCon);
+
+	for(ElemIter iter = begin<TElem>(); iter != end<TElem>(); ++iter){
+		const size_t ind = get_attachment_data_index(*iter);
+		aaCon[*iter].assign(fa.elems.begin() + fa.offsets[ind],
+							fa.elems.begin() + fa.offsets[ind + 1]);
+	}
+
+	std::vector<TAssElem*>().swap(fa.elems);
+	std::vector<size_t>().swap(fa.offsets);
+	fa.frozen = false;
+}
+
+template <class TElem, class TAssElem>
+inline typename std::vector<TAssElem*>::iterator Grid::
+frozen_begin(FrozenAssociation<TAssElem>& fa, TElem* e)
+{
+	return fa.elems.begin() + fa.offsets[get_attachment_data_index(e)];
+}
+
+template <class TElem, class TAssElem>
+inline typename std::vector<TAssElem*>::iterator Grid::
+frozen_end(FrozenAssociation<TAssElem>& fa, TElem* e)
+{
+	return fa.elems.begin() + fa.offsets[get_attachment_data_index(e) + 1];
+}
+
+template <class TElem, class TAssElem>
+inline void Grid::
+get_stored_associated(PointerConstArray<TAssElem*>& elemsOut, TElem* e,
+					  AttachmentAccessor<TElem, Attachment<std::vector<TAssElem*> > >& aaCon,
+					  FrozenAssociation<TAssElem>& fa)
+{
+	if(fa.frozen){
+		const size_t ind = get_attachment_data_index(e);
+		const size_t first = fa.offsets[ind];
+		const size_t num = fa.offsets[ind + 1] - first;
+		if(num == 0)
+			elemsOut.clear();
+		else
+			elemsOut.set_external_array(&fa.elems[first], num);
+	}
+	else{
+		std::vector<TAssElem*>& con = aaCon[e];
+		if(con.empty())
+			elemsOut.clear();
+		else
+			elemsOut.set_external_array(&con.front(), con.size());
+	}
+}
+
+
 ////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////
 //	implementation of Grids AttachmentAccessors
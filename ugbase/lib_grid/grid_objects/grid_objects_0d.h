@@ -67,6 +67,7 @@ class UG_API RegularVertex : public Vertex
 		virtual ~RegularVertex()	{}
 
 		virtual GridObject* create_empty_instance() const	{return new RegularVertex;}
+		UG_GRID_OBJECT_POOL(RegularVertex)
 
 		virtual int container_section() const	{return CSVRT_REGULAR_VERTEX;}
 		virtual ReferenceObjectID reference_object_id() const {return ROID_VERTEX;}
@@ -120,6 +121,7 @@ class UG_API ConstrainedVertex : public Vertex
 		}
 
 		virtual GridObject* create_empty_instance() const	{return new ConstrainedVertex;}
+		UG_GRID_OBJECT_POOL(ConstrainedVertex)
 
 		virtual int container_section() const	{return CSVRT_CONSTRAINED_VERTEX;}
 		virtual ReferenceObjectID reference_object_id() const {return ROID_VERTEX;}
@@ -84,6 +84,7 @@ class UG_API RegularEdge : public Edge
 		virtual ~RegularEdge()	{}
 
 		virtual GridObject* create_empty_instance() const	{return new RegularEdge;}
+		UG_GRID_OBJECT_POOL(RegularEdge)
 
 		virtual int container_section() const	{return CSEDGE_REGULAR_EDGE;}
 		virtual ReferenceObjectID reference_object_id() const {return ROID_EDGE;}
@@ -172,6 +173,7 @@ class UG_API ConstrainedEdge : public Edge
 		}
 
 		virtual GridObject* create_empty_instance() const	{return new ConstrainedEdge;}
+		UG_GRID_OBJECT_POOL(ConstrainedEdge)
 
 		virtual int container_section() const	{return CSEDGE_CONSTRAINED_EDGE;}
 		virtual ReferenceObjectID reference_object_id() const {return ROID_EDGE;}
@@ -310,6 +312,7 @@ class UG_API ConstrainingEdge : public Edge
 		}
 
 		virtual GridObject* create_empty_instance() const	{return new ConstrainingEdge;}
+		UG_GRID_OBJECT_POOL(ConstrainingEdge)
 
 		virtual int container_section() const	{return CSEDGE_CONSTRAINING_EDGE;}
 		virtual ReferenceObjectID reference_object_id() const {return ROID_EDGE;}
@@ -115,6 +115,7 @@ class UG_API CustomTriangle : public BaseClass
 		CustomTriangle(Vertex* v1, Vertex* v2, Vertex* v3);
 
 		virtual GridObject* create_empty_instance() const	{return new ConcreteTriangleType;}
+		UG_GRID_OBJECT_POOL(ConcreteTriangleType)
 		virtual ReferenceObjectID reference_object_id() const {return ROID_TRIANGLE;}
 
 		virtual Vertex* vertex(size_t index) const	{return m_vertices[index];}
@@ -260,6 +261,7 @@ class UG_API CustomQuadrilateral : public BaseClass
 							Vertex* v3, Vertex* v4);
 
 		virtual GridObject* create_empty_instance() const	{return new ConcreteQuadrilateralType;}
+		UG_GRID_OBJECT_POOL(ConcreteQuadrilateralType)
 		virtual ReferenceObjectID reference_object_id() const {return ROID_QUADRILATERAL;}
 
 		virtual Vertex* vertex(size_t index) const	{return m_vertices[index];}
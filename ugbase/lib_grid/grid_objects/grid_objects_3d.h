@@ -102,6 +102,7 @@ class UG_API Tetrahedron : public Volume
 		Tetrahedron(Vertex* v1, Vertex* v2, Vertex* v3, Vertex* v4);
 
 		virtual GridObject* create_empty_instance() const	{return new Tetrahedron;}
+		UG_GRID_OBJECT_POOL(Tetrahedron)
 
 		virtual Vertex* vertex(size_t index) const	{return m_vertices[index];}
 		virtual ConstVertexArray vertices() const		{return m_vertices;}
@@ -239,6 +240,7 @@ class UG_API Hexahedron : public Volume
 					Vertex* v5, Vertex* v6, Vertex* v7, Vertex* v8);
 
 		virtual GridObject* create_empty_instance() const	{return new Hexahedron;}
+		UG_GRID_OBJECT_POOL(Hexahedron)
 
 		virtual Vertex* vertex(size_t index) const	{return m_vertices[index];}
 		virtual ConstVertexArray vertices() const		{return m_vertices;}
@@ -372,6 +374,7 @@ class UG_API Prism : public Volume
 				Vertex* v4, Vertex* v5, Vertex* v6);
 
 		virtual GridObject* create_empty_instance() const	{return new Prism;}
+		UG_GRID_OBJECT_POOL(Prism)
 
 		virtual Vertex* vertex(size_t index) const	{return m_vertices[index];}
 		virtual ConstVertexArray vertices() const		{return m_vertices;}
@@ -505,6 +508,7 @@ class UG_API Pyramid : public Volume
 				Vertex* v4, Vertex* v5);
 
 		virtual GridObject* create_empty_instance() const	{return new Pyramid;}
+		UG_GRID_OBJECT_POOL(Pyramid)
 
 		virtual Vertex* vertex(size_t index) const	{return m_vertices[index];}
 		virtual ConstVertexArray vertices() const		{return m_vertices;}
@@ -637,6 +641,7 @@ class UG_API Octahedron : public Volume
 		Octahedron(Vertex* v1, Vertex* v2, Vertex* v3, Vertex* v4, Vertex* v5, Vertex* v6);
 
 		virtual GridObject* create_empty_instance() const	{return new Octahedron;}
+		UG_GRID_OBJECT_POOL(Octahedron)
 
 		virtual Vertex* vertex(size_t index) const	{return m_vertices[index];}
 		virtual ConstVertexArray vertices() const		{return m_vertices;}
@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <fstream>
+#include <algorithm>
+#include "partitioned_grid_file.h"
+#include "common/serialization.h"
+#include "common/profiler/profiler.h"
+#include "lib_grid/tools/selector_multi_grid.h"
+#include "lib_grid/lib_grid_messages.h"
+
+#ifdef UG_PARALLEL
+	#include "pcl/pcl_base.h"
+	#include "pcl/parallel_file.h"
+	#include "distributed_grid.h"
+#endif
+
+using namespace std;
+
+namespace ug{
+
+static const int PARTITIONED_GRID_MAGIC_BEGIN = 0x55475047;
+static const int PARTITIONED_GRID_MAGIC_END = 0x45475047;
+
+typedef Attachment<vector<int> >	AProcs;
+
+////////////////////////////////////////////////////////////////////////
+//	layouts
+template <class TElem>
+static void SerializeLayouts(BinaryBuffer& out, GridLayoutMap& glm,
+							 MultiElementAttachmentAccessor<AInt>& aaIndex)
+{
+	typedef typename GridLayoutMap::Types<TElem>::Map::iterator MapIter;
+	typedef typename GridLayoutMap::Types<TElem>::Layout Layout;
+	typedef typename GridLayoutMap::Types<TElem>::Interface Interface;
+
+	int numLayouts = 0;
+	for(MapIter iter = glm.layouts_begin<TElem>(); iter != glm.layouts_end<TElem>(); ++iter)
+		++numLayouts;
+	Serialize(out, numLayouts);
+
+	for(MapIter iter = glm.layouts_begin<TElem>(); iter != glm.layouts_end<TElem>(); ++iter)
+	{
+		Layout& layout = iter->second;
+		Serialize(out, iter->first);
+		Serialize(out, layout.num_levels());
+
+		for(size_t lvl = 0; lvl < layout.num_levels(); ++lvl)
+		{
+			int numIntfcs = 0;
+			for(typename Layout::iterator iIntfc = layout.begin(lvl);
+				iIntfc != layout.end(lvl); ++iIntfc)
+				++numIntfcs;
+			Serialize(out, numIntfcs);
+
+			for(typename Layout::iterator iIntfc = layout.begin(lvl);
+				iIntfc != layout.end(lvl); ++iIntfc)
+			{
+				Interface& intfc = layout.interface(iIntfc);
+				Serialize(out, layout.proc_id(iIntfc));
+				Serialize(out, intfc.size());
+				for(typename Interface::iterator iter = intfc.begin();
+					iter != intfc.end(); ++iter)
+					Serialize(out, aaIndex[intfc.get_element(iter)]);
+			}
+		}
+	}
+}
+
+template <class TElem>
+static void DeserializeLayouts(BinaryBuffer& in, GridLayoutMap& glm,
+							   const vector<TElem*>& vElem)
+{
+	typedef typename GridLayoutMap::Types<TElem>::Layout Layout;
+	typedef typename GridLayoutMap::Types<TElem>::Interface Interface;
+
+	int numLayouts = Deserialize<int>(in);
+	for(int i = 0; i < numLayouts; ++i)
+	{
+		int key = Deserialize<int>(in);
+		size_t numLevels = Deserialize<size_t>(in);
+		Layout& layout = glm.get_layout<TElem>(key);
+
+		for(size_t lvl = 0; lvl < numLevels; ++lvl)
+		{
+			int numIntfcs = Deserialize<int>(in);
+			for(int j = 0; j < numIntfcs; ++j)
+			{
+				int procID = Deserialize<int>(in);
+				size_t size = Deserialize<size_t>(in);
+				Interface& intfc = layout.interface(procID, lvl);
+				for(size_t k = 0; k < size; ++k){
+					int ind = Deserialize<int>(in);
+					UG_COND_THROW(ind < 0 || (size_t)ind >= vElem.size(),
+								  "Invalid element index in serialized grid layout.");
+					intfc.push_back(vElem[ind]);
+				}
+			}
+		}
+	}
+}
+
+void SerializeGridLayouts(BinaryBuffer& out, GridLayoutMap& glm,
+						  MultiElementAttachmentAccessor<AInt>& aaIndex)
+{
+	SerializeLayouts<Vertex>(out, glm, aaIndex);
+	SerializeLayouts<Edge>(out, glm, aaIndex);
+	SerializeLayouts<Face>(out, glm, aaIndex);
+	SerializeLayouts<Volume>(out, glm, aaIndex);
+}
+
+void DeserializeGridLayouts(BinaryBuffer& in, GridLayoutMap& glm,
+							const vector<Vertex*>& vrts,
+							const vector<Edge*>& edges,
+							const vector<Face*>& faces,
+							const vector<Volume*>& vols)
+{
+	DeserializeLayouts<Vertex>(in, glm, vrts);
+	DeserializeLayouts<Edge>(in, glm, edges);
+	DeserializeLayouts<Face>(in, glm, faces);
+	DeserializeLayouts<Volume>(in, glm, vols);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	SavePartitionedGrid
+///	adds the processes of all elements of type TAssElem associated with elem
+template <class TAssElem, class TElem>
+static void AddProcsOfAssociated(MultiGrid& mg, TElem* elem,
+								 MultiElementAttachmentAccessor<AProcs>& aaProcs,
+								 vector<int>& procsOut)
+{
+	typename Grid::traits<TAssElem>::secure_container assElems;
+	mg.associated_elements(assElems, elem);
+	for(size_t i = 0; i < assElems.size(); ++i){
+		vector<int>& assProcs = aaProcs[assElems[i]];
+		procsOut.insert(procsOut.end(), assProcs.begin(), assProcs.end());
+	}
+}
+
+///	collects the target processes of all elements of the given type
+/**	The processes of elements of higher dimension have to be known already.*/
+template <class TElem>
+static void CollectTargetProcs(MultiGrid& mg, SubsetHandler& shPartition,
+							   const vector<int>& targetProcs,
+							   MultiElementAttachmentAccessor<AProcs>& aaProcs)
+{
+	typedef typename Grid::traits<TElem>::iterator iterator;
+	for(iterator iter = mg.begin<TElem>(); iter != mg.end<TElem>(); ++iter)
+	{
+		TElem* elem = *iter;
+		vector<int>& procs = aaProcs[elem];
+
+		int si = shPartition.get_subset_index(elem);
+		if(si >= 0)
+			procs.push_back(targetProcs.empty() ? si : targetProcs.at(si));
+
+		if(TElem::dim < 3) AddProcsOfAssociated<Volume>(mg, elem, aaProcs, procs);
+		if(TElem::dim < 2) AddProcsOfAssociated<Face>(mg, elem, aaProcs, procs);
+		if(TElem::dim < 1) AddProcsOfAssociated<Edge>(mg, elem, aaProcs, procs);
+
+		sort(procs.begin(), procs.end());
+		procs.erase(unique(procs.begin(), procs.end()), procs.end());
+
+		UG_COND_THROW(procs.empty(), "SavePartitionedGrid: An element of type "
+					  << elem->reference_object_id() << " is not contained in"
+					  " any partition.");
+	}
+}
+
+///	selects all elements of the partition of proc and creates its horizontal interfaces
+template <class TElem>
+static void SelectPartition(MultiGrid& mg, MGSelector& sel, GridLayoutMap& glm,
+							int proc, MultiElementAttachmentAccessor<AProcs>& aaProcs)
+{
+	typedef typename Grid::traits<TElem>::iterator iterator;
+
+//	elements are added to the interfaces in the order of the grid on all
+//	processes, so that the order of master and slave interfaces matches.
+	for(iterator iter = mg.begin<TElem>(); iter != mg.end<TElem>(); ++iter)
+	{
+		TElem* elem = *iter;
+		const vector<int>& procs = aaProcs[elem];
+		if(!binary_search(procs.begin(), procs.end(), proc))
+			continue;
+
+		sel.select(elem);
+		if(procs.size() < 2)
+			continue;
+
+		if(procs.front() == proc){
+			for(size_t i = 1; i < procs.size(); ++i)
+				glm.get_layout<TElem>(INT_H_MASTER).interface(procs[i], 0).push_back(elem);
+		}
+		else
+			glm.get_layout<TElem>(INT_H_SLAVE).interface(procs.front(), 0).push_back(elem);
+	}
+}
+
+void SavePartitionedGrid(MultiGrid& mg, SubsetHandler& shPartition,
+						 const vector<int>& targetProcs,
+						 GridDataSerializationHandler& serializer,
+						 const char* filename)
+{
+	PROFILE_FUNC_GROUP("grid");
+
+	UG_COND_THROW(shPartition.grid() != &mg, "SavePartitionedGrid: The"
+				  " partition handler has to operate on the given grid.");
+	UG_COND_THROW(mg.num_levels() > 1, "SavePartitionedGrid: Only grids with"
+				  " one level are supported, but the grid has " << mg.num_levels()
+				  << " levels.");
+	UG_COND_THROW(!targetProcs.empty()
+				  && (int)targetProcs.size() < shPartition.num_subsets(),
+				  "SavePartitionedGrid: No target process given for some partitions.");
+
+//	the processes to which each element is written. The first one holds the master.
+	AProcs aProcs;
+	mg.attach_to_all(aProcs);
+	MultiElementAttachmentAccessor<AProcs> aaProcs(mg, aProcs);
+
+	CollectTargetProcs<Volume>(mg, shPartition, targetProcs, aaProcs);
+	CollectTargetProcs<Face>(mg, shPartition, targetProcs, aaProcs);
+	CollectTargetProcs<Edge>(mg, shPartition, targetProcs, aaProcs);
+	CollectTargetProcs<Vertex>(mg, shPartition, targetProcs, aaProcs);
+
+	int numProcs = 1;
+	for(int si = 0; si < shPartition.num_subsets(); ++si)
+		numProcs = max(numProcs, (targetProcs.empty() ? si : targetProcs[si]) + 1);
+
+//	the file starts with the header of pcl::WriteCombinedParallelFile,
+//	which is written after all offsets are known.
+	ofstream file(filename, ios::out | ios::binary | ios::trunc);
+	UG_COND_THROW(!file, "SavePartitionedGrid: Could not open " << filename);
+
+	vector<long long> vNextOffset(numProcs, 0);
+	long long offset = sizeof(int) + numProcs * sizeof(long long);
+	file.write((const char*)&numProcs, sizeof(int));
+	file.write((const char*)&vNextOffset[0], numProcs * sizeof(long long));
+
+	AInt aIndex;
+	mg.attach_to_all(aIndex);
+	MultiElementAttachmentAccessor<AInt> aaIndex(mg, aIndex);
+
+	MGSelector sel(mg);
+	for(int proc = 0; proc < numProcs; ++proc)
+	{
+		GridLayoutMap glm;
+		sel.clear();
+		SelectPartition<Vertex>(mg, sel, glm, proc, aaProcs);
+		SelectPartition<Edge>(mg, sel, glm, proc, aaProcs);
+		SelectPartition<Face>(mg, sel, glm, proc, aaProcs);
+		SelectPartition<Volume>(mg, sel, glm, proc, aaProcs);
+
+		BinaryBuffer buf;
+		Serialize(buf, PARTITIONED_GRID_MAGIC_BEGIN);
+		SerializeMultiGridElements(mg, sel.get_grid_objects(), aaIndex, buf);
+		serializer.write_infos(buf);
+		serializer.serialize(buf, sel.get_grid_objects());
+		SerializeGridLayouts(buf, glm, aaIndex);
+		Serialize(buf, PARTITIONED_GRID_MAGIC_END);
+
+		file.write(buf.buffer(), buf.write_pos());
+		offset += buf.write_pos();
+		vNextOffset[proc] = offset;
+	}
+
+	mg.detach_from_all(aIndex);
+	mg.detach_from_all(aProcs);
+
+	file.seekp(sizeof(int));
+	file.write((const char*)&vNextOffset[0], numProcs * sizeof(long long));
+	UG_COND_THROW(!file, "SavePartitionedGrid: Could not write " << filename);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	LoadPartitionedGrid
+void LoadPartitionedGrid(MultiGrid& mg, GridDataSerializationHandler& deserializer,
+						 const char* filename)
+{
+	PROFILE_FUNC_GROUP("grid");
+
+	UG_COND_THROW(mg.num<Vertex>() > 0, "LoadPartitionedGrid: The grid has"
+				  " to be empty.");
+
+//	read the part of this process
+	BinaryBuffer in;
+#ifdef UG_PARALLEL
+	pcl::ReadCombinedParallelFile(in, filename);
+#else
+	{
+		ifstream file(filename, ios::in | ios::binary);
+		UG_COND_THROW(!file, "LoadPartitionedGrid: Could not open " << filename);
+		int numProcs = 0;
+		long long nextOffset = 0;
+		file.read((char*)&numProcs, sizeof(int));
+		file.read((char*)&nextOffset, sizeof(long long));
+		UG_COND_THROW(!file || numProcs != 1, "LoadPartitionedGrid: " << filename
+					  << " was written for " << numProcs << " processes, but"
+					  " running on 1.");
+		size_t size = nextOffset - sizeof(int) - sizeof(long long);
+		vector<char> data(size);
+		if(size > 0)
+			file.read(&data[0], size);
+		UG_COND_THROW(!file, "LoadPartitionedGrid: Could not read " << filename);
+		if(size > 0)
+			in.write(&data[0], size);
+	}
+#endif
+
+	UG_COND_THROW(Deserialize<int>(in) != PARTITIONED_GRID_MAGIC_BEGIN,
+				  "LoadPartitionedGrid: " << filename << " is no partitioned grid file.");
+
+	mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STARTS, -1));
+
+#ifdef UG_PARALLEL
+	DistributedGridManager& distGridMgr = *mg.distributed_grid_manager();
+	distGridMgr.enable_interface_management(false);
+	GridLayoutMap& glm = distGridMgr.grid_layout_map();
+#else
+	GridLayoutMap glm;
+#endif
+
+	vector<Vertex*> vrts;
+	vector<Edge*> edges;
+	vector<Face*> faces;
+	vector<Volume*> vols;
+	DeserializeMultiGridElements(mg, in, &vrts, &edges, &faces, &vols);
+
+	deserializer.read_infos(in);
+	deserializer.deserialize(in, vrts.begin(), vrts.end());
+	deserializer.deserialize(in, edges.begin(), edges.end());
+	deserializer.deserialize(in, faces.begin(), faces.end());
+	deserializer.deserialize(in, vols.begin(), vols.end());
+
+	DeserializeGridLayouts(in, glm, vrts, edges, faces, vols);
+
+#ifdef UG_PARALLEL
+	distGridMgr.enable_interface_management(true);
+	distGridMgr.grid_layouts_changed(false);
+#endif
+
+	UG_COND_THROW(Deserialize<int>(in) != PARTITIONED_GRID_MAGIC_END,
+				  "LoadPartitionedGrid: Magic number mismatch at the end of the"
+				  " partition in " << filename);
+
+	mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STOPS, -1));
+	deserializer.deserialization_done();
+}
+
+}//	end of namespace
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__partitioned_grid_file
+#define __H__UG__partitioned_grid_file
+
+#include <vector>
+#include "lib_grid/multi_grid.h"
+#include "lib_grid/tools/subset_handler_grid.h"
+#include "lib_grid/algorithms/attachment_util.h"
+#include "lib_grid/algorithms/serialization.h"
+#include "parallel_grid_layout.h"
+
+namespace ug{
+
+///	Writes the interfaces of a grid layout map to a binary stream.
+/**	Elements are referenced by the indices stored in aaIndex, e.g. the indices
+ * assigned by SerializeMultiGridElements.*/
+void SerializeGridLayouts(BinaryBuffer& out, GridLayoutMap& glm,
+						  MultiElementAttachmentAccessor<AInt>& aaIndex);
+
+///	Reads interfaces written by SerializeGridLayouts and adds them to glm.
+/**	The vectors contain the elements in the order of their indices, e.g. as
+ * returned by DeserializeMultiGridElements.*/
+void DeserializeGridLayouts(BinaryBuffer& in, GridLayoutMap& glm,
+							const std::vector<Vertex*>& vrts,
+							const std::vector<Edge*>& edges,
+							const std::vector<Face*>& faces,
+							const std::vector<Volume*>& vols);
+
+///	Writes a partitioned grid file, from which each process reads its own part
+/**	The grid has to consist of one level only. Each element of the highest
+ * dimension has to be assigned to a partition in shPartition. The partition
+ * of subset i is read by process targetProcs[i] (or by process i, if
+ * targetProcs is empty). Lower dimensional elements are written to all
+ * partitions which contain an associated element. The process with the lowest
+ * rank holds the horizontal master of a shared element, all others hold
+ * horizontal slaves.
+ *
+ * The file is written by the calling process alone (it is meant to be
+ * created once in a preprocessing step) and has the format of
+ * pcl::WriteCombinedParallelFile. It has to be read by as many processes as
+ * the highest target process + 1. Processes which do not receive a partition
+ * read an empty grid.
+ *
+ * The serializer is used to write additional data like positions and
+ * subset handlers for each partition.
+ */
+void SavePartitionedGrid(MultiGrid& mg, SubsetHandler& shPartition,
+						 const std::vector<int>& targetProcs,
+						 GridDataSerializationHandler& serializer,
+						 const char* filename);
+
+///	Each process reads its partition of a file written by SavePartitionedGrid.
+/**	The grid has to be empty. The horizontal interfaces are created directly
+ * from the file, i.e. no redistribution and no communication (apart from
+ * reading the file) is required.
+ *
+ * The deserializer has to match the serializer used to write the file.*/
+void LoadPartitionedGrid(MultiGrid& mg, GridDataSerializationHandler& deserializer,
+						 const char* filename);
+
+}//	end of namespace
+
+#endif	//__H__UG__partitioned_grid_file
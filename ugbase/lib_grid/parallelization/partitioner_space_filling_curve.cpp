@@ -0,0 +1,637 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <limits>
+#include "partitioner_space_filling_curve.h"
+#include "load_balancer_util.h"
+#include "distributed_grid.h"
+#include "lib_grid/parallelization/util/compol_copy_attachment.h"
+#include "lib_grid/parallelization/util/compol_subset.h"
+#include "lib_grid/parallelization/parallelization_util.h"
+#include "lib_grid/algorithms/geom_obj_util/geom_obj_util.h"
+
+using namespace std;
+
+namespace ug{
+
+template <class TElem, int dim>
+Partitioner_SpaceFillingCurve<TElem, dim>::
+Partitioner_SpaceFillingCurve() :
+	m_mg(NULL),
+	m_hilbertCurveEnabled(true)
+{
+	m_processHierarchy = SPProcessHierarchy(new ProcessHierarchy);
+	m_processHierarchy->add_hierarchy_level(0, 1);
+
+	m_balanceWeights = make_sp(new IBalanceWeights());
+}
+
+template <class TElem, int dim>
+Partitioner_SpaceFillingCurve<TElem, dim>::
+~Partitioner_SpaceFillingCurve()
+{
+}
+
+////////////////////////////////
+//	SETTERS AND GETTERS
+////////////////////////////////
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_grid(MultiGrid* mg, Attachment<MathVector<dim> > aPos)
+{
+	m_mg = mg;
+	if(m_sh.valid())
+		m_sh->assign_grid(m_mg);
+	m_aPos = aPos;
+	m_aaPos.access(*m_mg, m_aPos);
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_subset_handler(SmartPtr<SubsetHandler> sh)
+{
+	m_sh = sh;
+	if(m_mg)
+		m_sh->assign_grid(m_mg);
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_next_process_hierarchy(SPProcessHierarchy procHierarchy)
+{
+	m_nextProcessHierarchy = procHierarchy;
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_balance_weights(SPBalanceWeights balanceWeights)
+{
+	m_balanceWeights = balanceWeights;
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_partition_pre_processor(SPPartitionPreProcessor ppp)
+{
+	m_partitionPreProcessor = ppp;
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_partition_post_processor(SPPartitionPostProcessor ppp)
+{
+	m_partitionPostProcessor = ppp;
+}
+
+template <class TElem, int dim>
+ConstSPProcessHierarchy Partitioner_SpaceFillingCurve<TElem, dim>::
+current_process_hierarchy() const
+{
+	return m_processHierarchy;
+}
+
+template <class TElem, int dim>
+ConstSPProcessHierarchy Partitioner_SpaceFillingCurve<TElem, dim>::
+next_process_hierarchy() const
+{
+	return m_nextProcessHierarchy;
+}
+
+template <class TElem, int dim>
+SubsetHandler& Partitioner_SpaceFillingCurve<TElem, dim>::
+get_partitions()
+{
+	if(m_sh.invalid()){
+		if(m_mg)
+			m_sh = make_sp(new SubsetHandler(*m_mg));
+		else
+			m_sh = make_sp(new SubsetHandler());
+	}
+	return *m_sh;
+}
+
+template <class TElem, int dim>
+const std::vector<int>* Partitioner_SpaceFillingCurve<TElem, dim>::
+get_process_map() const
+{
+	return NULL;
+}
+
+
+////////////////////////////////
+//	CURVE KEYS
+////////////////////////////////
+template <class TElem, int dim>
+uint64 Partitioner_SpaceFillingCurve<TElem, dim>::
+curve_key(const vector_t& p, const vector_t& boxMin, const vector_t& boxMax) const
+{
+	const uint64 maxCoord = (uint64(1) << s_bitsPerDim) - 1;
+
+//	map the point to integer coordinates in [0, maxCoord]
+	uint64 x[dim];
+	for(int i = 0; i < dim; ++i){
+		const number w = boxMax[i] - boxMin[i];
+		number r = 0;
+		if(w > 0)
+			r = max<number>(0, min<number>(1, (p[i] - boxMin[i]) / w));
+		x[i] = min<uint64>(maxCoord, (uint64)(r * (number)maxCoord));
+	}
+
+	if(m_hilbertCurveEnabled && (dim > 1)){
+	//	transform the coordinates to the transposed Hilbert index
+	//	(J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707, 2004)
+		const uint64 m = uint64(1) << (s_bitsPerDim - 1);
+		for(uint64 q = m; q > 1; q >>= 1){
+			const uint64 pMask = q - 1;
+			for(int i = 0; i < dim; ++i){
+				if(x[i] & q)
+					x[0] ^= pMask;
+				else{
+					const uint64 t = (x[0] ^ x[i]) & pMask;
+					x[0] ^= t;
+					x[i] ^= t;
+				}
+			}
+		}
+
+	//	gray encode
+		for(int i = 1; i < dim; ++i)
+			x[i] ^= x[i - 1];
+		uint64 t = 0;
+		for(uint64 q = m; q > 1; q >>= 1){
+			if(x[dim - 1] & q)
+				t ^= q - 1;
+		}
+		for(int i = 0; i < dim; ++i)
+			x[i] ^= t;
+	}
+
+//	interleave the bits. For the Morton curve this is all there is to do.
+	uint64 key = 0;
+	for(int b = s_bitsPerDim - 1; b >= 0; --b){
+		for(int i = 0; i < dim; ++i)
+			key = (key << 1) | ((x[i] >> b) & 1);
+	}
+	return key;
+}
+
+
+////////////////////////////////
+//	PARTITIONING
+////////////////////////////////
+template <class TElem, int dim>
+bool Partitioner_SpaceFillingCurve<TElem, dim>::
+partition(size_t baseLvl, size_t elementThreshold)
+{
+	GDIST_PROFILE_FUNC();
+
+	UG_COND_THROW(m_mg == NULL,
+			"No grid was specified for Partitioner_SpaceFillingCurve. "
+			"partitioning can't be executed without a specified grid.");
+
+	if(m_balanceWeights.invalid())
+		m_balanceWeights = make_sp(new IBalanceWeights());
+
+	MultiGrid& mg = *m_mg;
+	if(m_sh.invalid())
+		m_sh = make_sp(new SubsetHandler(mg));
+	SubsetHandler& sh = *m_sh;
+	sh.clear();
+
+	ANumber aWeight;
+	mg.attach_to<elem_t>(aWeight);
+
+	if(m_partitionPreProcessor.valid())
+		m_partitionPreProcessor->partitioning_starts(m_mg, this);
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->init_post_processing(m_mg, m_sh.get());
+
+//	assign all elements below baseLvl to the local process
+	for(int i = 0; i < (int)baseLvl; ++i)
+		sh.assign_subset(mg.begin<elem_t>(i), mg.end<elem_t>(i), 0);
+
+	const ProcessHierarchy* procH;
+	if(m_nextProcessHierarchy.valid())
+		procH = m_nextProcessHierarchy.get();
+	else
+		procH = m_processHierarchy.get();
+
+	m_problemsOccurred = false;
+
+	for(size_t hlevel = 0; hlevel < procH->num_hierarchy_levels(); ++ hlevel)
+	{
+		int numProcs = procH->num_global_procs_involved(hlevel);
+
+		int minLvl = procH->grid_base_level(hlevel);
+		int maxLvl = (int)mg.top_level();
+
+		if(m_balanceWeights->has_level_offsets()){
+			if(mg.top_level() < procH->grid_base_level(hlevel)){
+			//	see Partitioner_DynamicBisection::partition
+				if((hlevel == 0) ||
+					((int)procH->num_global_procs_involved(hlevel - 1) != numProcs))
+				{
+					UG_LOG("Partitioner_SpaceFillingCurve: Ignoring hierarchy level "
+						<< hlevel << " since it doesn't contain any elements yet\n");
+					m_problemsOccurred = true;
+				}
+				continue;
+			}
+		}
+
+		if(hlevel + 1 < procH->num_hierarchy_levels()){
+			maxLvl = min<int>(maxLvl,
+						(int)procH->grid_base_level(hlevel + 1) - 1);
+		}
+
+		if(minLvl < (int)baseLvl)
+			minLvl = (int)baseLvl;
+
+		if(maxLvl < minLvl)
+			continue;
+
+		if(numProcs <= 1){
+			for(int i = minLvl; i <= maxLvl; ++i)
+				sh.assign_subset(mg.begin<elem_t>(i), mg.end<elem_t>(i), 0);
+			continue;
+		}
+
+	//	if clustered siblings are enabled, we'll perform partitioning on the level
+	//	below minLvl (if such a level exists). However, only the partition-map
+	//	of minLvl and levels above will be adjusted.
+		int partitionLvl = minLvl;
+		pcl::ProcessCommunicator com(pcl::PCD_LOCAL);
+
+		if((minLvl > 0) && base_class::clustered_siblings_enabled()){
+			partitionLvl = minLvl - 1;
+			size_t partitionHLvl = m_processHierarchy->hierarchy_level_from_grid_level(partitionLvl);
+			com = m_processHierarchy->global_proc_com(partitionHLvl);
+		}
+		else
+			com = procH->global_proc_com(hlevel);
+
+		partition_level(numProcs, minLvl, maxLvl, partitionLvl, aWeight, com);
+
+		for(int i = minLvl; i < maxLvl; ++i){
+			copy_partitions_to_children(sh, i);
+		}
+	}
+
+	if(m_nextProcessHierarchy.valid()){
+		*m_processHierarchy = *m_nextProcessHierarchy;
+		m_nextProcessHierarchy = SPProcessHierarchy(NULL);
+	}
+
+	mg.detach_from<elem_t>(aWeight);
+
+	if(m_partitionPreProcessor.valid())
+		m_partitionPreProcessor->partitioning_done(m_mg, this);
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->partitioning_done();
+
+	PCL_DEBUG_BARRIER_ALL();
+	return true;
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+partition_level(int numTargetProcs, int minLvl, int maxLvl, int partitionLvl,
+				ANumber aWeight, pcl::ProcessCommunicator com)
+{
+	GDIST_PROFILE_FUNC();
+
+	typedef typename MultiGrid::traits<elem_t>::iterator iter_t;
+
+	MultiGrid&		mg	= *m_mg;
+	SubsetHandler&	sh	= *m_sh;
+	DistributedGridManager* pdgm = mg.distributed_grid_manager();
+
+	vector<int> origSubsetIndices;
+	if(partitionLvl < minLvl){
+		origSubsetIndices.reserve(mg.num<elem_t>(partitionLvl));
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter)
+		{
+			origSubsetIndices.push_back(sh.get_subset_index(*eiter));
+		}
+	}
+
+//	invalidate target partitions of all elements in partitionLvl
+	sh.assign_subset(mg.begin<elem_t>(partitionLvl),
+					 mg.end<elem_t>(partitionLvl), -1);
+
+	gather_weights(partitionLvl, minLvl, maxLvl, aWeight);
+
+	if(!com.empty()){
+		vector<KeyEntry> entries;
+		calculate_keys(entries, partitionLvl, aWeight, com);
+		sort(entries.begin(), entries.end());
+
+		vector<uint64> splitters;
+		find_splitters(splitters, entries, numTargetProcs, com);
+
+	//	entries and splitters are both sorted, so a simple merge suffices
+		int curPartition = 0;
+		for(size_t i = 0; i < entries.size(); ++i){
+			while((curPartition < (int)splitters.size())
+				  && (entries[i].key > splitters[curPartition]))
+			{
+				++curPartition;
+			}
+			sh.assign_subset(entries[i].elem, curPartition);
+		}
+	}
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->post_process(partitionLvl);
+
+	if(partitionLvl < minLvl){
+		UG_ASSERT(partitionLvl == minLvl - 1,
+				  "partitionLvl and minLvl should be neighbors");
+
+	//	copy subset indices from partition-level to minLvl
+		for(int i = partitionLvl; i < minLvl; ++i){
+			copy_partitions_to_children(sh, i);
+		}
+
+	//	reset partitions in the specified partition-level
+		size_t counter = 0;
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter, ++counter)
+		{
+			sh.assign_subset(*eiter, origSubsetIndices[counter]);
+		}
+	}
+	else if(pdgm){
+	//	copy subset indices from vertical slaves to vertical masters,
+	//	since partitioning was only performed on vslaves
+		GridLayoutMap& glm = pdgm->grid_layout_map();
+		ComPol_Subset<layout_t>	compolSHCopy(sh, true);
+
+		if(glm.has_layout<elem_t>(INT_V_SLAVE))
+			m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(partitionLvl),
+								 compolSHCopy);
+		if(glm.has_layout<elem_t>(INT_V_MASTER))
+			m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(partitionLvl),
+									compolSHCopy);
+		m_intfcCom.communicate();
+	}
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+gather_weights(int partitionLvl, int minLvl, int maxLvl, ANumber aWeight)
+{
+	GDIST_PROFILE_FUNC();
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+
+	IBalanceWeights& bw = *m_balanceWeights;
+	MultiGrid& mg = *m_mg;
+	DistributedGridManager* pdgm = mg.distributed_grid_manager();
+	Grid::AttachmentAccessor<elem_t, ANumber> aaWeight(mg, aWeight);
+	ComPol_CopyAttachment<layout_t, ANumber> compolCopy(mg, aWeight);
+
+	const bool levelOffsets = bw.has_level_offsets();
+	maxLvl = min<int>(maxLvl, (int)mg.top_level());
+
+	for(int lvl = maxLvl; lvl >= partitionLvl; --lvl){
+		for(ElemIter iter = mg.begin<elem_t>(lvl); iter != mg.end<elem_t>(lvl); ++iter)
+		{
+			elem_t* e = *iter;
+			number w = 0;
+			size_t numChildren = mg.num_children<elem_t>(e);
+			if(lvl < maxLvl){
+				for(size_t i = 0; i < numChildren; ++i)
+					w += aaWeight[mg.get_child<elem_t>(e, i)];
+			}
+
+			if(lvl >= minLvl){
+				if(levelOffsets && (numChildren == 0)
+				   && ((!pdgm) || (!pdgm->is_ghost(e)))
+				   && bw.consider_in_level_above(e))
+				{
+					w += bw.get_refined_weight(e);
+				}
+				else
+					w += bw.get_weight(e);
+			}
+			aaWeight[e] = w;
+		}
+
+	//	copy from v-slaves to v-masters, since v-masters don't have their
+	//	children on the local process.
+		if(pdgm && (lvl > partitionLvl)){
+			GridLayoutMap& glm = pdgm->grid_layout_map();
+			if(glm.has_layout<elem_t>(INT_V_SLAVE))
+				m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(lvl),
+									 compolCopy);
+			if(glm.has_layout<elem_t>(INT_V_MASTER))
+				m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(lvl),
+										compolCopy);
+			m_intfcCom.communicate();
+		}
+	}
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+calculate_keys(std::vector<KeyEntry>& entriesOut, int partitionLvl,
+			   ANumber aWeight, pcl::ProcessCommunicator& com)
+{
+	GDIST_PROFILE_FUNC();
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+
+	MultiGrid& mg = *m_mg;
+	DistributedGridManager* pdgm = mg.distributed_grid_manager();
+	Grid::AttachmentAccessor<elem_t, ANumber> aaWeight(mg, aWeight);
+
+	entriesOut.clear();
+	entriesOut.reserve(mg.num<elem_t>(partitionLvl));
+	vector<vector_t> centers;
+	centers.reserve(mg.num<elem_t>(partitionLvl));
+
+	number locMin[dim], locMax[dim];
+	for(int i = 0; i < dim; ++i){
+		locMin[i] = numeric_limits<number>::max();
+		locMax[i] = -numeric_limits<number>::max();
+	}
+
+	for(ElemIter iter = mg.begin<elem_t>(partitionLvl);
+		iter != mg.end<elem_t>(partitionLvl); ++iter)
+	{
+		elem_t* e = *iter;
+		if(pdgm && pdgm->is_ghost(e))
+			continue;
+
+		KeyEntry entry;
+		entry.key = 0;
+		entry.elem = e;
+		entry.weight = aaWeight[e];
+		entriesOut.push_back(entry);
+
+		centers.push_back(CalculateCenter(e, m_aaPos));
+		const vector_t& c = centers.back();
+		for(int i = 0; i < dim; ++i){
+			locMin[i] = min(locMin[i], c[i]);
+			locMax[i] = max(locMax[i], c[i]);
+		}
+	}
+
+//	the curve has to be the same on all processes
+	number globMin[dim], globMax[dim];
+	com.allreduce(locMin, globMin, dim, PCL_RO_MIN);
+	com.allreduce(locMax, globMax, dim, PCL_RO_MAX);
+
+	vector_t boxMin, boxMax;
+	for(int i = 0; i < dim; ++i){
+		boxMin[i] = globMin[i];
+		boxMax[i] = globMax[i];
+	}
+
+	for(size_t i = 0; i < entriesOut.size(); ++i)
+		entriesOut[i].key = curve_key(centers[i], boxMin, boxMax);
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+find_splitters(std::vector<uint64>& splittersOut,
+			   const std::vector<KeyEntry>& entries,
+			   int numPartitions, pcl::ProcessCommunicator& com)
+{
+	GDIST_PROFILE_FUNC();
+
+	splittersOut.clear();
+	if(numPartitions < 2)
+		return;
+
+	const size_t numCuts = (size_t)numPartitions - 1;
+
+//	local keys and weight prefix sums. prefix[i] holds the weight of entries [0, i).
+	vector<uint64> keys(entries.size());
+	vector<number> prefix(entries.size() + 1, 0);
+	for(size_t i = 0; i < entries.size(); ++i){
+		keys[i] = entries[i].key;
+		prefix[i + 1] = prefix[i] + entries[i].weight;
+	}
+
+	const number totalWeight = com.allreduce(prefix.back(), PCL_RO_SUM);
+
+//	perform a bisection on the key range for all cuts simultaneously. Since
+//	lower and upper bounds only depend on reduced values, they are identical
+//	on all processes.
+	const uint64 maxKey = (uint64(1) << (s_bitsPerDim * dim)) - 1;
+	vector<uint64> lower(numCuts, 0);
+	vector<uint64> upper(numCuts, maxKey);
+	vector<number> locWeights(numCuts), globWeights(numCuts);
+
+	while(1){
+		bool done = true;
+		for(size_t i = 0; i < numCuts; ++i){
+			if(lower[i] < upper[i]){
+				done = false;
+				uint64 mid = lower[i] + (upper[i] - lower[i]) / 2;
+				size_t num = upper_bound(keys.begin(), keys.end(), mid) - keys.begin();
+				locWeights[i] = prefix[num];
+			}
+			else
+				locWeights[i] = 0;
+		}
+
+		if(done)
+			break;
+
+		com.allreduce(&locWeights.front(), &globWeights.front(), numCuts, PCL_RO_SUM);
+
+		for(size_t i = 0; i < numCuts; ++i){
+			if(lower[i] < upper[i]){
+				uint64 mid = lower[i] + (upper[i] - lower[i]) / 2;
+				if(globWeights[i] >= totalWeight * (number)(i + 1) / (number)numPartitions)
+					upper[i] = mid;
+				else
+					lower[i] = mid + 1;
+			}
+		}
+	}
+
+	splittersOut.swap(lower);
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+copy_partitions_to_children(ISubsetHandler& partitionSH, int lvl)
+{
+	GDIST_PROFILE_FUNC();
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+	MultiGrid& mg = *m_mg;
+
+//	assign partitions to all children in this hierarchy level
+	for(ElemIter iter = mg.begin<elem_t>(lvl); iter != mg.end<elem_t>(lvl); ++iter)
+	{
+		size_t numChildren = mg.num_children<elem_t>(*iter);
+		int si = partitionSH.get_subset_index(*iter);
+		for(size_t i = 0; i < numChildren; ++i)
+			partitionSH.assign_subset(mg.get_child<elem_t>(*iter, i), si);
+	}
+
+	if(mg.is_parallel()){
+		GridLayoutMap& glm = mg.distributed_grid_manager()->grid_layout_map();
+	//	communicate partitions from v-masters to v-slaves, since v-slaves
+	//	havn't got no parents on their procs.
+		ComPol_Subset<layout_t>	compolSHCopy(partitionSH, true);
+		if(glm.has_layout<elem_t>(INT_V_MASTER)){
+			m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(lvl+1),
+								 compolSHCopy);
+		}
+		if(glm.has_layout<elem_t>(INT_V_SLAVE)){
+			m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(lvl+1),
+									compolSHCopy);
+		}
+		m_intfcCom.communicate();
+	}
+}
+
+
+template class Partitioner_SpaceFillingCurve<Edge, 1>;
+template class Partitioner_SpaceFillingCurve<Edge, 2>;
+template class Partitioner_SpaceFillingCurve<Face, 2>;
+template class Partitioner_SpaceFillingCurve<Edge, 3>;
+template class Partitioner_SpaceFillingCurve<Face, 3>;
+template class Partitioner_SpaceFillingCurve<Volume, 3>;
+
+}// end of namespace
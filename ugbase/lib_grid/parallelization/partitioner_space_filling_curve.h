@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__partitioner_space_filling_curve__
+#define __H__UG__partitioner_space_filling_curve__
+
+#include <vector>
+#include "common/types.h"
+#include "parallel_grid_layout.h"
+#include "partitioner.h"
+#include "pcl/pcl_interface_communicator.h"
+
+namespace ug{
+
+/// \addtogroup lib_grid_parallelization_distribution
+///	\{
+
+///	Parallel space filling curve partitioner
+/**	Elements are ordered along a Hilbert (default) or Morton curve through
+ * their centers. The curve is then cut into consecutive pieces of equal
+ * weight (as given by the balance weights). Partition i of a hierarchy
+ * level is assigned to process i of that level.
+ *
+ * Since the curve only depends on the geometry and since neighboring pieces
+ * are assigned to neighboring ranks, small changes in the element weights
+ * only lead to small shifts of the cuts. The partitioner is thus well suited
+ * for repartitioning of adaptive grids.
+ *
+ * Keys are sorted locally only. The weighted cut positions on the curve are
+ * determined by a collective bisection over the key range, so that no element
+ * data has to be exchanged during partitioning. The overall costs are
+ * O(n log n) locally plus a fixed number of reductions of size
+ * (numPartitions - 1).
+ *
+ * The partitioner can be used inside a LoadBalancer or separately. It can
+ * operate on serial and parallel multigrids.
+ */
+template <class TElem, int dim>
+class Partitioner_SpaceFillingCurve : public IPartitioner{
+	public:
+		typedef IPartitioner	 						base_class;
+		typedef TElem									elem_t;
+		typedef MathVector<dim>							vector_t;
+		typedef Attachment<vector_t>					apos_t;
+		typedef Grid::VertexAttachmentAccessor<apos_t>	aapos_t;
+		typedef typename GridLayoutMap::Types<elem_t>::Layout::LevelLayout	layout_t;
+
+		Partitioner_SpaceFillingCurve();
+		virtual ~Partitioner_SpaceFillingCurve();
+
+		void set_grid(MultiGrid* mg, Attachment<MathVector<dim> > aPos);
+
+	///	allows to optionally specify a subset-handler on which the balancer shall operate
+		void set_subset_handler(SmartPtr<SubsetHandler> sh);
+
+	///	enables the Hilbert curve. If disabled, the Morton (z-order) curve is used.
+	/**	enabled by default. The Hilbert curve leads to more compact partitions,
+	 * the Morton curve is slightly cheaper to evaluate.*/
+		void enable_hilbert_curve(bool enable)		{m_hilbertCurveEnabled = enable;}
+		bool hilbert_curve_enabled() const			{return m_hilbertCurveEnabled;}
+
+		virtual void set_next_process_hierarchy(SPProcessHierarchy procHierarchy);
+		virtual void set_balance_weights(SPBalanceWeights balanceWeights);
+
+		virtual void set_partition_pre_processor(SPPartitionPreProcessor ppp);
+		virtual void set_partition_post_processor(SPPartitionPostProcessor ppp);
+
+		virtual ConstSPProcessHierarchy current_process_hierarchy() const;
+		virtual ConstSPProcessHierarchy next_process_hierarchy() const;
+
+		virtual bool supports_balance_weights() const			{return true;}
+		virtual bool supports_repartitioning() const			{return true;}
+
+		virtual bool partition(size_t baseLvl, size_t elementThreshold);
+
+		virtual SubsetHandler& get_partitions();
+		virtual const std::vector<int>* get_process_map() const;
+
+	///	returns the key of the given point on the active curve.
+	/**	The point is mapped to the curve relative to the box [boxMin, boxMax].*/
+		uint64 curve_key(const vector_t& p, const vector_t& boxMin,
+						 const vector_t& boxMax) const;
+
+	private:
+		struct KeyEntry{
+			uint64	key;
+			elem_t*	elem;
+			number	weight;
+			bool operator<(const KeyEntry& e) const	{return key < e.key;}
+		};
+
+	///	number of bits per coordinate which are used to build a key
+		static const int s_bitsPerDim = 63 / dim;
+
+		void partition_level(int numTargetProcs, int minLvl, int maxLvl,
+							 int partitionLvl, ANumber aWeight,
+							 pcl::ProcessCommunicator com);
+
+	///	accumulates the weights of all elements in [minLvl, maxLvl] in their ancestors on partitionLvl
+		void gather_weights(int partitionLvl, int minLvl, int maxLvl, ANumber aWeight);
+
+	///	computes the keys of all elements on partitionLvl which aren't ghosts
+		void calculate_keys(std::vector<KeyEntry>& entriesOut, int partitionLvl,
+							ANumber aWeight, pcl::ProcessCommunicator& com);
+
+	///	returns for each of the first numPartitions-1 partitions the highest key it contains
+	/**	entries have to be sorted by key.*/
+		void find_splitters(std::vector<uint64>& splittersOut,
+							const std::vector<KeyEntry>& entries,
+							int numPartitions, pcl::ProcessCommunicator& com);
+
+		void copy_partitions_to_children(ISubsetHandler& partitionSH, int lvl);
+
+		MultiGrid*								m_mg;
+		apos_t									m_aPos;
+		aapos_t									m_aaPos;
+		SmartPtr<SubsetHandler>					m_sh;
+		SPProcessHierarchy						m_processHierarchy;
+		SPProcessHierarchy						m_nextProcessHierarchy;
+		pcl::InterfaceCommunicator<layout_t>	m_intfcCom;
+
+		SPBalanceWeights						m_balanceWeights;
+		SPPartitionPreProcessor					m_partitionPreProcessor;
+		SPPartitionPostProcessor				m_partitionPostProcessor;
+
+		bool	m_hilbertCurveEnabled;
+};
+
+///	\}
+
+}// end of namespace
+
+#endif
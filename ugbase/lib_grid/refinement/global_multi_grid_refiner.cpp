@@ -32,6 +32,7 @@
 
 #include <cassert>
 #include "common/profiler/profiler.h"
+#include "common/util/thread_util.h"
 #include "global_multi_grid_refiner.h"
 #include "lib_grid/algorithms/algorithms.h"
 #include "lib_grid/file_io/file_io.h"
@@ -54,6 +55,214 @@ using namespace std;
 namespace ug
 {
 
+////////////////////////////////////////////////////////////////////////
+//	helpers for the thread-parallel creation of children
+namespace{
+
+///	creates the child vertex and the child edges of an edge
+/**	Only reads the grid, so that one instance per thread may be used
+ * concurrently. The children are registered later on. Builders get raw
+ * pointers instead of smart pointers, since the reference counting of
+ * SmartPtr is not thread safe.*/
+class EdgeChildBuilder
+{
+	public:
+		typedef Edge	elem_t;
+
+		EdgeChildBuilder(MultiGrid& mg, const IGeometry3d*) : m_mg(mg)	{}
+
+		bool build(vector<Edge*>& vChildrenOut, Vertex** ppNewVrtOut, Edge* e)
+		{
+			Vertex* substituteVrts[2];
+			substituteVrts[0] = m_mg.get_child_vertex(e->vertex(0));
+			substituteVrts[1] = m_mg.get_child_vertex(e->vertex(1));
+			assert(substituteVrts[0] && substituteVrts[1]);
+
+			RegularVertex* nVrt = new RegularVertex;
+			e->refine(vChildrenOut, nVrt, substituteVrts);
+			assert((vChildrenOut.size() == 2) && "RegularEdge refine produced wrong number of edges.");
+			*ppNewVrtOut = nVrt;
+			return true;
+		}
+
+	private:
+		MultiGrid&		m_mg;
+};
+
+///	creates the children of a face and its center vertex, if required
+class FaceChildBuilder
+{
+	public:
+		typedef Face	elem_t;
+
+		FaceChildBuilder(MultiGrid& mg, const IGeometry3d*) : m_mg(mg)	{}
+
+		bool build(vector<Face*>& vChildrenOut, Vertex** ppNewVrtOut, Face* f)
+		{
+			m_vVrts.clear();
+			for(uint j = 0; j < f->num_vertices(); ++j)
+				m_vVrts.push_back(m_mg.get_child_vertex(f->vertex(j)));
+
+			m_vEdgeVrts.clear();
+			for(uint j = 0; j < f->num_edges(); ++j)
+				m_vEdgeVrts.push_back(m_mg.get_child_vertex(m_mg.get_edge(f, j)));
+
+			return f->refine(vChildrenOut, ppNewVrtOut, &m_vEdgeVrts.front(),
+							 NULL, &m_vVrts.front());
+		}
+
+	private:
+		MultiGrid&			m_mg;
+		vector<Vertex*>		m_vVrts;
+		vector<Vertex*>		m_vEdgeVrts;
+};
+
+///	creates the children of a volume and its center vertex, if required
+class VolumeChildBuilder
+{
+	public:
+		typedef Volume	elem_t;
+
+		VolumeChildBuilder(MultiGrid& mg, const IGeometry3d* geometry) :
+			m_mg(mg), m_geometry(geometry),
+		//	only used for tetrahedron or octahedron refinement
+			m_corners(6, vector3(0, 0, 0))
+		{}
+
+		bool build(vector<Volume*>& vChildrenOut, Vertex** ppNewVrtOut, Volume* v)
+		{
+			m_vVrts.clear();
+			for(uint j = 0; j < v->num_vertices(); ++j)
+				m_vVrts.push_back(m_mg.get_child_vertex(v->vertex(j)));
+
+			m_vEdgeVrts.clear();
+			for(uint j = 0; j < v->num_edges(); ++j)
+				m_vEdgeVrts.push_back(m_mg.get_child_vertex(m_mg.get_edge(v, j)));
+
+			m_vFaceVrts.clear();
+			for(uint j = 0; j < v->num_faces(); ++j)
+				m_vFaceVrts.push_back(m_mg.get_child_vertex(m_mg.get_face(v, j)));
+
+		//	if we're performing tetrahedral or octahedral refinement, we have to collect
+		//	the corner coordinates, so that the refinement algorithm may choose
+		//	the best interior diagonal.
+			vector3* pCorners = NULL;
+			if((v->num_vertices() == 4) && m_geometry){
+				for(size_t i = 0; i < 4; ++i){
+					m_corners[i] = m_geometry->pos(v->vertex(i));
+				}
+				pCorners = &m_corners.front();
+			}
+			if((v->reference_object_id() == ROID_OCTAHEDRON) && m_geometry){
+				for(size_t i = 0; i < 6; ++i){
+					m_corners[i] = m_geometry->pos(v->vertex(i));
+				}
+				pCorners = &m_corners.front();
+			}
+
+			return v->refine(vChildrenOut, ppNewVrtOut, &m_vEdgeVrts.front(),
+							 &m_vFaceVrts.front(), NULL, RegularVertex(),
+							 &m_vVrts.front(), pCorners);
+		}
+
+	private:
+		MultiGrid&				m_mg;
+		const IGeometry3d*		m_geometry;///< used for corner positions, may be NULL
+		vector<Vertex*>			m_vVrts;
+		vector<Vertex*>			m_vEdgeVrts;
+		vector<Vertex*>			m_vFaceVrts;
+		vector<vector3>			m_corners;
+};
+
+///	children of a range of parents, created by one thread
+template <class TElem>
+struct ChildChunk{
+	vector<TElem*>	children;
+	vector<size_t>	numChildren;///< number of children of each parent, -1 on failure
+	vector<Vertex*>	newVrts;	///< new center vertex of each parent or NULL
+};
+
+///	refines the given parents and registers their children in the multigrid
+/**	The children are created by TBuilder::build in static chunks, one chunk
+ * per thread. This only reads the grid and allocates the new objects.
+ * The registration of the children, which invokes the connection management
+ * and all grid observers, is then performed sequentially in the order of
+ * vParents. The resulting grid is thus independent of the number of threads.*/
+template <class TBuilder>
+void RefineAndRegister(MultiGrid& mg, const vector<typename TBuilder::elem_t*>& vParents,
+					   SPRefinementProjector projector, const char* elemName)
+{
+	typedef typename TBuilder::elem_t	elem_t;
+
+	const size_t numParents = vParents.size();
+	const int numThreads = NumThreadsForRange(numParents);
+	vector<ChildChunk<elem_t> > vChunks(numThreads);
+
+//	resolve the geometry once, no smart pointers are copied inside the parallel region
+	const IGeometry3d* pGeom = NULL;
+	if(projector.valid()){
+		SPIGeometry3d spGeom = projector->geometry();
+		pGeom = spGeom.get();
+	}
+
+#ifdef UG_OPENMP
+	#pragma omp parallel num_threads(numThreads)
+#endif
+	{
+		const int tid = ThreadIndex();
+		size_t from, to;
+		ThreadChunk(numParents, numThreads, tid, from, to);
+
+		ChildChunk<elem_t>& chunk = vChunks[tid];
+		chunk.numChildren.resize(to - from);
+		chunk.newVrts.resize(to - from);
+
+		TBuilder builder(mg, pGeom);
+		vector<elem_t*> vChildren;
+		for(size_t i = from; i < to; ++i){
+			Vertex* newVrt = NULL;
+			if(builder.build(vChildren, &newVrt, vParents[i])){
+				chunk.children.insert(chunk.children.end(), vChildren.begin(),
+									  vChildren.end());
+				chunk.numChildren[i - from] = vChildren.size();
+				chunk.newVrts[i - from] = newVrt;
+			}
+			else
+				chunk.numChildren[i - from] = (size_t)-1;
+		}
+	}
+
+	for(int t = 0; t < numThreads; ++t){
+		size_t from, to;
+		ThreadChunk(numParents, numThreads, t, from, to);
+		ChildChunk<elem_t>& chunk = vChunks[t];
+		size_t curChild = 0;
+		for(size_t i = from; i < to; ++i){
+			elem_t* parent = vParents[i];
+			const size_t numChildren = chunk.numChildren[i - from];
+			if(numChildren == (size_t)-1){
+				LOG("  WARNING in Refine: could not refine " << elemName << ".\n");
+				continue;
+			}
+
+		//	if a new vertex was generated, we have to register it
+			Vertex* newVrt = chunk.newVrts[i - from];
+			if(newVrt){
+				mg.register_element(newVrt, parent);
+			//	allow refCallback to calculate a new position
+				if(projector.valid())
+					projector->new_vertex(newVrt, parent);
+			}
+
+			for(size_t j = 0; j < numChildren; ++j, ++curChild)
+				mg.register_element(chunk.children[curChild], parent);
+		}
+	}
+}
+
+}//	end of anonymous namespace
+
+
 GlobalMultiGridRefiner::
 GlobalMultiGridRefiner(SPRefinementProjector projector) :
 	IRefiner(projector),
@@ -131,6 +340,20 @@ num_marked_elems(std::vector<int>& numMarkedElemsOut)
 		numMarkedElemsOut.back() = m_pMG->num<TElem>(m_pMG->top_level());
 }
 
+template <class TElem>
+void GlobalMultiGridRefiner::
+collect_refinable_elements(std::vector<TElem*>& vElemsOut, int lvl)
+{
+	MultiGrid& mg = *m_pMG;
+	vElemsOut.clear();
+	vElemsOut.reserve(mg.num<TElem>(lvl));
+	typedef typename geometry_traits<TElem>::iterator iter_t;
+	for(iter_t iter = mg.begin<TElem>(lvl); iter != mg.end<TElem>(lvl); ++iter){
+		if(refinement_is_allowed(*iter))
+			vElemsOut.push_back(*iter);
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////
 void GlobalMultiGridRefiner::perform_refinement()
 {
@@ -162,6 +385,32 @@ void GlobalMultiGridRefiner::perform_refinement()
 		}
 	}
 
+#ifdef UG_OPENMP
+//	the children of faces and volumes are built in parallel (see RefineAndRegister).
+//	get_edge and get_face may thus not search the elements associated with
+//	vertices, since this would auto-enable options inside the parallel region.
+	if(mg.num_faces() > 0){
+		if(!mg.option_is_enabled(FACEOPT_STORE_ASSOCIATED_EDGES))
+		{
+			LOG("WARNING in GlobalMultiGridRefiner::refine(): auto-enabling FACEOPT_STORE_ASSOCIATED_EDGES.\n");
+			mg.enable_options(FACEOPT_STORE_ASSOCIATED_EDGES);
+		}
+	}
+
+	if(mg.num_volumes() > 0){
+		if(!mg.option_is_enabled(VOLOPT_STORE_ASSOCIATED_EDGES))
+		{
+			LOG("WARNING in GlobalMultiGridRefiner::refine(): auto-enabling VOLOPT_STORE_ASSOCIATED_EDGES.\n");
+			mg.enable_options(VOLOPT_STORE_ASSOCIATED_EDGES);
+		}
+		if(!mg.option_is_enabled(VOLOPT_STORE_ASSOCIATED_FACES))
+		{
+			LOG("WARNING in GlobalMultiGridRefiner::refine(): auto-enabling VOLOPT_STORE_ASSOCIATED_FACES.\n");
+			mg.enable_options(VOLOPT_STORE_ASSOCIATED_FACES);
+		}
+	}
+#endif
+
 	if(mg.num_levels() == 0)
 		return;
 
@@ -185,43 +434,26 @@ void GlobalMultiGridRefiner::perform_refinement()
 //		In that case the algorithm reserves too much memory.
 //		Use e.g. a virtual method GlobalMultiGridRefiner::reserve_memory
 	GMGR_PROFILE(GMGR_Reserve);
-	{
-		int l = oldTopLevel;
-
-		GMGR_PROFILE(GMGR_ReserveVrtData);
-		mg.reserve<Vertex>(mg.num<Vertex>() +
-					+ mg.num<Vertex>(l) + mg.num<Edge>(l)
-					+ mg.num<Quadrilateral>(l) + mg.num<Hexahedron>(l));
-		GMGR_PROFILE_END();
-
-		GMGR_PROFILE(GMGR_ReserveEdgeData);
-		mg.reserve<Edge>(mg.num<Edge>()
-					+ 2 * mg.num<Edge>(l) + 3 * mg.num<Triangle>(l)
+	const int l = oldTopLevel;
+	const size_t numNewVrts = mg.num<Vertex>(l) + mg.num<Edge>(l)
+					+ mg.num<Quadrilateral>(l) + mg.num<Hexahedron>(l);
+	const size_t numNewEdges = 2 * mg.num<Edge>(l) + 3 * mg.num<Triangle>(l)
 					+ 4 * mg.num<Quadrilateral>(l) + 3 * mg.num<Prism>(l)
 					+ mg.num<Tetrahedron>(l)
-					+ 4 * mg.num<Pyramid>(l) + 6 * mg.num<Hexahedron>(l));
-		GMGR_PROFILE_END();
-
-		GMGR_PROFILE(GMGR_ReserveFaceData);
-		mg.reserve<Face>(mg.num<Face>()
-					+ 4 * mg.num<Face>(l) + 10 * mg.num<Prism>(l)
+					+ 4 * mg.num<Pyramid>(l) + 6 * mg.num<Hexahedron>(l);
+	const size_t numNewFaces = 4 * mg.num<Face>(l) + 10 * mg.num<Prism>(l)
 					+ 8 * mg.num<Tetrahedron>(l)
-					+ 9 * mg.num<Pyramid>(l) + 12 * mg.num<Hexahedron>(l));
-		GMGR_PROFILE_END();
-
-		GMGR_PROFILE(GMGR_ReserveVolData);
-		mg.reserve<Volume>(mg.num<Volume>()
-					+ 8 * mg.num<Tetrahedron>(l) + 8 * mg.num<Prism>(l)
-					+ 6 * mg.num<Pyramid>(l) + 8 * mg.num<Hexahedron>(l));
-		GMGR_PROFILE_END();
-	}
+					+ 9 * mg.num<Pyramid>(l) + 12 * mg.num<Hexahedron>(l);
+	const size_t numNewVols = 8 * mg.num<Tetrahedron>(l) + 8 * mg.num<Prism>(l)
+					+ 6 * mg.num<Pyramid>(l) + 8 * mg.num<Hexahedron>(l);
+	mg.reserve_new_elements(numNewVrts, numNewEdges, numNewFaces, numNewVols);
 	GMGR_PROFILE_END();
 	UG_DLOG(LIB_GRID, 1, " done.\n");
 
 	UG_DLOG(LIB_GRID, 1, " refinement begins.\n");
 //	notify derivates that refinement begins
 	refinement_step_begins();
-	
+
 //	cout << "num marked edges: " << m_selMarks.num<Edge>() << endl;
 //	cout << "num marked faces: " << m_selMarks.num<Face>() << endl;
 
@@ -231,19 +463,6 @@ void GlobalMultiGridRefiner::perform_refinement()
 		mg.enable_hierarchical_insertion(true);
 
 
-//	some buffers
-	vector<Vertex*> vVrts;
-	vector<Vertex*> vEdgeVrts;
-	vector<Vertex*> vFaceVrts;
-	vector<Edge*>	vEdges;
-	vector<Face*>		vFaces;
-	vector<Volume*>		vVols;
-	
-//	some repeatedly used objects
-	EdgeDescriptor ed;
-	FaceDescriptor fd;
-	VolumeDescriptor vd;
-
 	UG_DLOG(LIB_GRID, 1, "  creating new vertices\n");
 
 //	create new vertices from marked vertices
@@ -252,199 +471,46 @@ void GlobalMultiGridRefiner::perform_refinement()
 	{
 		if(!refinement_is_allowed(*iter))
 			continue;
-			
+		
 		Vertex* v = *iter;
 
 	//	create a new vertex in the next layer.
-		//GMGR_PROFILE(GMGR_Refine_CreatingVertices);
 		Vertex* nVrt = *mg.create_by_cloning(v, v);
 
 	//	allow refCallback to calculate a new position
 		if(m_projector.valid())
 			m_projector->new_vertex(nVrt, v);
-		//GMGR_PROFILE_END();
 	}
 
-
+//	The children of edges, faces and volumes are created in parallel chunks
+//	and registered sequentially afterwards (see RefineAndRegister).
 	UG_DLOG(LIB_GRID, 1, "  creating new edges\n");
-
-//	create new vertices and edges from marked edges
-	for(EdgeIterator iter = mg.begin<Edge>(oldTopLevel);
-		iter != mg.end<Edge>(oldTopLevel); ++iter)
 	{
-		if(!refinement_is_allowed(*iter))
-			continue;
-
+		GMGR_PROFILE(GMGR_RefineEdges);
+		vector<Edge*> vEdges;
+		collect_refinable_elements(vEdges, oldTopLevel);
 	//	collect_objects_for_refine removed all edges that already were
 	//	refined. No need to check that again.
-		Edge* e = *iter;
-
-	//	debug: make sure that both vertices may be refined
-/*		#ifdef UG_DEBUG
-			if(!refinement_is_allowed(e->vertex(0))
-				|| !refinement_is_allowed(e->vertex(1)))
-			{
-				UG_LOG("Can't refine edge between vertices ");
-				if(mg.has_vertex_attachment(aPosition)){
-					Grid::VertexAttachmentAccessor<APosition> aaPos(mg, aPosition);
-					UG_LOG(aaPos[e->vertex(0)] << " and " << aaPos[e->vertex(1)] << endl);
-				}
-				else if(mg.has_vertex_attachment(aPosition2)){
-					Grid::VertexAttachmentAccessor<APosition2> aaPos(mg, aPosition2);
-					UG_LOG(aaPos[e->vertex(0)] << " and " << aaPos[e->vertex(1)] << endl);
-				}
-				else if(mg.has_vertex_attachment(aPosition1)){
-					Grid::VertexAttachmentAccessor<APosition1> aaPos(mg, aPosition1);
-					UG_LOG(aaPos[e->vertex(0)] << " and " << aaPos[e->vertex(1)] << endl);
-				}
-			}
-		#endif // UG_DEBUG
-*/
-
-		assert(refinement_is_allowed(e->vertex(0))
-				&& refinement_is_allowed(e->vertex(1)));
-
-		//GMGR_PROFILE(GMGR_Refine_CreatingEdgeVertices);
-	//	create two new edges by edge-split
-		RegularVertex* nVrt = *mg.create<RegularVertex>(e);
-
-	//	allow refCallback to calculate a new position
-		if(m_projector.valid())
-			m_projector->new_vertex(nVrt, e);
-		//GMGR_PROFILE_END();
-
-	//	split the edge
-		//GMGR_PROFILE(GMGR_Refine_CreatingEdges);
-		Vertex* substituteVrts[2];
-		substituteVrts[0] = mg.get_child_vertex(e->vertex(0));
-		substituteVrts[1] = mg.get_child_vertex(e->vertex(1));
-
-		e->refine(vEdges, nVrt, substituteVrts);
-		assert((vEdges.size() == 2) && "RegularEdge refine produced wrong number of edges.");
-		mg.register_element(vEdges[0], e);
-		mg.register_element(vEdges[1], e);
-		//GMGR_PROFILE_END();
+		RefineAndRegister<EdgeChildBuilder>(mg, vEdges, m_projector, "edge");
+		GMGR_PROFILE_END();
 	}
 
-
 	UG_DLOG(LIB_GRID, 1, "  creating new faces\n");
-
-//	create new vertices and faces from marked faces
-	for(FaceIterator iter = mg.begin<Face>(oldTopLevel);
-		iter != mg.end<Face>(oldTopLevel); ++iter)
 	{
-		if(!refinement_is_allowed(*iter))
-			continue;
-			
-		Face* f = *iter;
-	//	collect child-vertices
-		vVrts.clear();
-		for(uint j = 0; j < f->num_vertices(); ++j)
-			vVrts.push_back(mg.get_child_vertex(f->vertex(j)));
-
-	//	collect the associated edges
-		vEdgeVrts.clear();
-		//bool bIrregular = false;
-		for(uint j = 0; j < f->num_edges(); ++j)
-			vEdgeVrts.push_back(mg.get_child_vertex(mg.get_edge(f, j)));
-
-		//GMGR_PROFILE(GMGR_Refine_CreatingFaces);
-		Vertex* newVrt;
-		if(f->refine(vFaces, &newVrt, &vEdgeVrts.front(), NULL, &vVrts.front())){
-		//	if a new vertex was generated, we have to register it
-			if(newVrt){
-				//GMGR_PROFILE(GMGR_Refine_CreatingVertices);
-				mg.register_element(newVrt, f);
-			//	allow refCallback to calculate a new position
-				if(m_projector.valid())
-					m_projector->new_vertex(newVrt, f);
-				//GMGR_PROFILE_END();
-			}
-
-		//	register the new faces and assign status
-			for(size_t j = 0; j < vFaces.size(); ++j)
-				mg.register_element(vFaces[j], f);
-		}
-		else{
-			LOG("  WARNING in Refine: could not refine face.\n");
-		}
-		//GMGR_PROFILE_END();
+		GMGR_PROFILE(GMGR_RefineFaces);
+		vector<Face*> vFaces;
+		collect_refinable_elements(vFaces, oldTopLevel);
+		RefineAndRegister<FaceChildBuilder>(mg, vFaces, m_projector, "face");
+		GMGR_PROFILE_END();
 	}
 
-
 	UG_DLOG(LIB_GRID, 1, "  creating new volumes\n");
-
-//	only used for tetrahedron or octahedron refinement
-	vector<vector3> corners(6, vector3(0, 0, 0));
-
-//	create new vertices and volumes from marked volumes
-	for(VolumeIterator iter = mg.begin<Volume>(oldTopLevel);
-		iter != mg.end<Volume>(oldTopLevel); ++iter)
 	{
-		if(!refinement_is_allowed(*iter))
-			continue;
-
-		Volume* v = *iter;
-		//GMGR_PROFILE(GMGR_Refining_Volume);
-
-	//	collect child-vertices
-		//GMGR_PROFILE(GMGR_CollectingVolumeVertices);
-		vVrts.clear();
-		for(uint j = 0; j < v->num_vertices(); ++j)
-			vVrts.push_back(mg.get_child_vertex(v->vertex(j)));
-		//GMGR_PROFILE_END();
-
-	//	collect the associated edges
-		vEdgeVrts.clear();
-		//GMGR_PROFILE(GMGR_CollectingVolumeEdgeVertices);
-		//bool bIrregular = false;
-		for(uint j = 0; j < v->num_edges(); ++j)
-			vEdgeVrts.push_back(mg.get_child_vertex(mg.get_edge(v, j)));
-		//GMGR_PROFILE_END();
-
-	//	collect associated face-vertices
-		vFaceVrts.clear();
-		//GMGR_PROFILE(GMGR_CollectingVolumeFaceVertices);
-		for(uint j = 0; j < v->num_faces(); ++j)
-			vFaceVrts.push_back(mg.get_child_vertex(mg.get_face(v, j)));
-		//GMGR_PROFILE_END();
-
-	//	if we're performing tetrahedral or octahedral refinement, we have to collect
-	//	the corner coordinates, so that the refinement algorithm may choose
-	//	the best interior diagonal.
-		vector3* pCorners = NULL;
-		if((v->num_vertices() == 4) && m_projector.valid()){
-			for(size_t i = 0; i < 4; ++i){
-				corners[i] = m_projector->geometry()->pos(v->vertex(i));
-			}
-			pCorners = &corners.front();
-		}
-		if((v->reference_object_id() == ROID_OCTAHEDRON) && m_projector.valid()){
-			for(size_t i = 0; i < 6; ++i){
-				corners[i] = m_projector->geometry()->pos(v->vertex(i));
-			}
-			pCorners = &corners.front();
-		}
-
-		Vertex* newVrt;
-		if(v->refine(vVols, &newVrt, &vEdgeVrts.front(), &vFaceVrts.front(),
-					NULL, RegularVertex(), &vVrts.front(), pCorners)){
-		//	if a new vertex was generated, we have to register it
-			if(newVrt){
-				mg.register_element(newVrt, v);
-			//	allow refCallback to calculate a new position
-				if(m_projector.valid())
-					m_projector->new_vertex(newVrt, v);
-			}
-
-		//	register the new faces and assign status
-			for(size_t j = 0; j < vVols.size(); ++j)
-				mg.register_element(vVols[j], v);
-		}
-		else{
-			LOG("  WARNING in Refine: could not refine volume.\n");
-		}
-		//GMGR_PROFILE_END();
+		GMGR_PROFILE(GMGR_RefineVolumes);
+		vector<Volume*> vVols;
+		collect_refinable_elements(vVols, oldTopLevel);
+		RefineAndRegister<VolumeChildBuilder>(mg, vVols, m_projector, "volume");
+		GMGR_PROFILE_END();
 	}
 
 //	done - clean up
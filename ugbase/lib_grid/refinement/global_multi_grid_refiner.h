@@ -78,6 +78,10 @@ class GlobalMultiGridRefiner : public IRefiner, public GridObserver
 		template <class TElem>
 		void num_marked_elems(std::vector<int>& numMarkedElemsOut);
 
+	///	collects the elements of the given level whose refinement is allowed
+		template <class TElem>
+		void collect_refinable_elements(std::vector<TElem*>& vElemsOut, int lvl);
+
 	////////////////////////////////
 	///	performs refinement on the marked elements.
 		virtual void perform_refinement();
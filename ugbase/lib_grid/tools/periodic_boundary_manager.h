@@ -36,8 +36,10 @@
 #include "lib_grid/grid/grid.h"
 #include "lib_grid/multi_grid.h"
 #include "lib_grid/grid/grid_base_objects.h"
+#include "common/math/ugmath.h"
 
 #include <set>
+#include <vector>
 
 namespace ug {
 
@@ -71,6 +73,10 @@ public:
 	typedef typename TPosAA::ValueType AttachmentType;
 	ParallelShiftIdentifier(TPosAA& aa) : m_aaPos(aa) {}
 	void set_shift(AttachmentType& shift) {m_shift = shift; VecScale(m_shift_opposite, m_shift, -1);}
+
+	/// maps a position of the second subset onto the first subset
+	AttachmentType transform(const AttachmentType& p) const
+	{AttachmentType res; VecAdd(res, p, m_shift); return res;}
 protected:
 	AttachmentType m_shift;
 	AttachmentType m_shift_opposite;
@@ -79,18 +85,38 @@ protected:
 };
 
 
-//template<class TPosAA, int dim> class TransformationBasedIdentifier : public IIdentifier {
-//public:
-//	TransformationBasedIdentifier(TPosAA& aa) : m_aaPos(aa) {}
-//	void setTransformation(MathMatrix<dim,dim>& T) {this->T = T;}
-//
-//	virtual bool match(Vertex*, Vertex*);
-//	virtual bool match(Edge*, Edge*);
-//	virtual bool match(Face*, Face*);
-//protected:
-//	MathMatrix<dim,dim> T;
-//	TPosAA& m_aaPos;
-//};
+/// This class matches geometric elements which are related by an affine map.
+/**
+ * An element e2 of the second subset matches an element e1 of the first subset,
+ * if the center of e2, mapped by x -> T*x + t, coincides with the center of e1.
+ * This allows e.g. rotational periodicity.
+ * \tparam <TPosAA>{position attachment accessor used on the Domain}
+ * \tparam <dim>{world dimension of the positions}
+ */
+template<class TPosAA, int dim> class TransformationBasedIdentifier : public IIdentifier {
+public:
+	typedef typename TPosAA::ValueType AttachmentType;
+
+	TransformationBasedIdentifier(TPosAA& aa) : m_aaPos(aa) {MatIdentity(m_T); m_t = 0;}
+	virtual ~TransformationBasedIdentifier() {}
+
+	void set_transformation(const MathMatrix<dim,dim>& T, const AttachmentType& t)
+	{m_T = T; m_t = t;}
+
+	virtual bool match(Vertex* v1, Vertex* v2) {return match_impl(v1, v2);}
+	virtual bool match(Edge* e1, Edge* e2) {return match_impl(e1, e2);}
+	virtual bool match(Face* f1, Face* f2) {return match_impl(f1, f2);}
+
+	/// maps a position of the second subset onto the first subset
+	AttachmentType transform(const AttachmentType& p) const
+	{AttachmentType res; MatVecMult(res, m_T, p); res += m_t; return res;}
+
+protected:
+	MathMatrix<dim,dim> m_T;
+	AttachmentType m_t;
+	TPosAA& m_aaPos;
+	template<class TElem> bool match_impl(TElem*, TElem*) const;
+};
 
 ///
 /**
@@ -358,6 +384,36 @@ void IdentifySubsets(TDomain& dom, int sInd1, int sInd2);
 template <class TDomain>
 void IdentifySubsets(TDomain& dom, const char* sName1, const char* sName2);
 
+/**
+ * \brief identifies subset 1 with subset 2 using the given identifier.
+ *
+ * Elements are matched through a spatial hash of the element centers of
+ * subset 1, into which the mapped centers (see TIdentifier::transform) of the
+ * elements of subset 2 are looked up. The identification thus has linear
+ * complexity on each level.
+ *
+ * \param dom Domain the periodic boundary should be defined on
+ * \param sInd1 subset index of the first subset
+ * \param sInd2 subset index of the second subset
+ * \param ident identifier which maps positions of subset 2 onto subset 1
+ * 			(e.g. ParallelShiftIdentifier or TransformationBasedIdentifier)
+ */
+template <class TDomain, class TIdentifier>
+void IdentifySubsets(TDomain& dom, int sInd1, int sInd2, TIdentifier& ident);
+
+/**
+ * \brief identifies subset 1 with subset 2, where subset 2 is mapped onto
+ * subset 1 by the affine map x -> T*x + t.
+ *
+ * \param dom Domain the periodic boundary should be defined on
+ * \param sName1 name of the first subset
+ * \param sName2 name of the second subset
+ * \param vTrafo the dim x (dim+1) entries of the row-major matrix [T | t]
+ */
+template <class TDomain>
+void IdentifySubsets(TDomain& dom, const char* sName1, const char* sName2,
+					 const std::vector<number>& vTrafo);
+
 } // end of namespace ug
 
 // include implementation
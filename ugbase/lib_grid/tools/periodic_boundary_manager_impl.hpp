@@ -39,12 +39,14 @@
 #include "lib_grid/grid_objects/grid_dim_traits.h"
 #include "common/assert.h"
 #include "common/error.h"
+#include "common/util/hash.h"
 #include "pcl/pcl_base.h"
 
 #include <boost/mpl/map.hpp>
 #include <boost/mpl/at.hpp>
 
 #include <algorithm>
+#include <cmath>
 
 namespace ug {
 
@@ -74,6 +76,18 @@ bool ParallelShiftIdentifier<TAAPos>::match_impl(TElem* e1, TElem* e2) const {
 	return result;
 }
 
+template <class TAAPos, int dim>
+template <class TElem>
+bool TransformationBasedIdentifier<TAAPos, dim>::match_impl(TElem* e1, TElem* e2) const {
+	if (e1 == e2)
+		return false;
+
+	AttachmentType c1 = CalculateCenter(e1, m_aaPos),
+			c2 = transform(CalculateCenter(e2, m_aaPos));
+
+	return VecDistanceSq(c1, c2) < 10E-8;
+}
+
 template <class TElem>
 void PeriodicBoundaryManager::identify(TElem* e1, TElem* e2,
 		IIdentifier& ident) {
@@ -599,9 +613,182 @@ void IdentifySubsets(TDomain& dom, const char* sName1, const char* sName2) {
 	IdentifySubsets(dom, si1, si2);
 }
 
+template <class TDomain>
+void IdentifySubsets(TDomain& dom, const char* sName1, const char* sName2,
+					 const std::vector<number>& vTrafo)
+{
+	static const int dim = TDomain::dim;
+	typedef typename TDomain::position_accessor_type position_accessor_type;
+
+	if(vTrafo.size() != (size_t)(dim * (dim + 1)))
+		UG_THROW("IdentifySubsets: the affine transformation has to consist of "
+				 << dim * (dim + 1) << " entries (row-major [T | t]), but "
+				 << vTrafo.size() << " were given.");
+
+	typename TDomain::subset_handler_type& sh = *dom.subset_handler();
+	int si1 = sh.get_subset_index(sName1);
+	int si2 = sh.get_subset_index(sName2);
+
+	if (si1 == -1)
+		UG_THROW("IdentifySubsets: given subset name " << sName1 << " does not exist");
+	if (si2 == -1)
+		UG_THROW("IdentifySubsets: given subset name " << sName2 << " does not exist");
+
+	MathMatrix<dim, dim> T;
+	MathVector<dim> t;
+	for(int i = 0; i < dim; ++i){
+		for(int j = 0; j < dim; ++j)
+			T(i, j) = vTrafo[i * (dim + 1) + j];
+		t[i] = vTrafo[i * (dim + 1) + dim];
+	}
+
+	TransformationBasedIdentifier<position_accessor_type, dim>
+		ident(dom.position_accessor());
+	ident.set_transformation(T, t);
+
+	IdentifySubsets(dom, si1, si2, ident);
+}
+
+/// identifies the elements of two ranges, using a spatial hash of element centers
+/**
+ * The centers of the elements in [begin1, end1) are sorted into the cells of a
+ * uniform grid, which is stored in a hash. For each element of [begin2, end2)
+ * the mapped center (see TIdentifier::transform) is only compared to the
+ * elements in the surrounding cells. The complexity is thus linear in the
+ * number of elements instead of quadratic.
+ */
+template <class TElem, class TIterator, class TAAPos, class TIdentifier>
+void IdentifyElementsHashed(PeriodicBoundaryManager& pbm, TIterator begin1,
+							TIterator end1, TIterator begin2, TIterator end2,
+							TAAPos& aaPos, TIdentifier& ident)
+{
+	typedef typename TAAPos::ValueType	vector_t;
+	static const int dim = vector_t::Size;
+
+//	the identifiers consider two centers equal, if their squared distance is
+//	below 10E-8. Candidates are searched in a slightly larger box.
+	const number tol = 2. * std::sqrt(10E-8);
+
+//	the cell width is chosen as the mean element diameter, so that each cell
+//	contains only a few elements.
+	size_t num = 0;
+	number cellWidth = 0;
+	for(TIterator iter = begin1; iter != end1; ++iter, ++num){
+		TElem* e = *iter;
+		cellWidth += 2. * VecDistance(CalculateCenter(e, aaPos),
+									  aaPos[GetVertex(e, 0)]);
+	}
+
+	if(num == 0)
+		return;
+
+	cellWidth = std::max<number>(cellWidth / (number)num, 2. * tol);
+
+//	the elements of each cell are chained through vNext. The hash maps a cell
+//	to the index of its first element.
+	const size_t invalid = -1;
+	std::vector<TElem*> vElems;
+	std::vector<size_t> vNext;
+	vElems.reserve(num);
+	vNext.reserve(num);
+	Hash<size_t, size_t> cellHash(num);
+	cellHash.reserve(num);
+
+	for(TIterator iter = begin1; iter != end1; ++iter){
+		vector_t c = CalculateCenter(*iter, aaPos);
+		size_t key = 0;
+		for(int i = 0; i < dim; ++i){
+			long cell = (long)std::floor(c[i] / cellWidth);
+			key = key * 73856093 ^ (size_t)cell;
+		}
+
+		size_t first = invalid;
+		cellHash.get_entry(first, key);
+		vNext.push_back(first);
+		vElems.push_back(*iter);
+		if(first == invalid)
+			cellHash.insert(key, vElems.size() - 1);
+		else
+			cellHash.get_entry(key) = vElems.size() - 1;
+	}
+
+//	a center close to a cell boundary may lie in up to 2^dim cells
+	for(TIterator iter = begin2; iter != end2; ++iter){
+		TElem* e2 = *iter;
+		vector_t c = ident.transform(CalculateCenter(e2, aaPos));
+
+		long cellMin[dim], cellMax[dim];
+		for(int i = 0; i < dim; ++i){
+			cellMin[i] = (long)std::floor((c[i] - tol) / cellWidth);
+			cellMax[i] = (long)std::floor((c[i] + tol) / cellWidth);
+		}
+
+		long cell[dim];
+		for(int i = 0; i < dim; ++i)
+			cell[i] = cellMin[i];
+
+		bool done = false;
+		while(!done){
+			size_t key = 0;
+			for(int i = 0; i < dim; ++i)
+				key = key * 73856093 ^ (size_t)cell[i];
+
+			size_t ind = invalid;
+			cellHash.get_entry(ind, key);
+			for(; ind != invalid; ind = vNext[ind]){
+				TElem* e1 = vElems[ind];
+				if(ident.match(e1, e2))
+					pbm.identify(e1, e2, ident);
+			}
+
+		//	advance to the next cell
+			done = true;
+			for(int i = 0; i < dim; ++i){
+				if(cell[i] < cellMax[i]){
+					++cell[i];
+					done = false;
+					break;
+				}
+				cell[i] = cellMin[i];
+			}
+		}
+	}
+}
+
 /// performs geometric ident of periodic elements and master slave
 template <class TDomain>
 void IdentifySubsets(TDomain& dom, int sInd1, int sInd2) {
+	typedef typename TDomain::position_type position_type;
+	typedef typename TDomain::position_accessor_type position_accessor_type;
+	typedef typename grid_dim_traits<TDomain::dim>::side_type	TElem;
+
+	if (sInd1 == -1 || sInd2 == -1) {
+		UG_THROW("IdentifySubsets: at least one invalid subset given!")
+	}
+
+	// create parallel shift identifier to match subset elements
+	ParallelShiftIdentifier<position_accessor_type> ident(dom.position_accessor());
+
+	// calculate shift vector between subsets on the top level
+	typename TDomain::subset_handler_type& sh = *dom.subset_handler();
+	GridObjectCollection goc1 = sh.get_grid_objects_in_subset(sInd1);
+	GridObjectCollection goc2 = sh.get_grid_objects_in_subset(sInd2);
+
+	position_type c1 = CalculateCenter(goc1.begin<TElem>(0), goc1.end<TElem>(0),
+			dom.position_accessor());
+	position_type c2 = CalculateCenter(goc2.begin<TElem>(0), goc2.end<TElem>(0),
+			dom.position_accessor());
+
+	position_type shift;
+	VecSubtract(shift, c1, c2);
+	ident.set_shift(shift);
+
+	IdentifySubsets(dom, sInd1, sInd2, ident);
+}
+
+/// performs geometric ident of periodic elements and master slave
+template <class TDomain, class TIdentifier>
+void IdentifySubsets(TDomain& dom, int sInd1, int sInd2, TIdentifier& ident) {
 
 #ifdef UG_PARALLEL
 	//if(pcl::NumProcs() > 1)
@@ -623,7 +810,6 @@ void IdentifySubsets(TDomain& dom, int sInd1, int sInd2) {
 
 	PeriodicBoundaryManager& pbm = *dom.grid()->periodic_boundary_manager();
 
-	typedef typename TDomain::position_type position_type;
 	typedef typename TDomain::position_accessor_type position_accessor_type;
 
 	// get subset handler from domain
@@ -634,12 +820,6 @@ void IdentifySubsets(TDomain& dom, int sInd1, int sInd2) {
 	// get aaPos from domain
 	position_accessor_type& aaPos = dom.position_accessor();
 
-	// create parallel shift identifier to match subset elements
-	ParallelShiftIdentifier<position_accessor_type> ident(aaPos);
-
-	// shift vector between subsets
-	position_type shift;
-
 	// collect all geometric objects (even for all levels in case of multi grid)
 	GridObjectCollection goc1 = sh.get_grid_objects_in_subset(sInd1);
 	GridObjectCollection goc2 = sh.get_grid_objects_in_subset(sInd2);
@@ -671,30 +851,15 @@ void IdentifySubsets(TDomain& dom, int sInd1, int sInd2) {
 
 	// typedef typename mpl::at<m, TDomain>::type TElem;
 	typedef typename grid_dim_traits<TDomain::dim>::side_type	TElem;
-	typedef typename ElementStorage<TElem>::SectionContainer::iterator gocIter;
-
-	// calculate shift vector for top level
-	position_type c1 = CalculateCenter(goc1.begin<TElem>(0), goc1.end<TElem>(0),
-			aaPos);
-	position_type c2 = CalculateCenter(goc2.begin<TElem>(0), goc2.end<TElem>(0),
-			aaPos);
-
-	VecSubtract(shift, c1, c2);
-	ident.set_shift(shift);
 
 	// for each level of multi grid. In case of simple grid only one iteration
 	for (size_t lvl = 0; lvl < goc1.num_levels(); lvl++) {
 		// identify corresponding elements for second subset. A element is considered
-		// to have symmetric element in second subset if there exists a shift vector between them.
-		// todo use kd-tree for fast lookup of shifted elements
-		for (gocIter iter1 = goc1.begin<TElem>(lvl);
-				iter1 != goc1.end<TElem>(lvl); ++iter1)
-			for (gocIter iter2 = goc2.begin<TElem>(lvl);
-					iter2 != goc2.end<TElem>(lvl); ++iter2) {
-				if(ident.match(*iter1, *iter2)) {
-					pbm.identify(*iter1, *iter2, ident);
-				}
-			}
+		// to have symmetric element in second subset if its mapped center
+		// coincides with the center of an element of the first subset.
+		IdentifyElementsHashed<TElem>(pbm, goc1.begin<TElem>(lvl), goc1.end<TElem>(lvl),
+									  goc2.begin<TElem>(lvl), goc2.end<TElem>(lvl),
+									  aaPos, ident);
 	}
 
 	// ensure periodic identification has been performed correctly
@@ -30,9 +30,12 @@
  * GNU Lesser General Public License for more details.
  */
 
+#include "parallel_file.h"
 #include "pcl_process_communicator.h"
 #include "common/util/binary_buffer.h"
 #include "common/log.h"
+#include "common/util/async_output.h"
+#include <cstdio>
 #include <map>
 #include <string>
 #include <mpi.h>
@@ -136,4 +139,146 @@ void ReadCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename,
 	//	UG_LOG("File read.\n");
 }
 
+size_t ParallelFileOffset(size_t localSize, pcl::ProcessCommunicator pc)
+{
+	MPI_Comm comm = pc.get_mpi_communicator();
+	long long mySize = localSize;
+	long long myEnd = 0;
+	MPI_Scan(&mySize, &myEnd, 1, MPI_LONG_LONG, MPI_SUM, comm);
+	return (size_t)(myEnd - mySize);
+}
+
+void WriteSectionedParallelFile(std::string strFilename,
+                                const std::vector<std::string>& vGlue,
+                                const std::vector<std::pair<const char*, size_t> >& vSection,
+                                pcl::ProcessCommunicator pc)
+{
+	UG_COND_THROW(vGlue.size() != vSection.size() + 1,
+	              "WriteSectionedParallelFile: Need "<<vSection.size()+1
+	              <<" glue parts for "<<vSection.size()<<" sections.");
+
+	MPI_Status status;
+	MPI_Comm comm = pc.get_mpi_communicator();
+	MPI_File fh;
+	const bool bFirst = pc.get_proc_id(0) == pcl::ProcRank();
+	const size_t numSec = vSection.size();
+
+//	positions of glue parts and own part of each section
+	std::vector<size_t> vGlueSize(numSec+1), vSectionSize(numSec);
+	for(size_t i = 0; i <= numSec; ++i)
+		vGlueSize[i] = vGlue[i].size();
+	for(size_t i = 0; i < numSec; ++i)
+		vSectionSize[i] = vSection[i].second;
+
+	std::vector<size_t> vGlueOffset, vSectionOffset;
+	SectionedParallelFileLayout(vGlueSize, vSectionSize, vGlueOffset, vSectionOffset, pc);
+
+	char filename[1024];
+	strcpy(filename, strFilename.c_str());
+
+	if(MPI_File_open(comm, filename, MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh))
+		UG_THROW("could not open "<<filename);
+	MPI_File_set_size(fh, 0);
+
+	for(size_t i = 0; i <= numSec; ++i)
+	{
+		if(bFirst && !vGlue[i].empty())
+			MPI_File_write_at(fh, vGlueOffset[i], const_cast<char*>(vGlue[i].data()),
+			                  (int)vGlue[i].size(), MPI_BYTE, &status);
+
+		if(i == numSec) break;
+
+	//	write own part of the section (collective)
+		MPI_File_write_at_all(fh, vSectionOffset[i], const_cast<char*>(vSection[i].first),
+		                      (int)vSection[i].second, MPI_BYTE, &status);
+	}
+
+	MPI_File_close(&fh);
+}
+
+void SectionedParallelFileLayout(const std::vector<size_t>& vGlueSize,
+                                 const std::vector<size_t>& vSectionSize,
+                                 std::vector<size_t>& vGlueOffsetOut,
+                                 std::vector<size_t>& vSectionOffsetOut,
+                                 pcl::ProcessCommunicator pc)
+{
+	UG_COND_THROW(vGlueSize.size() != vSectionSize.size() + 1,
+	              "SectionedParallelFileLayout: Need "<<vSectionSize.size()+1
+	              <<" glue parts for "<<vSectionSize.size()<<" sections.");
+
+	MPI_Comm comm = pc.get_mpi_communicator();
+	const size_t numSec = vSectionSize.size();
+
+//	own offset and total size of each section
+	std::vector<long long> vSize(numSec), vEnd(numSec), vTotal(numSec);
+	for(size_t i = 0; i < numSec; ++i)
+		vSize[i] = vSectionSize[i];
+	if(numSec > 0)
+	{
+		MPI_Scan(&vSize[0], &vEnd[0], (int)numSec, MPI_LONG_LONG, MPI_SUM, comm);
+		MPI_Allreduce(&vSize[0], &vTotal[0], (int)numSec, MPI_LONG_LONG, MPI_SUM, comm);
+	}
+
+	vGlueOffsetOut.resize(numSec+1);
+	vSectionOffsetOut.resize(numSec);
+	size_t secStart = 0;
+	for(size_t i = 0; i <= numSec; ++i)
+	{
+		vGlueOffsetOut[i] = secStart;
+		secStart += vGlueSize[i];
+
+		if(i == numSec) break;
+
+		vSectionOffsetOut[i] = secStart + (size_t)(vEnd[i] - vSize[i]);
+		secStart += (size_t)vTotal[i];
+	}
+}
+
+void CreateEmptyParallelFile(std::string strFilename, pcl::ProcessCommunicator pc)
+{
+//	pending jobs of the output threads may still write to this file. Jobs
+//	writing other files are not waited for.
+	ug::WaitForAsyncOutput(strFilename);
+	pc.barrier();
+
+	if(pc.get_proc_id(0) == pcl::ProcRank())
+	{
+		FILE* f = fopen(strFilename.c_str(), "wb");
+		if(f == NULL)
+			UG_THROW("could not open "<<strFilename);
+		fclose(f);
+	}
+	pc.barrier();
+}
+
+size_t PrepareCombinedParallelFile(std::string strFilename, size_t localSize,
+                                   std::vector<char>& headerOut,
+                                   pcl::ProcessCommunicator pc)
+{
+	MPI_Comm comm = pc.get_mpi_communicator();
+	const bool bFirst = pc.get_proc_id(0) == pcl::ProcRank();
+
+	CreateEmptyParallelFile(strFilename, pc);
+
+	long long mySize = localSize;
+	long long myNextOffset = 0;
+	MPI_Scan(&mySize, &myNextOffset, 1, MPI_LONG_LONG, MPI_SUM, comm);
+	myNextOffset += (pc.size())*sizeof(long long) + sizeof(int);
+
+	std::vector<long long> allNextOffsets(pc.size(), 0);
+	MPI_Allgather(&myNextOffset, 1, MPI_LONG_LONG, &allNextOffsets[0], 1, MPI_LONG_LONG, comm);
+
+	headerOut.clear();
+	if(bFirst)
+	{
+		int numProcs = pcl::NumProcs();
+		const char* p = reinterpret_cast<const char*>(&numProcs);
+		headerOut.insert(headerOut.end(), p, p + sizeof(numProcs));
+		p = reinterpret_cast<const char*>(&allNextOffsets[0]);
+		headerOut.insert(headerOut.end(), p, p + allNextOffsets.size()*sizeof(long long));
+	}
+
+	return (size_t)(myNextOffset - mySize);
+}
+
 }
@@ -35,6 +35,9 @@
 
 #include "pcl_process_communicator.h"
 #include "common/util/binary_buffer.h"
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace pcl{
 
@@ -89,5 +92,96 @@ void WriteCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename
  */
 void ReadCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename, pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
 
+
+/**
+ * This function returns the sum of the given sizes over all processes with a
+ * lower rank (exclusive prefix sum), i.e. the offset of the data of this
+ * process if the data of all processes is stored consecutively by rank.
+ *
+ * @param localSize		size of the data of this process
+ * @param pc			a processes communicator (default pcl::World)
+ */
+size_t ParallelFileOffset(size_t localSize, pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
+
+
+/**
+ * This function writes one file from all participating cores, consisting of
+ * sections that contain the data of all processes in the order of their rank.
+ * In contrast to WriteCombinedParallelFile, no offset table is written, so
+ * that the file can have an arbitrary (e.g. standard) format.
+ *
+ * The file is composed as follows:
+ *
+ * vGlue[0]
+ * vSection[0] of proc 0, vSection[0] of proc 1, ...
+ * vGlue[1]
+ * vSection[1] of proc 0, vSection[1] of proc 1, ...
+ * ...
+ * vGlue[n]
+ *
+ * The glue parts must be the same on all processes and are written by the
+ * first process. The offsets are computed by prefix sums over the sizes, and
+ * each section is written by a collective MPI-IO call.
+ *
+ * @param strFilename	the filename
+ * @param vGlue			glue parts (n+1 for n sections)
+ * @param vSection		data of this process in each section
+ * @param pc			a processes communicator (default pcl::World)
+ */
+void WriteSectionedParallelFile(std::string strFilename,
+                                const std::vector<std::string>& vGlue,
+                                const std::vector<std::pair<const char*, size_t> >& vSection,
+                                pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
+
+
+/**
+ * This function computes the file positions used by WriteSectionedParallelFile
+ * without writing the file, e.g. to write the file later without MPI.
+ *
+ * @param vGlueSize			sizes of the glue parts (n+1 for n sections)
+ * @param vSectionSize		sizes of the data of this process in each section
+ * @param vGlueOffsetOut	file positions of the glue parts
+ * @param vSectionOffsetOut	file positions of the data of this process
+ * @param pc				a processes communicator (default pcl::World)
+ */
+void SectionedParallelFileLayout(const std::vector<size_t>& vGlueSize,
+                                 const std::vector<size_t>& vSectionSize,
+                                 std::vector<size_t>& vGlueOffsetOut,
+                                 std::vector<size_t>& vSectionOffsetOut,
+                                 pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
+
+
+/**
+ * Creates an empty file (on the first process) that is then written by all
+ * processes with ordinary file operations. Before the file is truncated, all
+ * processes wait for their pending asynchronous output to this file (see
+ * WaitForAsyncOutput), since it may still write to a file of the same name. After the call
+ * returns, the empty file exists on all processes.
+ *
+ * @param strFilename	the filename
+ * @param pc			a processes communicator (default pcl::World)
+ */
+void CreateEmptyParallelFile(std::string strFilename,
+                             pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
+
+
+/**
+ * This function prepares writing a file in the format of
+ * WriteCombinedParallelFile without using MPI-IO: The (empty) file is created
+ * by CreateEmptyParallelFile and the header and the position of the data of this
+ * process are computed. After the call returns, the file exists on all
+ * processes, so that each process can write its data (and the first process
+ * the header) with ordinary file operations, e.g. from a separate thread.
+ *
+ * @param strFilename	the filename
+ * @param localSize		size of the data of this process
+ * @param headerOut		the header (only on the first process, empty otherwise)
+ * @param pc			a processes communicator (default pcl::World)
+ * @return				file position of the data of this process
+ */
+size_t PrepareCombinedParallelFile(std::string strFilename, size_t localSize,
+                                   std::vector<char>& headerOut,
+                                   pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
+
 }
 #endif /* PARALLEL_ARCHIVE_H_ */
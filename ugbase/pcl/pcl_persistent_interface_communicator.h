@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__PCL__PCL_PERSISTENT_INTERFACE_COMMUNICATOR__
+#define __H__PCL__PCL_PERSISTENT_INTERFACE_COMMUNICATOR__
+
+#include <vector>
+#include "mpi.h"
+#include "pcl_communication_structs.h"
+
+namespace pcl
+{
+
+/// \addtogroup pcl
+/// \{
+
+////////////////////////////////////////////////////////////////////////
+//	PersistentInterfaceCommunicator
+///	Repeatedly exchanges fixed-size values between a pair of fixed layouts.
+/**	In contrast to the InterfaceCommunicator, the communication pattern is set
+ * up once during init(): interface elements are flattened into index lists,
+ * send- and receive-buffers are allocated with their final sizes and persistent
+ * requests are created through MPI_Send_init and MPI_Recv_init.
+ * Each communication then only consists of gathering the values into the
+ * send-buffer, MPI_Startall, MPI_Waitall and scattering the received values.
+ * No buffer sizes are exchanged and no communication policies or streams
+ * are involved.
+ *
+ * This is especially useful for frequently repeated exchanges on layouts
+ * which don't change, e.g. for consistency updates of parallel vectors.
+ *
+ * The data passed to communicate_and_resume and to the extract methods has
+ * to feature a typedef value_type and an operator[] which takes elements of
+ * the layout. value_type has to be of fixed size (sizeof(value_type) is
+ * communicated) and has to equal the value-size specified in init.
+ *
+ * Only single-level layouts are supported.
+ *
+ * \note	Copies of a PersistentInterfaceCommunicator are not initialized,
+ *			since persistent requests refer to the buffers of their instance.
+ */
+template <class TLayout>
+class PersistentInterfaceCommunicator
+{
+	public:
+		typedef TLayout 					Layout;
+		typedef typename Layout::Interface	Interface;
+		typedef typename Layout::Element	Element;
+
+	public:
+		PersistentInterfaceCommunicator();
+		PersistentInterfaceCommunicator(const PersistentInterfaceCommunicator& pic);
+		~PersistentInterfaceCommunicator();
+
+		PersistentInterfaceCommunicator& operator=(const PersistentInterfaceCommunicator& pic);
+
+	///	sets up the communication pattern.
+	/**	Values of elements in sendLayout will be sent to the associated
+	 * processes, which have to call init with a matching recvLayout.
+	 * Not a collective operation.
+	 * \param valueSize	size in bytes of a single value.
+	 * \param tag		the tag for all messages of this communicator. Make sure
+	 *					not to use the same tag for concurrent communications.*/
+		void init(const Layout& sendLayout, const Layout& recvLayout,
+				  size_t valueSize, int tag = 749346);
+
+	///	frees all requests and buffers.
+		void clear();
+
+	///	returns true if init was called.
+		bool initialized() const		{return m_valueSize > 0;}
+
+	///	returns true if the communicator was initialized for the given layouts.
+	/**	Only checks the involved processes and the interface sizes and thus
+	 * only takes O(#interfaces).*/
+		bool matches(const Layout& sendLayout, const Layout& recvLayout,
+					 size_t valueSize) const;
+
+	///	gathers values into the send-buffer and starts the communication.
+	/**	A call to communicate_and_resume has to be followed by a call to wait.*/
+		template <class TData>
+		void communicate_and_resume(const TData& data);
+
+	///	waits until all sends and receives of the current communication are done
+		void wait();
+
+	///	returns true if a communication was started but not waited for.
+		bool pending() const			{return m_pending;}
+
+	///	copies received values to data.
+	/**	Calls wait() if the communication is still pending.*/
+		template <class TData>
+		void extract_copy(TData& data);
+
+	///	adds received values to data.
+	/**	Calls wait() if the communication is still pending.*/
+		template <class TData>
+		void extract_add(TData& data);
+
+	protected:
+	///	data for the messages to/from one process
+		struct ProcEntry{
+			ProcEntry(int p, size_t f, size_t n) : proc(p), first(f), num(n)	{}
+			int		proc;
+			size_t	first;	///< first entry in the element list
+			size_t	num;	///< number of elements
+		};
+
+		void flatten_layout(std::vector<ProcEntry>& procsOut,
+							std::vector<Element>& elemsOut,
+							const Layout& layout);
+
+		bool layout_matches(const std::vector<ProcEntry>& procs,
+							const Layout& layout) const;
+
+	protected:
+		std::vector<ProcEntry>		m_sendProcs;
+		std::vector<ProcEntry>		m_recvProcs;
+		std::vector<Element>		m_sendElems;
+		std::vector<Element>		m_recvElems;
+		std::vector<char>			m_sendBuf;
+		std::vector<char>			m_recvBuf;
+	///	receive requests followed by send requests
+		std::vector<MPI_Request>	m_requests;
+		size_t						m_valueSize;
+		bool						m_pending;
+};
+
+// end group pcl
+/// \}
+
+}//	end of namespace pcl
+
+////////////////////////////////////////
+//	include implementation
+#include "pcl_persistent_interface_communicator_impl.hpp"
+
+#endif
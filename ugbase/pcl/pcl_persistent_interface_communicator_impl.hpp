@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2020:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__PCL__PCL_PERSISTENT_INTERFACE_COMMUNICATOR_IMPL__
+#define __H__PCL__PCL_PERSISTENT_INTERFACE_COMMUNICATOR_IMPL__
+
+#include "pcl_persistent_interface_communicator.h"
+#include "pcl_comm_world.h"
+#include "pcl_profiling.h"
+#include "common/assert.h"
+#include "common/error.h"
+
+namespace pcl
+{
+
+template <class TLayout>
+PersistentInterfaceCommunicator<TLayout>::
+PersistentInterfaceCommunicator() :
+	m_valueSize(0),
+	m_pending(false)
+{
+}
+
+template <class TLayout>
+PersistentInterfaceCommunicator<TLayout>::
+PersistentInterfaceCommunicator(const PersistentInterfaceCommunicator&) :
+	m_valueSize(0),
+	m_pending(false)
+{
+}
+
+template <class TLayout>
+PersistentInterfaceCommunicator<TLayout>::
+~PersistentInterfaceCommunicator()
+{
+	clear();
+}
+
+template <class TLayout>
+PersistentInterfaceCommunicator<TLayout>&
+PersistentInterfaceCommunicator<TLayout>::
+operator=(const PersistentInterfaceCommunicator&)
+{
+	clear();
+	return *this;
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+void PersistentInterfaceCommunicator<TLayout>::
+init(const Layout& sendLayout, const Layout& recvLayout,
+	 size_t valueSize, int tag)
+{
+	PCL_PROFILE(pcl_PersistentIntCom_init);
+
+	UG_COND_THROW(valueSize == 0,
+				  "PersistentInterfaceCommunicator::init: valueSize has to be positive.");
+
+	clear();
+
+	flatten_layout(m_sendProcs, m_sendElems, sendLayout);
+	flatten_layout(m_recvProcs, m_recvElems, recvLayout);
+
+	m_valueSize = valueSize;
+	m_sendBuf.resize(m_sendElems.size() * valueSize);
+	m_recvBuf.resize(m_recvElems.size() * valueSize);
+
+	m_requests.resize(m_recvProcs.size() + m_sendProcs.size());
+	size_t iReq = 0;
+	for(size_t i = 0; i < m_recvProcs.size(); ++i, ++iReq){
+		const ProcEntry& pe = m_recvProcs[i];
+		MPI_Recv_init(&m_recvBuf[pe.first * valueSize], (int)(pe.num * valueSize),
+					  MPI_UNSIGNED_CHAR, pe.proc, tag, PCL_COMM_WORLD,
+					  &m_requests[iReq]);
+	}
+
+	for(size_t i = 0; i < m_sendProcs.size(); ++i, ++iReq){
+		const ProcEntry& pe = m_sendProcs[i];
+		MPI_Send_init(&m_sendBuf[pe.first * valueSize], (int)(pe.num * valueSize),
+					  MPI_UNSIGNED_CHAR, pe.proc, tag, PCL_COMM_WORLD,
+					  &m_requests[iReq]);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+void PersistentInterfaceCommunicator<TLayout>::
+clear()
+{
+	if(m_pending)
+		wait();
+
+//	requests may outlive MPI, e.g. if they are owned by global objects
+	int finalized = 0;
+	MPI_Finalized(&finalized);
+	if(!finalized){
+		for(size_t i = 0; i < m_requests.size(); ++i){
+			if(m_requests[i] != MPI_REQUEST_NULL)
+				MPI_Request_free(&m_requests[i]);
+		}
+	}
+
+	m_requests.clear();
+	m_sendProcs.clear();
+	m_recvProcs.clear();
+	m_sendElems.clear();
+	m_recvElems.clear();
+	m_sendBuf.clear();
+	m_recvBuf.clear();
+	m_valueSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+bool PersistentInterfaceCommunicator<TLayout>::
+matches(const Layout& sendLayout, const Layout& recvLayout, size_t valueSize) const
+{
+	return initialized()
+		   && (valueSize == m_valueSize)
+		   && layout_matches(m_sendProcs, sendLayout)
+		   && layout_matches(m_recvProcs, recvLayout);
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+template <class TData>
+void PersistentInterfaceCommunicator<TLayout>::
+communicate_and_resume(const TData& data)
+{
+	PCL_PROFILE(pcl_PersistentIntCom_communicate);
+	typedef typename TData::value_type	value_t;
+
+	UG_COND_THROW(!initialized(),
+				  "PersistentInterfaceCommunicator: init has to be called "
+				  "before communication.");
+	UG_COND_THROW(m_pending,
+				  "PersistentInterfaceCommunicator: Can't communicate since a "
+				  "previous communication is still pending!");
+	UG_ASSERT(sizeof(value_t) == m_valueSize,
+			  "value size does not match the size specified in init.");
+
+	if(!m_sendElems.empty()){
+		value_t* buf = reinterpret_cast<value_t*>(&m_sendBuf.front());
+		for(size_t i = 0; i < m_sendElems.size(); ++i)
+			buf[i] = data[m_sendElems[i]];
+	}
+
+	if(!m_requests.empty())
+		MPI_Startall((int)m_requests.size(), &m_requests.front());
+	m_pending = true;
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+void PersistentInterfaceCommunicator<TLayout>::
+wait()
+{
+	PCL_PROFILE(pcl_PersistentIntCom_wait);
+	if(!m_pending)
+		return;
+
+	if(!m_requests.empty())
+		::MPI_Waitall((int)m_requests.size(), &m_requests.front(), MPI_STATUSES_IGNORE);
+	m_pending = false;
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+template <class TData>
+void PersistentInterfaceCommunicator<TLayout>::
+extract_copy(TData& data)
+{
+	typedef typename TData::value_type	value_t;
+	wait();
+
+	if(m_recvElems.empty())
+		return;
+
+	const value_t* buf = reinterpret_cast<const value_t*>(&m_recvBuf.front());
+	for(size_t i = 0; i < m_recvElems.size(); ++i)
+		data[m_recvElems[i]] = buf[i];
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+template <class TData>
+void PersistentInterfaceCommunicator<TLayout>::
+extract_add(TData& data)
+{
+	typedef typename TData::value_type	value_t;
+	wait();
+
+	if(m_recvElems.empty())
+		return;
+
+	const value_t* buf = reinterpret_cast<const value_t*>(&m_recvBuf.front());
+	for(size_t i = 0; i < m_recvElems.size(); ++i)
+		data[m_recvElems[i]] += buf[i];
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+void PersistentInterfaceCommunicator<TLayout>::
+flatten_layout(std::vector<ProcEntry>& procsOut, std::vector<Element>& elemsOut,
+			   const Layout& layout)
+{
+	procsOut.clear();
+	elemsOut.clear();
+	elemsOut.reserve(layout.num_interface_elements());
+
+	for(typename Layout::const_iterator li = layout.begin();
+		li != layout.end(); ++li)
+	{
+		const Interface& intfc = layout.interface(li);
+		if(intfc.empty())
+			continue;
+
+		procsOut.push_back(ProcEntry(layout.proc_id(li), elemsOut.size(), intfc.size()));
+		for(typename Interface::const_iterator iter = intfc.begin();
+			iter != intfc.end(); ++iter)
+		{
+			elemsOut.push_back(intfc.get_element(iter));
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+bool PersistentInterfaceCommunicator<TLayout>::
+layout_matches(const std::vector<ProcEntry>& procs, const Layout& layout) const
+{
+	size_t i = 0;
+	for(typename Layout::const_iterator li = layout.begin();
+		li != layout.end(); ++li)
+	{
+		const Interface& intfc = layout.interface(li);
+		if(intfc.empty())
+			continue;
+
+		if((i >= procs.size())
+		   || (procs[i].proc != layout.proc_id(li))
+		   || (procs[i].num != intfc.size()))
+		{
+			return false;
+		}
+		++i;
+	}
+	return i == procs.size();
+}
+
+}//	end of namespace pcl
+
+#endif
@@ -288,6 +288,16 @@ class ProcessCommunicator
 		void allreduce(const void* sendBuf, void* recBuf, int count,
 					   DataType type, ReduceOperation op) const;
 
+	///	starts MPI_Iallreduce on the processes of the communicator.
+	/**	The reduction runs in the background. Its result is only valid after
+	 * pcl::MPI_Wait(request) returned, and sendBuf and recBuf must not be
+	 * touched before. All processes of the communicator have to call this method.
+	 * If MPI does not support non-blocking collectives (MPI_VERSION < 3),
+	 * a blocking MPI_Allreduce is performed and request is set to MPI_REQUEST_NULL.*/
+		void iallreduce(const void* sendBuf, void* recBuf, int count,
+						DataType type, ReduceOperation op,
+						MPI_Request* request) const;
+
 	/** simplified allreduce for size=1. calls allreduce for parameter t,
 	 * and then returns the result.
 	 * \param t the input parameter
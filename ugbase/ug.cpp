@@ -37,6 +37,7 @@
 #include "common/log.h"
 #include "common/util/path_provider.h"
 #include "common/util/os_info.h"
+#include "common/util/async_output.h"
 #include "common/profiler/profiler.h"
 #include "common/profiler/profile_node.h"
 
@@ -198,6 +199,14 @@ int UGInit(int *argcp, char ***argvp, int parallelOutputProcRank)
 
 int UGFinalizeNoPCLFinalize()
 {
+//	finish pending output files
+	try{
+		SetAsyncOutput(false);
+	}
+	catch(UGError& err){
+		UG_LOG("ERROR in UGFinalize: " << err.get_msg() << "\n");
+	}
+
 	EnableMemTracker(false);
 	ug::GetLogAssistant().flush_error_log();
 	